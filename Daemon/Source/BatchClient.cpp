@@ -0,0 +1,189 @@
+/*
+  ==============================================================================
+
+    BatchClient.cpp
+    Created: 26 Oct 2026 2:51:14pm
+    Author:  Linus
+
+  ==============================================================================
+*/
+
+#include "BatchClient.h"
+
+#if JUCE_LINUX
+
+#include <atomic>
+#include <cstring>
+#include <poll.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+#include <vector>
+#include "SharedAudioRegion.h"
+
+namespace
+{
+    // Polls yielded before waiting for the daemon starts to sleep
+    constexpr int spinPolls = 1000;
+
+    BatchProtocol::JobResult failed(BatchProtocol::Status status)
+    {
+        BatchProtocol::JobResult result;
+        result.status = status;
+        return result;
+    }
+
+    // Unique within the machine: the process and a counter
+    juce::String makeRegionName()
+    {
+        static std::atomic<int> counter{ 0 };
+        return "/compressord-" + juce::String(static_cast<int>(getpid())) + "-" + juce::String(++counter);
+    }
+}
+
+BatchClient::BatchClient(const juce::String& path)
+    : socketPath(path)
+{
+}
+
+int BatchClient::connect() const
+{
+    sockaddr_un address{};
+    address.sun_family = AF_UNIX;
+    if (socketPath.getNumBytesAsUTF8() >= sizeof(address.sun_path))
+        return -1;
+    std::strcpy(address.sun_path, socketPath.toRawUTF8());
+
+    const int connection = socket(AF_UNIX, SOCK_STREAM | SOCK_CLOEXEC, 0);
+    if (connection >= 0 && ::connect(connection, reinterpret_cast<const sockaddr*>(&address), sizeof(address)) != 0)
+    {
+        close(connection);
+        return -1;
+    }
+    return connection;
+}
+
+BatchProtocol::JobResult BatchClient::process(juce::AudioBuffer<float>& buffer, double sampleRate,
+                                              const BatchProtocol::Settings& settings, int ringFrames)
+{
+    using namespace BatchProtocol;
+
+    const int numChannels = buffer.getNumChannels();
+    const int numFrames = buffer.getNumSamples();
+
+    JobRequest request;
+    const auto name = makeRegionName();
+    name.copyToUTF8(request.sharedMemoryName, sizeof(request.sharedMemoryName));
+    request.sampleRate = sampleRate;
+    request.numChannels = numChannels;
+    request.numFrames = numFrames;
+    request.settings = settings;
+
+    // The region only has to outlive this call, the daemon maps it while the job runs
+    const auto region = SharedAudioRegion::create(name, numChannels, juce::jmax(ringFrames, blockFrames));
+    if (region == nullptr)
+        return failed(Status::badSharedMemory);
+
+    const int connection = connect();
+    if (connection < 0)
+        return failed(Status::badRequest);
+
+    if (send(connection, &request, sizeof(request), MSG_NOSIGNAL) != static_cast<ssize_t>(sizeof(request)))
+    {
+        close(connection);
+        return failed(Status::badRequest);
+    }
+
+    // Interleaves into the input ring and back out of the output ring a block at a time
+    std::vector<float> frames(static_cast<size_t>(blockFrames * numChannels));
+    int written = 0, read = 0, idlePolls = 0;
+
+    while (read < numFrames)
+    {
+        bool progress = false;
+
+        if (written < numFrames)
+        {
+            const int num = juce::jmin(blockFrames, numFrames - written);
+            for (int i = 0; i < num; ++i)
+                for (int ch = 0; ch < numChannels; ++ch)
+                    frames[static_cast<size_t>(i * numChannels + ch)] = buffer.getSample(ch, written + i);
+
+            const int numWritten = region->writeInput(frames.data(), num);
+            written += numWritten;
+            progress = numWritten > 0;
+        }
+
+        const int numRead = region->readOutput(frames.data(), juce::jmin(blockFrames, numFrames - read));
+        for (int i = 0; i < numRead; ++i)
+            for (int ch = 0; ch < numChannels; ++ch)
+                buffer.setSample(ch, read + i, frames[static_cast<size_t>(i * numChannels + ch)]);
+        read += numRead;
+
+        if (progress || numRead > 0)
+        {
+            idlePolls = 0;
+        }
+        else if (++idlePolls < spinPolls)
+        {
+            juce::Thread::yield();
+        }
+        else
+        {
+            // The daemon gives up on the job itself, the result says so
+            pollfd descriptor{ connection, POLLIN, 0 };
+            if (poll(&descriptor, 1, 1) > 0)
+                break;
+        }
+    }
+
+    // The frames flushed out of the lookahead follow the input's, the daemon has
+    // written all of them once the result is on its way
+    std::vector<float> tail;
+    for (bool resultSent = false; ! resultSent;)
+    {
+        pollfd descriptor{ connection, POLLIN, 0 };
+        resultSent = poll(&descriptor, 1, 1) != 0;
+
+        for (int numRead; (numRead = region->readOutput(frames.data(), blockFrames)) > 0;)
+            tail.insert(tail.end(), frames.begin(), frames.begin() + numRead * numChannels);
+    }
+
+    JobResult result = failed(Status::timedOut);
+    auto* bytes = reinterpret_cast<char*>(&result);
+    size_t remaining = sizeof(result);
+    while (remaining > 0)
+    {
+        const auto received = recv(connection, bytes, remaining, 0);
+        if (received <= 0)
+        {
+            result = failed(Status::timedOut);
+            break;
+        }
+
+        bytes += received;
+        remaining -= static_cast<size_t>(received);
+    }
+
+    close(connection);
+
+    // Takes the delay out: frame n of the buffer becomes output frame n + latency,
+    // the last ones coming from the tail
+    const int latency = result.status == Status::ok ? juce::jmin(result.latencyFrames, static_cast<int>(tail.size()) / numChannels) : 0;
+    if (latency > 0)
+    {
+        for (int ch = 0; ch < numChannels; ++ch)
+        {
+            for (int i = 0; i < numFrames; ++i)
+            {
+                const int source = i + latency;
+                buffer.setSample(ch, i, source < numFrames ? buffer.getSample(ch, source)
+                                                           : tail[static_cast<size_t>((source - numFrames) * numChannels + ch)]);
+            }
+        }
+    }
+
+    return result;
+}
+
+#endif
@@ -0,0 +1,37 @@
+/*
+  ==============================================================================
+
+    BatchClient.h
+    Created: 26 Oct 2026 2:20:58pm
+    Author:  Linus
+
+  ==============================================================================
+*/
+
+#pragma once
+#include <JuceHeader.h>
+#include "BatchProtocol.h"
+
+// Runs jobs on a compressord on the same machine. Each call creates the job's
+// shared memory region, streams the audio through it while the daemon processes,
+// and waits for the daemon's result. Meant for pipeline workers that would
+// otherwise start a process per file.
+class BatchClient
+{
+public:
+    explicit BatchClient(const juce::String& socketPath);
+
+    // Compresses the planar buffer in place, aligned with the input: the daemon's
+    // latencyFrames of delay are taken out. The result's status is not ok if the
+    // daemon couldn't be reached or refused the job, the buffer is then unchanged
+    // or partly processed.
+    BatchProtocol::JobResult process(juce::AudioBuffer<float>&, double sampleRate, const BatchProtocol::Settings&,
+                                     int ringFrames = BatchProtocol::defaultRingFrames);
+
+private:
+    int connect() const;
+
+    juce::String socketPath;
+
+    JUCE_DECLARE_NON_COPYABLE(BatchClient)
+};
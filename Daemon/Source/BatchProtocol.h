@@ -0,0 +1,110 @@
+/*
+  ==============================================================================
+
+    BatchProtocol.h
+    Created: 26 Oct 2026 9:04:17am
+    Author:  Linus
+
+    What compressord and its clients exchange. Control messages go over a Unix
+    domain socket, one request and one result per connection; the audio goes
+    through a shared memory region the client creates for the job, holding an
+    input and an output ring of interleaved float frames. Both sides are on the
+    same machine and built from this header, so the structs are sent as they are.
+
+  ==============================================================================
+*/
+
+#pragma once
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+
+namespace BatchProtocol
+{
+    constexpr std::uint32_t magic = 0x43424a42;     // "CBJB"
+    constexpr std::uint32_t version = 1;
+
+    constexpr int maxChannels = 8;
+    constexpr int maxNameLength = 64;
+
+    // Frames the daemon processes at a time, the rings hold a few of these
+    constexpr int blockFrames = 1024;
+    constexpr int defaultRingFrames = 16 * blockFrames;
+
+    // Main compressor settings of a job, in the units of the plugin's parameters
+    struct Settings
+    {
+        float inputGain{ 0.0f };
+        float threshold{ -10.0f };
+        float ratio{ 2.0f };
+        float knee{ 6.0f };
+        float attack{ 2.0f };
+        float release{ 140.0f };
+        float makeup{ 0.0f };
+        float mix{ 1.0f };
+        float ceiling{ 0.0f };
+        std::uint8_t midSide{ 0 };
+        std::uint8_t truePeak{ 0 };
+    };
+
+    struct JobRequest
+    {
+        std::uint32_t magic{ BatchProtocol::magic };
+        std::uint32_t version{ BatchProtocol::version };
+        char sharedMemoryName[maxNameLength]{};     // as given to shm_open
+        double sampleRate{ 0.0 };
+        std::int32_t numChannels{ 0 };
+        std::int64_t numFrames{ 0 };
+        Settings settings;
+    };
+
+    enum class Status : std::int32_t
+    {
+        ok = 0,
+        badRequest = -1,            // wrong magic or version, or settings out of range
+        badSharedMemory = -2,       // the region can't be mapped or doesn't match the request
+        timedOut = -3               // the client stopped feeding or draining the rings
+    };
+
+    struct JobResult
+    {
+        Status status{ Status::ok };
+        std::int64_t numFrames{ 0 };
+        std::int32_t latencyFrames{ 0 };    // the true peak lookahead: the output ring is delayed by this
+                                            // much and carries as many frames more than the input
+        double queueSeconds{ 0.0 };         // from the request until a warm instance was free
+        double processSeconds{ 0.0 };       // spent in the compressor
+        double wallSeconds{ 0.0 };          // from the request until the last frame was written
+    };
+
+    // Single producer, single consumer ring. Positions count frames since the start
+    // of the job and only grow; a frame lives at position % capacity.
+    struct RingHeader
+    {
+        std::atomic<std::uint64_t> written{ 0 };
+        std::atomic<std::uint64_t> read{ 0 };
+    };
+
+    // Start of the shared memory region, followed by the input ring's frames and
+    // then the output ring's, capacityFrames * numChannels floats each
+    struct RegionHeader
+    {
+        std::uint32_t magic{ BatchProtocol::magic };
+        std::uint32_t version{ BatchProtocol::version };
+        std::int32_t numChannels{ 0 };
+        std::int32_t capacityFrames{ 0 };
+        RingHeader input;
+        RingHeader output;
+    };
+
+    // The atomics are shared between processes, which needs them free of locks
+    static_assert(std::atomic<std::uint64_t>::is_always_lock_free, "ring positions must be lock free");
+
+    // Rounded up so the frames start 64-byte aligned
+    constexpr std::size_t headerSize = (sizeof(RegionHeader) + 63) / 64 * 64;
+
+    inline std::size_t getRegionSize(int numChannels, int capacityFrames)
+    {
+        return headerSize + 2 * sizeof(float) * static_cast<std::size_t>(numChannels) * static_cast<std::size_t>(capacityFrames);
+    }
+}
@@ -0,0 +1,381 @@
+/*
+  ==============================================================================
+
+    BatchServer.cpp
+    Created: 26 Oct 2026 11:47:09am
+    Author:  Linus
+
+  ==============================================================================
+*/
+
+#include "BatchServer.h"
+
+#if JUCE_LINUX
+
+#include <algorithm>
+#include <cstring>
+#include <poll.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+#include "SharedAudioRegion.h"
+#include "../../Source/GlobalParameters.h"
+
+namespace
+{
+    // A client that neither feeds nor drains its rings for this long has gone
+    constexpr double clientTimeoutSeconds = 10.0;
+
+    // Polls yielded before waiting for a client starts to sleep
+    constexpr int spinPolls = 1000;
+
+    double secondsSince(juce::int64 ticks)
+    {
+        return juce::Time::highResolutionTicksToSeconds(juce::Time::getHighResolutionTicks() - ticks);
+    }
+
+    bool receiveAll(int connection, void* data, size_t size)
+    {
+        auto* bytes = static_cast<char*>(data);
+        while (size > 0)
+        {
+            const auto received = recv(connection, bytes, size, 0);
+            if (received <= 0)
+                return false;
+
+            bytes += received;
+            size -= static_cast<size_t>(received);
+        }
+        return true;
+    }
+
+    bool sendAll(int connection, const void* data, size_t size)
+    {
+        const auto* bytes = static_cast<const char*>(data);
+        while (size > 0)
+        {
+            // A client that went away must not take the daemon down with SIGPIPE
+            const auto sent = send(connection, bytes, size, MSG_NOSIGNAL);
+            if (sent <= 0)
+                return false;
+
+            bytes += sent;
+            size -= static_cast<size_t>(sent);
+        }
+        return true;
+    }
+
+    bool hasHungUp(int connection)
+    {
+        pollfd descriptor{ connection, POLLIN, 0 };
+        if (poll(&descriptor, 1, 0) <= 0)
+            return false;
+
+        // Nothing is ever sent after the request, so anything readable is the end
+        char byte;
+        return (descriptor.revents & (POLLHUP | POLLERR)) != 0 || recv(connection, &byte, 1, MSG_DONTWAIT) <= 0;
+    }
+
+    bool isValid(const BatchProtocol::JobRequest& request)
+    {
+        using namespace GlobalParameters::Parameter;
+
+        // The same ranges libcompressor accepts, outside them the detector and gain computer diverge
+        const auto& settings = request.settings;
+        if (! (inputBounds.contains(settings.inputGain) && thresholdBounds.contains(settings.threshold)
+               && ratioBounds.contains(settings.ratio) && kneeBounds.contains(settings.knee)
+               && attackBounds.contains(settings.attack) && releaseBounds.contains(settings.release)
+               && makeupBounds.contains(settings.makeup) && mixBounds.contains(settings.mix)
+               && ceilingBounds.contains(settings.ceiling)))
+            return false;
+
+        return request.magic == BatchProtocol::magic && request.version == BatchProtocol::version
+            && request.sampleRate > 0.0 && request.numFrames >= 0
+            && request.numChannels >= 1 && request.numChannels <= BatchProtocol::maxChannels
+            && (settings.midSide == 0 || request.numChannels == 2)
+            && std::memchr(request.sharedMemoryName, 0, sizeof(request.sharedMemoryName)) != nullptr;
+    }
+
+    void applySettings(Compressor& compressor, const BatchProtocol::Settings& settings)
+    {
+        compressor.setInput(settings.inputGain);
+        compressor.setThreshold(settings.threshold);
+        compressor.setRatio(settings.ratio);
+        compressor.setKnee(settings.knee);
+        compressor.setAttack(settings.attack);
+        compressor.setRelease(settings.release);
+        compressor.setMakeup(settings.makeup);
+        compressor.setMix(settings.mix);
+        compressor.setMidSide(settings.midSide != 0);
+        compressor.setTruePeak(settings.truePeak != 0);
+        compressor.setCeiling(settings.ceiling);
+    }
+}
+
+BatchServer::BatchServer(int numInstances)
+    : juce::Thread("compressord listener")
+{
+    // Every instance is built and its scratch reserved up front, a job only prepares
+    numInstances = juce::jmax(1, numInstances);
+    for (int i = 0; i < numInstances; ++i)
+    {
+        instances.push_back(std::make_unique<Compressor>());
+        instances.back()->prepare({ 48000.0, static_cast<juce::uint32>(BatchProtocol::blockFrames),
+                                    static_cast<juce::uint32>(BatchProtocol::maxChannels) });
+        freeInstances.push_back(instances.back().get());
+    }
+}
+
+BatchServer::~BatchServer()
+{
+    stop();
+}
+
+bool BatchServer::start(const juce::String& socketPath)
+{
+    stop();
+
+    sockaddr_un address{};
+    address.sun_family = AF_UNIX;
+    if (socketPath.getNumBytesAsUTF8() >= sizeof(address.sun_path))
+        return false;
+    std::strcpy(address.sun_path, socketPath.toRawUTF8());
+
+    listener = socket(AF_UNIX, SOCK_STREAM | SOCK_CLOEXEC, 0);
+    if (listener < 0)
+        return false;
+
+    // A previous daemon that didn't shut down cleanly leaves its socket file behind
+    unlink(address.sun_path);
+
+    if (bind(listener, reinterpret_cast<const sockaddr*>(&address), sizeof(address)) != 0 || listen(listener, 64) != 0)
+    {
+        close(listener);
+        listener = -1;
+        return false;
+    }
+
+    path = socketPath;
+    stopping = false;
+    jobPool = std::make_unique<juce::ThreadPool>(static_cast<int>(instances.size()));
+    startThread();
+    return true;
+}
+
+void BatchServer::stop()
+{
+    if (listener < 0)
+        return;
+
+    stopping = true;
+    stopThread(2000);
+
+    // Waits for the running jobs, which give up on their clients now. Jobs still
+    // queued may be dropped without running, their connections are closed here.
+    jobPool = nullptr;
+
+    {
+        const juce::ScopedLock sl(connectionLock);
+        for (const int connection : openConnections)
+            close(connection);
+        openConnections.clear();
+    }
+
+    close(listener);
+    listener = -1;
+    unlink(path.toRawUTF8());
+}
+
+int BatchServer::getNumInstances() const
+{
+    return static_cast<int>(instances.size());
+}
+
+int BatchServer::getNumJobs() const
+{
+    const juce::ScopedLock sl(statsLock);
+    return numJobs;
+}
+
+double BatchServer::getRealtimeFactor() const
+{
+    const juce::ScopedLock sl(statsLock);
+    return totalWallSeconds > 0.0 ? totalAudioSeconds / totalWallSeconds : 0.0;
+}
+
+#if COMPRESSOR_PROFILING
+bool BatchServer::writeProfile(const juce::File& file) const
+{
+    ProcessProfiler total;
+    for (const auto& instance : instances)
+        total.merge(instance->getProfiler());
+    return total.writeCsv(file);
+}
+#endif
+
+void BatchServer::run()
+{
+    while (! threadShouldExit())
+    {
+        pollfd descriptor{ listener, POLLIN, 0 };
+        if (poll(&descriptor, 1, 100) <= 0)
+            continue;
+
+        const int connection = accept4(listener, nullptr, nullptr, SOCK_CLOEXEC);
+        if (connection < 0)
+            continue;
+
+        const auto acceptTicks = juce::Time::getHighResolutionTicks();
+        {
+            const juce::ScopedLock sl(connectionLock);
+            openConnections.push_back(connection);
+        }
+        jobPool->addJob([this, connection, acceptTicks] { handleConnection(connection, acceptTicks); });
+    }
+}
+
+void BatchServer::handleConnection(int connection, juce::int64 acceptTicks)
+{
+    // A client that connects and never sends a request doesn't hold a pool thread for long
+    timeval timeout{ 5, 0 };
+    setsockopt(connection, SOL_SOCKET, SO_RCVTIMEO, &timeout, sizeof(timeout));
+
+    BatchProtocol::JobRequest request;
+    if (receiveAll(connection, &request, sizeof(request)))
+    {
+        const auto result = runJob(connection, request, acceptTicks);
+        sendAll(connection, &result, sizeof(result));
+
+        if (result.status == BatchProtocol::Status::ok)
+        {
+            {
+                const juce::ScopedLock sl(statsLock);
+                ++numJobs;
+                totalAudioSeconds += static_cast<double>(result.numFrames) / request.sampleRate;
+                totalWallSeconds += result.wallSeconds;
+            }
+
+            if (onJobFinished)
+                onJobFinished({ result, request.sampleRate, request.numChannels });
+        }
+    }
+
+    {
+        const juce::ScopedLock sl(connectionLock);
+        openConnections.erase(std::find(openConnections.begin(), openConnections.end(), connection));
+    }
+    close(connection);
+}
+
+BatchProtocol::JobResult BatchServer::runJob(int connection, const BatchProtocol::JobRequest& request, juce::int64 acceptTicks)
+{
+    using namespace BatchProtocol;
+
+    JobResult result;
+    if (! isValid(request))
+    {
+        result.status = Status::badRequest;
+        return result;
+    }
+
+    const auto region = SharedAudioRegion::open(request.sharedMemoryName);
+    if (region == nullptr || region->getNumChannels() != request.numChannels)
+    {
+        result.status = Status::badSharedMemory;
+        return result;
+    }
+
+    auto& compressor = takeInstance();
+    result.queueSeconds = secondsSince(acceptTicks);
+
+    // A fresh detector and lookahead for every job, the settings are the request's
+    compressor.prepare({ request.sampleRate, static_cast<juce::uint32>(blockFrames), static_cast<juce::uint32>(request.numChannels) });
+    applySettings(compressor, request.settings);
+
+    auto& input = region->getInput();
+    auto& output = region->getOutput();
+    const int numChannels = request.numChannels;
+    const int capacity = region->getCapacityFrames();
+
+    // Frame n of the input becomes frame n of the output at the same ring offset, so
+    // every block is copied across once and processed in place in the output ring.
+    // Silence follows the input for the length of the lookahead, so the output ring
+    // gets the last frames too, latencyFrames after the input's.
+    std::uint64_t position = 0;
+    const auto numFrames = static_cast<std::uint64_t>(request.numFrames);
+    const auto numOutputFrames = numFrames + static_cast<std::uint64_t>(compressor.getLatencyInSamples());
+    auto lastProgress = juce::Time::getHighResolutionTicks();
+    int idlePolls = 0;
+
+    while (position < numOutputFrames)
+    {
+        const bool flushing = position >= numFrames;
+        const auto ready = flushing ? numOutputFrames - position : std::min(input.written.load(std::memory_order_acquire), numFrames) - position;
+        const auto free = static_cast<std::uint64_t>(capacity) - (position - output.read.load(std::memory_order_acquire));
+        const int num = static_cast<int>(std::min({ ready, free, static_cast<std::uint64_t>(blockFrames) }));
+        if (num <= 0)
+        {
+            if (++idlePolls < spinPolls)
+            {
+                juce::Thread::yield();
+                continue;
+            }
+
+            if (stopping || secondsSince(lastProgress) > clientTimeoutSeconds || hasHungUp(connection))
+            {
+                result.status = Status::timedOut;
+                break;
+            }
+
+            juce::Thread::sleep(1);
+            continue;
+        }
+
+        const auto processStart = juce::Time::getHighResolutionTicks();
+        for (int done = 0; done < num;)
+        {
+            const auto at = position + static_cast<std::uint64_t>(done);
+            const int contiguous = region->getContiguousFrames(at, num - done);
+            float* frames = region->getOutputFrames(at);
+            if (flushing)
+                std::fill(frames, frames + contiguous * numChannels, 0.0f);
+            else
+                std::memcpy(frames, region->getInputFrames(at), sizeof(float) * static_cast<size_t>(contiguous * numChannels));
+            compressor.processInterleaved(frames, numChannels, contiguous);
+            done += contiguous;
+        }
+        result.processSeconds += secondsSince(processStart);
+
+        position += static_cast<std::uint64_t>(num);
+        if (! flushing)
+            input.read.store(position, std::memory_order_release);
+        output.written.store(position, std::memory_order_release);
+
+        lastProgress = juce::Time::getHighResolutionTicks();
+        idlePolls = 0;
+    }
+
+    result.numFrames = static_cast<std::int64_t>(std::min(position, numFrames));
+    result.latencyFrames = compressor.getLatencyInSamples();
+    result.wallSeconds = secondsSince(acceptTicks);
+    returnInstance(compressor);
+    return result;
+}
+
+Compressor& BatchServer::takeInstance()
+{
+    // The pool has a thread per instance, so a running job always finds one
+    const juce::ScopedLock sl(instanceLock);
+    jassert(! freeInstances.empty());
+    auto* compressor = freeInstances.back();
+    freeInstances.pop_back();
+    return *compressor;
+}
+
+void BatchServer::returnInstance(Compressor& compressor)
+{
+    const juce::ScopedLock sl(instanceLock);
+    freeInstances.push_back(&compressor);
+}
+
+#endif
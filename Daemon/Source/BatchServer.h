@@ -0,0 +1,88 @@
+/*
+  ==============================================================================
+
+    BatchServer.h
+    Created: 26 Oct 2026 11:03:45am
+    Author:  Linus
+
+  ==============================================================================
+*/
+
+#pragma once
+#include <atomic>
+#include <functional>
+#include <memory>
+#include <vector>
+#include <JuceHeader.h>
+#include "../../Source/Compressor.h"
+#include "BatchProtocol.h"
+
+// The core of compressord: listens on a Unix domain socket and runs each job a
+// client sends on one of a fixed pool of Compressors that stay constructed and
+// reserved for the life of the daemon, so a job only pays for a prepare. One
+// connection is one job. Jobs run concurrently on a thread pool the size of the
+// instance pool; more connections than that queue until an instance is free.
+class BatchServer : private juce::Thread
+{
+public:
+    struct JobStats
+    {
+        BatchProtocol::JobResult result;
+        double sampleRate{ 0.0 };
+        int numChannels{ 0 };
+    };
+
+    explicit BatchServer(int numInstances);
+    ~BatchServer() override;
+
+    // Binds the socket, replacing a stale one at the path, and starts accepting.
+    // Returns false if the path can't be bound.
+    bool start(const juce::String& socketPath);
+    void stop();
+
+    // Called on a pool thread after every job, e.g. to log it
+    std::function<void(const JobStats&)> onJobFinished;
+
+    int getNumInstances() const;
+    int getNumJobs() const;
+
+    // Seconds of audio the daemon has processed per second of wall time of its jobs
+    double getRealtimeFactor() const;
+
+#if COMPRESSOR_PROFILING
+    // Stage timings of every instance's blocks together, as ProcessProfiler::toCsv.
+    // Returns false if the file can't be written.
+    bool writeProfile(const juce::File&) const;
+#endif
+
+private:
+    void run() override;
+
+    void handleConnection(int connection, juce::int64 acceptTicks);
+    BatchProtocol::JobResult runJob(int connection, const BatchProtocol::JobRequest&, juce::int64 acceptTicks);
+
+    Compressor& takeInstance();
+    void returnInstance(Compressor&);
+
+    std::vector<std::unique_ptr<Compressor>> instances;
+    std::vector<Compressor*> freeInstances;
+    juce::CriticalSection instanceLock;
+
+    std::unique_ptr<juce::ThreadPool> jobPool;
+
+    // Accepted connections not yet closed by their job, stop closes what's left
+    std::vector<int> openConnections;
+    juce::CriticalSection connectionLock;
+    int listener{ -1 };
+    juce::String path;
+
+    // Jobs waiting on a client give up when this is set
+    std::atomic<bool> stopping{ false };
+
+    int numJobs{ 0 };
+    double totalAudioSeconds{ 0.0 };
+    double totalWallSeconds{ 0.0 };
+    juce::CriticalSection statsLock;
+
+    JUCE_DECLARE_NON_COPYABLE(BatchServer)
+};
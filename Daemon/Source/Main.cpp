@@ -0,0 +1,102 @@
+/*
+  ==============================================================================
+
+    Main.cpp
+    Created: 26 Oct 2026 3:32:40pm
+    Author:  Linus
+
+    compressord --socket <path> [--pool <instances>] [--profile <csv>]
+
+    Runs the batch daemon until SIGINT or SIGTERM and logs every job. A build
+    with COMPRESSOR_PROFILING writes its stage timings to the --profile file.
+
+  ==============================================================================
+*/
+
+#include <JuceHeader.h>
+#include <csignal>
+#include <iostream>
+#include "BatchServer.h"
+
+#if JUCE_LINUX
+
+namespace
+{
+    volatile std::sig_atomic_t shouldQuit = 0;
+
+    void handleSignal(int)
+    {
+        shouldQuit = 1;
+    }
+}
+
+int main(int argc, char* argv[])
+{
+    juce::String socketPath, profilePath;
+    int poolSize = juce::SystemStats::getNumCpus();
+
+    for (int i = 1; i + 1 < argc; i += 2)
+    {
+        const juce::String option(argv[i]);
+        if (option == "--socket")
+            socketPath = argv[i + 1];
+        else if (option == "--pool")
+            poolSize = juce::String(argv[i + 1]).getIntValue();
+        else if (option == "--profile")
+            profilePath = argv[i + 1];
+    }
+
+    if (socketPath.isEmpty() || poolSize < 1)
+    {
+        std::cerr << "usage: compressord --socket <path> [--pool <instances>] [--profile <csv>]" << std::endl;
+        return 2;
+    }
+
+    BatchServer server(poolSize);
+    server.onJobFinished = [](const BatchServer::JobStats& stats)
+    {
+        const auto& result = stats.result;
+        const double audioSeconds = static_cast<double>(result.numFrames) / stats.sampleRate;
+        std::cout << juce::String::formatted("job: %lld frames x %d ch at %.0f Hz, queue %.3f ms, process %.3f ms, wall %.3f ms, %.1fx real time",
+                                             static_cast<long long>(result.numFrames), stats.numChannels, stats.sampleRate,
+                                             result.queueSeconds * 1000.0, result.processSeconds * 1000.0, result.wallSeconds * 1000.0,
+                                             result.wallSeconds > 0.0 ? audioSeconds / result.wallSeconds : 0.0)
+                  << std::endl;
+    };
+
+    if (! server.start(socketPath))
+    {
+        std::cerr << "compressord: can't listen on " << socketPath << std::endl;
+        return 1;
+    }
+
+    std::signal(SIGINT, handleSignal);
+    std::signal(SIGTERM, handleSignal);
+    std::cout << "compressord: " << server.getNumInstances() << " instances on " << socketPath << std::endl;
+
+    while (! shouldQuit)
+        juce::Thread::sleep(100);
+
+    server.stop();
+    std::cout << "compressord: " << server.getNumJobs() << " jobs, "
+              << juce::String(server.getRealtimeFactor(), 1) << "x real time overall" << std::endl;
+
+   #if COMPRESSOR_PROFILING
+    if (profilePath.isNotEmpty() && ! server.writeProfile(juce::File(profilePath)))
+        std::cerr << "compressord: can't write the profile to " << profilePath << std::endl;
+   #else
+    if (profilePath.isNotEmpty())
+        std::cerr << "compressord: built without COMPRESSOR_PROFILING, no profile written" << std::endl;
+   #endif
+    return 0;
+}
+
+#else
+
+int main()
+{
+    // Shared memory rings and the socket are only implemented for Linux so far
+    return 1;
+}
+
+#endif
@@ -0,0 +1,183 @@
+/*
+  ==============================================================================
+
+    SharedAudioRegion.cpp
+    Created: 26 Oct 2026 10:12:30am
+    Author:  Linus
+
+  ==============================================================================
+*/
+
+#include "SharedAudioRegion.h"
+
+#if JUCE_LINUX
+
+#include <cstring>
+#include <fcntl.h>
+#include <new>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+std::unique_ptr<SharedAudioRegion> SharedAudioRegion::create(const juce::String& name, int numChannels, int capacityFrames)
+{
+    if (numChannels < 1 || numChannels > BatchProtocol::maxChannels || capacityFrames < BatchProtocol::blockFrames)
+        return nullptr;
+
+    const int fd = shm_open(name.toRawUTF8(), O_RDWR | O_CREAT | O_EXCL, S_IRUSR | S_IWUSR);
+    if (fd < 0)
+        return nullptr;
+
+    const size_t size = BatchProtocol::getRegionSize(numChannels, capacityFrames);
+    void* memory = ftruncate(fd, static_cast<off_t>(size)) == 0
+                     ? mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0)
+                     : MAP_FAILED;
+    close(fd);
+
+    if (memory == MAP_FAILED)
+    {
+        shm_unlink(name.toRawUTF8());
+        return nullptr;
+    }
+
+    auto* header = new (memory) BatchProtocol::RegionHeader();
+    header->numChannels = numChannels;
+    header->capacityFrames = capacityFrames;
+
+    return std::unique_ptr<SharedAudioRegion>(new SharedAudioRegion(name, memory, size, numChannels, capacityFrames, true));
+}
+
+std::unique_ptr<SharedAudioRegion> SharedAudioRegion::open(const juce::String& name)
+{
+    const int fd = shm_open(name.toRawUTF8(), O_RDWR, 0);
+    if (fd < 0)
+        return nullptr;
+
+    struct stat info;
+    void* memory = MAP_FAILED;
+    size_t size = 0;
+    if (fstat(fd, &info) == 0 && static_cast<size_t>(info.st_size) >= BatchProtocol::headerSize)
+    {
+        size = static_cast<size_t>(info.st_size);
+        memory = mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    }
+    close(fd);
+
+    if (memory == MAP_FAILED)
+        return nullptr;
+
+    // The sizes come from another process, which can change them at any time: they
+    // are read once, and only the values that were checked are ever used
+    const auto* header = static_cast<const volatile BatchProtocol::RegionHeader*>(memory);
+    const int numChannels = header->numChannels;
+    const int capacityFrames = header->capacityFrames;
+
+    if (header->magic != BatchProtocol::magic || header->version != BatchProtocol::version
+        || numChannels < 1 || numChannels > BatchProtocol::maxChannels
+        || capacityFrames < BatchProtocol::blockFrames
+        || BatchProtocol::getRegionSize(numChannels, capacityFrames) > size)
+    {
+        munmap(memory, size);
+        return nullptr;
+    }
+
+    return std::unique_ptr<SharedAudioRegion>(new SharedAudioRegion(name, memory, size, numChannels, capacityFrames, false));
+}
+
+SharedAudioRegion::SharedAudioRegion(const juce::String& regionName, void* regionMemory, size_t regionSize,
+                                     int regionChannels, int regionCapacity, bool isOwner)
+    : name(regionName), memory(regionMemory), size(regionSize), owner(isOwner),
+      numChannels(regionChannels), capacityFrames(regionCapacity),
+      header(static_cast<BatchProtocol::RegionHeader*>(regionMemory))
+{
+    const size_t ringFloats = static_cast<size_t>(numChannels) * static_cast<size_t>(capacityFrames);
+    inputFrames = reinterpret_cast<float*>(static_cast<char*>(memory) + BatchProtocol::headerSize);
+    outputFrames = inputFrames + ringFloats;
+}
+
+SharedAudioRegion::~SharedAudioRegion()
+{
+    munmap(memory, size);
+
+    // The name goes, the memory stays for as long as the other side has it mapped
+    if (owner)
+        shm_unlink(name.toRawUTF8());
+}
+
+int SharedAudioRegion::getNumChannels() const
+{
+    return numChannels;
+}
+
+int SharedAudioRegion::getCapacityFrames() const
+{
+    return capacityFrames;
+}
+
+BatchProtocol::RingHeader& SharedAudioRegion::getInput()
+{
+    return header->input;
+}
+
+BatchProtocol::RingHeader& SharedAudioRegion::getOutput()
+{
+    return header->output;
+}
+
+float* SharedAudioRegion::getInputFrames(std::uint64_t position)
+{
+    return inputFrames + static_cast<size_t>(position % static_cast<std::uint64_t>(capacityFrames)) * static_cast<size_t>(numChannels);
+}
+
+float* SharedAudioRegion::getOutputFrames(std::uint64_t position)
+{
+    return outputFrames + static_cast<size_t>(position % static_cast<std::uint64_t>(capacityFrames)) * static_cast<size_t>(numChannels);
+}
+
+int SharedAudioRegion::getContiguousFrames(std::uint64_t position, int numFrames) const
+{
+    const int offset = static_cast<int>(position % static_cast<std::uint64_t>(capacityFrames));
+    return juce::jmin(numFrames, capacityFrames - offset);
+}
+
+int SharedAudioRegion::writeInput(const float* frames, int numFrames)
+{
+    auto& ring = header->input;
+    const auto written = ring.written.load(std::memory_order_relaxed);
+    const auto read = ring.read.load(std::memory_order_acquire);
+    const int numToWrite = juce::jmin(numFrames, capacityFrames - static_cast<int>(written - read));
+
+    for (int done = 0; done < numToWrite;)
+    {
+        const auto position = written + static_cast<std::uint64_t>(done);
+        const int num = getContiguousFrames(position, numToWrite - done);
+        std::memcpy(getInputFrames(position), frames + static_cast<size_t>(done) * static_cast<size_t>(numChannels),
+                    sizeof(float) * static_cast<size_t>(num) * static_cast<size_t>(numChannels));
+        done += num;
+    }
+
+    ring.written.store(written + static_cast<std::uint64_t>(numToWrite), std::memory_order_release);
+    return numToWrite;
+}
+
+int SharedAudioRegion::readOutput(float* frames, int numFrames)
+{
+    auto& ring = header->output;
+    const auto read = ring.read.load(std::memory_order_relaxed);
+    const auto written = ring.written.load(std::memory_order_acquire);
+    const int numToRead = juce::jmin(numFrames, static_cast<int>(written - read));
+
+    for (int done = 0; done < numToRead;)
+    {
+        const auto position = read + static_cast<std::uint64_t>(done);
+        const int num = getContiguousFrames(position, numToRead - done);
+        std::memcpy(frames + static_cast<size_t>(done) * static_cast<size_t>(numChannels), getOutputFrames(position),
+                    sizeof(float) * static_cast<size_t>(num) * static_cast<size_t>(numChannels));
+        done += num;
+    }
+
+    ring.read.store(read + static_cast<std::uint64_t>(numToRead), std::memory_order_release);
+    return numToRead;
+}
+
+#endif
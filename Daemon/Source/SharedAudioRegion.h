@@ -0,0 +1,66 @@
+/*
+  ==============================================================================
+
+    SharedAudioRegion.h
+    Created: 26 Oct 2026 9:41:52am
+    Author:  Linus
+
+  ==============================================================================
+*/
+
+#pragma once
+#include <cstdint>
+#include <memory>
+#include <JuceHeader.h>
+#include "BatchProtocol.h"
+
+// A job's POSIX shared memory region as laid out by BatchProtocol: the client
+// creates it and writes input frames, compressord maps it and writes the output
+// next to them. Neither ring ever goes through the socket.
+class SharedAudioRegion
+{
+public:
+    // Creates and maps a new region, removed again when the creator destroys it.
+    // nullptr if the name is taken or the memory can't be had.
+    static std::unique_ptr<SharedAudioRegion> create(const juce::String& name, int numChannels, int capacityFrames);
+
+    // Maps a region another process created, nullptr if it isn't a valid one
+    static std::unique_ptr<SharedAudioRegion> open(const juce::String& name);
+
+    ~SharedAudioRegion();
+
+    int getNumChannels() const;
+    int getCapacityFrames() const;
+
+    BatchProtocol::RingHeader& getInput();
+    BatchProtocol::RingHeader& getOutput();
+
+    // Frames at a position of the ring, contiguous for getContiguousFrames of them
+    float* getInputFrames(std::uint64_t position);
+    float* getOutputFrames(std::uint64_t position);
+    int getContiguousFrames(std::uint64_t position, int numFrames) const;
+
+    // Client side: copies as many interleaved frames as fit into the input ring,
+    // and as many as are ready out of the output ring. Both return the frames moved.
+    int writeInput(const float* frames, int numFrames);
+    int readOutput(float* frames, int numFrames);
+
+private:
+    SharedAudioRegion(const juce::String& name, void* memory, size_t size, int numChannels, int capacityFrames, bool owner);
+
+    juce::String name;
+    void* memory{ nullptr };
+    size_t size{ 0 };
+    bool owner{ false };
+
+    // Copies of the header's layout as it was checked; the other process can still
+    // write to the header, so the offsets never come from it
+    int numChannels{ 0 };
+    int capacityFrames{ 0 };
+
+    BatchProtocol::RegionHeader* header{ nullptr };
+    float* inputFrames{ nullptr };
+    float* outputFrames{ nullptr };
+
+    JUCE_DECLARE_NON_COPYABLE(SharedAudioRegion)
+};
@@ -0,0 +1,182 @@
+/*
+  ==============================================================================
+
+    libcompressor.cpp
+    Created: 23 Oct 2026 10:21:36am
+    Author:  Linus
+
+  ==============================================================================
+*/
+
+#include "libcompressor.h"
+#include <cmath>
+#include <memory>
+#include "../../Source/Compressor.h"
+#include "../../Source/GlobalParameters.h"
+
+namespace
+{
+    // Interleaved processing with mid/side or the ceiling deinterleaves in the scratch arena
+    constexpr int maxChannels = 8;
+}
+
+struct compressor_handle
+{
+    Compressor compressor;
+    int numChannels{ 0 };
+    int maxBlockSize{ 0 };
+};
+
+int compressor_get_api_version(void)
+{
+    return LIBCOMPRESSOR_API_VERSION;
+}
+
+compressor_handle* compressor_create(double sample_rate, int num_channels, int max_block_size)
+{
+    if (! (sample_rate > 0.0) || num_channels < 1 || num_channels > maxChannels || max_block_size <= 0)
+        return nullptr;
+
+    // Nothing may unwind through the C interface
+    try
+    {
+        auto handle = std::make_unique<compressor_handle>();
+        handle->numChannels = num_channels;
+        handle->maxBlockSize = max_block_size;
+
+        auto& compressor = handle->compressor;
+        compressor.prepare({ sample_rate, static_cast<juce::uint32>(max_block_size), static_cast<juce::uint32>(num_channels) });
+
+        // Start from the plugin's defaults
+        compressor.setThreshold(-10.0f);
+        compressor.setRatio(2.0f);
+        compressor.setKnee(6.0f);
+        compressor.setAttack(2.0f);
+        compressor.setRelease(140.0f);
+
+        return handle.release();
+    }
+    catch (...)
+    {
+        return nullptr;
+    }
+}
+
+void compressor_destroy(compressor_handle* handle)
+{
+    delete handle;
+}
+
+namespace
+{
+    // The plugin's ranges, outside them the detector and gain computer divide by zero or diverge
+    bool isInRange(compressor_parameter parameter, float value)
+    {
+        using namespace GlobalParameters::Parameter;
+
+        switch (parameter)
+        {
+            case COMPRESSOR_INPUT_GAIN:     return inputBounds.contains(value);
+            case COMPRESSOR_THRESHOLD:      return thresholdBounds.contains(value);
+            case COMPRESSOR_RATIO:          return ratioBounds.contains(value);
+            case COMPRESSOR_KNEE:           return kneeBounds.contains(value);
+            case COMPRESSOR_ATTACK:         return attackBounds.contains(value);
+            case COMPRESSOR_RELEASE:        return releaseBounds.contains(value);
+            case COMPRESSOR_MAKEUP:         return makeupBounds.contains(value);
+            case COMPRESSOR_MIX:            return mixBounds.contains(value);
+            case COMPRESSOR_CEILING:        return ceilingBounds.contains(value);
+            default:                        return std::isfinite(value);
+        }
+    }
+}
+
+compressor_status compressor_set_parameter(compressor_handle* handle, compressor_parameter parameter, float value)
+{
+    if (handle == nullptr || ! isInRange(parameter, value))
+        return COMPRESSOR_INVALID_ARGUMENT;
+
+    auto& compressor = handle->compressor;
+
+    switch (parameter)
+    {
+        case COMPRESSOR_INPUT_GAIN:     compressor.setInput(value); break;
+        case COMPRESSOR_THRESHOLD:      compressor.setThreshold(value); break;
+        case COMPRESSOR_RATIO:          compressor.setRatio(value); break;
+        case COMPRESSOR_KNEE:           compressor.setKnee(value); break;
+        case COMPRESSOR_ATTACK:         compressor.setAttack(value); break;
+        case COMPRESSOR_RELEASE:        compressor.setRelease(value); break;
+        case COMPRESSOR_MAKEUP:         compressor.setMakeup(value); break;
+        case COMPRESSOR_MIX:            compressor.setMix(value); break;
+        case COMPRESSOR_TRUE_PEAK:      compressor.setTruePeak(value > 0.5f); break;
+        case COMPRESSOR_CEILING:        compressor.setCeiling(value); break;
+
+        case COMPRESSOR_MID_SIDE:
+            if (value > 0.5f && handle->numChannels != 2)
+                return COMPRESSOR_INVALID_ARGUMENT;
+            compressor.setMidSide(value > 0.5f);
+            break;
+
+        default:
+            return COMPRESSOR_INVALID_ARGUMENT;
+    }
+
+    return COMPRESSOR_OK;
+}
+
+namespace
+{
+    compressor_status checkBlock(const compressor_handle* handle, const void* samples, int numFrames)
+    {
+        if (handle == nullptr || samples == nullptr || numFrames < 0)
+            return COMPRESSOR_INVALID_ARGUMENT;
+
+        return numFrames > handle->maxBlockSize ? COMPRESSOR_BLOCK_TOO_LARGE : COMPRESSOR_OK;
+    }
+}
+
+compressor_status compressor_process_interleaved_f32(compressor_handle* handle, float* samples, int num_frames)
+{
+    const auto status = checkBlock(handle, samples, num_frames);
+    if (status == COMPRESSOR_OK && num_frames > 0)
+        handle->compressor.processInterleaved(samples, handle->numChannels, num_frames);
+
+    return status;
+}
+
+compressor_status compressor_process_interleaved_s16(compressor_handle* handle, int16_t* samples, int num_frames)
+{
+    const auto status = checkBlock(handle, samples, num_frames);
+    if (status == COMPRESSOR_OK && num_frames > 0)
+        handle->compressor.processInterleaved(reinterpret_cast<juce::int16*>(samples), handle->numChannels, num_frames);
+
+    return status;
+}
+
+compressor_status compressor_process_planar_f32(compressor_handle* handle, float* const* channels, int num_frames)
+{
+    const auto status = checkBlock(handle, channels, num_frames);
+    if (status != COMPRESSOR_OK || num_frames == 0)
+        return status;
+
+    // One channel is the same in both layouts, and the fused pass needs no copy
+    if (handle->numChannels == 1)
+    {
+        handle->compressor.processInterleaved(channels[0], 1, num_frames);
+        return status;
+    }
+
+    // Refers to the caller's memory, nothing is copied
+    juce::AudioBuffer<float> buffer(channels, handle->numChannels, num_frames);
+    handle->compressor.process(buffer);
+    return status;
+}
+
+float compressor_get_gain_reduction(const compressor_handle* handle)
+{
+    return handle != nullptr ? handle->compressor.getMaxGainReduction() : 0.0f;
+}
+
+int compressor_get_latency(const compressor_handle* handle)
+{
+    return handle != nullptr ? handle->compressor.getLatencyInSamples() : 0;
+}
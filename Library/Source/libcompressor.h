@@ -0,0 +1,90 @@
+/*
+  ==============================================================================
+
+    libcompressor.h
+    Created: 23 Oct 2026 10:04:51am
+    Author:  Linus
+
+    C interface to the compressor for hosts that are not plugin hosts, e.g.
+    media pipeline servers calling it through cgo or ctypes. The interface is
+    plain C and only grows: functions and parameter ids are never changed or
+    removed, so LIBCOMPRESSOR_API_VERSION only goes up.
+
+  ==============================================================================
+*/
+
+#ifndef LIBCOMPRESSOR_H
+#define LIBCOMPRESSOR_H
+
+#include <stdint.h>
+
+#if defined (_WIN32)
+ #if defined (LIBCOMPRESSOR_BUILD)
+  #define LIBCOMPRESSOR_API __declspec(dllexport)
+ #else
+  #define LIBCOMPRESSOR_API __declspec(dllimport)
+ #endif
+#else
+ #define LIBCOMPRESSOR_API __attribute__((visibility("default")))
+#endif
+
+#define LIBCOMPRESSOR_API_VERSION 1
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+typedef struct compressor_handle compressor_handle;
+
+typedef enum compressor_status
+{
+    COMPRESSOR_OK = 0,
+    COMPRESSOR_INVALID_ARGUMENT = -1,   /* null handle or buffer, unknown parameter, value outside its range, bad count */
+    COMPRESSOR_BLOCK_TOO_LARGE = -2     /* more frames than max_block_size given to create */
+} compressor_status;
+
+/* Values are in the units and ranges of the plugin's parameters */
+typedef enum compressor_parameter
+{
+    COMPRESSOR_INPUT_GAIN = 0,          /* dB */
+    COMPRESSOR_THRESHOLD = 1,           /* dB */
+    COMPRESSOR_RATIO = 2,               /* n:1, above 23.9 a limiter */
+    COMPRESSOR_KNEE = 3,                /* dB */
+    COMPRESSOR_ATTACK = 4,              /* ms */
+    COMPRESSOR_RELEASE = 5,             /* ms */
+    COMPRESSOR_MAKEUP = 6,              /* dB */
+    COMPRESSOR_MIX = 7,                 /* 0..1 */
+    COMPRESSOR_MID_SIDE = 8,            /* 0 or 1, stereo only */
+    COMPRESSOR_TRUE_PEAK = 9,           /* 0 or 1, adds latency */
+    COMPRESSOR_CEILING = 10             /* dBTP */
+} compressor_parameter;
+
+LIBCOMPRESSOR_API int compressor_get_api_version(void);
+
+/* 1 to 8 channels. Returns NULL if an argument is out of range. Allocates
+   everything the instance will ever need, the process calls never allocate.
+   Parameters start at the plugin's defaults. */
+LIBCOMPRESSOR_API compressor_handle* compressor_create(double sample_rate, int num_channels, int max_block_size);
+
+LIBCOMPRESSOR_API void compressor_destroy(compressor_handle*);
+
+/* Not thread safe against a process call on the same handle */
+LIBCOMPRESSOR_API compressor_status compressor_set_parameter(compressor_handle*, compressor_parameter, float value);
+
+/* In place, num_frames frames of num_channels samples each. int16 is full scale
+   at 32768 and saturates. Blocks longer than max_block_size are rejected. */
+LIBCOMPRESSOR_API compressor_status compressor_process_interleaved_f32(compressor_handle*, float* samples, int num_frames);
+LIBCOMPRESSOR_API compressor_status compressor_process_interleaved_s16(compressor_handle*, int16_t* samples, int num_frames);
+LIBCOMPRESSOR_API compressor_status compressor_process_planar_f32(compressor_handle*, float* const* channels, int num_frames);
+
+/* Deepest gain reduction of the last block in dB, 0 or negative */
+LIBCOMPRESSOR_API float compressor_get_gain_reduction(const compressor_handle*);
+
+/* Delay added by the true peak ceiling, 0 while it is off */
+LIBCOMPRESSOR_API int compressor_get_latency(const compressor_handle*);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
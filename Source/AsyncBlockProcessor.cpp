@@ -0,0 +1,274 @@
+/*
+  ==============================================================================
+
+    AsyncBlockProcessor.cpp
+    Created: 25 Oct 2026 9:38:05am
+    Author:  Linus
+
+  ==============================================================================
+*/
+
+#include "AsyncBlockProcessor.h"
+#include "RealtimeSafety.h"
+
+namespace
+{
+    // The worker yields this often before it starts sleeping between polls, which
+    // covers the gap between two blocks of a busy host without burning a core when the
+    // host stops calling. While disabled there is no worker at all.
+    constexpr int spinPolls = 2000;
+}
+
+AsyncBlockProcessor::AsyncBlockProcessor(ProcessCallback callback)
+    : juce::Thread("Compressor worker"), processCallback(std::move(callback))
+{
+}
+
+AsyncBlockProcessor::~AsyncBlockProcessor()
+{
+    stopThread(1000);
+}
+
+void AsyncBlockProcessor::prepare(int numChannels, int maximumBlockSize)
+{
+    stopThread(1000);
+
+    // Nothing is allocated until the worker is first needed, most instances never use it
+    maxBlockSize = juce::jmax(1, maximumBlockSize);
+    numPreparedChannels = numChannels;
+    work.setSize(0, 0);
+    output.setSize(0, 0);
+    workSamples = 0;
+    submitted = false;
+    active = false;
+    skippedSamples = droppedSamples = 0;
+    numLateBlocks = 0;
+    prepared = true;
+
+    if (enabled)
+        startWorker();
+}
+
+void AsyncBlockProcessor::release()
+{
+    prepared = false;
+    stopThread(1000);
+}
+
+void AsyncBlockProcessor::setEnabled(bool shouldBeEnabled)
+{
+    enabled = shouldBeEnabled;
+
+    // A disabled worker would only poll, so it goes away. A block still in flight is
+    // dropped: isWorkerBusy lets go of it once the thread has stopped.
+    if (! shouldBeEnabled)
+        stopThread(1000);
+    else if (prepared && ! isThreadRunning())
+        startWorker();
+}
+
+void AsyncBlockProcessor::startWorker()
+{
+    // process only reads the buffers once the thread runs, so sizing them first is safe
+    work.setSize(numPreparedChannels, maxBlockSize);
+    output.setSize(numPreparedChannels, 2 * maxBlockSize);
+    startThread(juce::Thread::realtimeAudioPriority);
+}
+
+bool AsyncBlockProcessor::isEnabled() const
+{
+    return enabled;
+}
+
+int AsyncBlockProcessor::getLatencyInSamples() const
+{
+    return enabled ? maxBlockSize : 0;
+}
+
+int AsyncBlockProcessor::getNumLateBlocks() const
+{
+    return numLateBlocks.load();
+}
+
+void AsyncBlockProcessor::setWaitsForWorker(bool shouldWait)
+{
+    waitsForWorker.store(shouldWait, std::memory_order_relaxed);
+}
+
+void AsyncBlockProcessor::process(juce::AudioBuffer<float>& buffer)
+{
+    const int numSamples = buffer.getNumSamples();
+    const bool useWorker = enabled.load(std::memory_order_acquire) && isThreadRunning()
+                           && numSamples <= maxBlockSize && buffer.getNumChannels() <= work.getNumChannels();
+
+    if (active && isWorkerBusy())
+    {
+        ++numLateBlocks;
+
+        if (waitsForWorker.load(std::memory_order_relaxed))
+        {
+            waitForWorker();
+        }
+        else
+        {
+            // A block the queue can't stand for goes out silent; the worker is done by
+            // the time a block the mode can't take switches modes
+            if (numSamples <= maxBlockSize && buffer.getNumChannels() <= output.getNumChannels())
+                popLateBlock(buffer, numSamples);
+            else
+                buffer.clear();
+            return;
+        }
+    }
+
+    if (useWorker != active)
+    {
+        // The worker holds no block by now, whatever it gave back belongs to the mode being left
+        active = useWorker;
+        workSamples = 0;
+        skippedSamples = droppedSamples = 0;
+
+        // The first blocks are the latency
+        output.clear();
+        outputStart = 0;
+        outputSize = maxBlockSize;
+    }
+
+    if (! active)
+    {
+        processCallback(buffer);
+        return;
+    }
+
+    // The previous block is done and its output joins the queue before this block's
+    // input goes to the worker, so there are always at least maxBlockSize samples to take
+    pushWorkerOutput();
+
+    for (int ch = 0; ch < work.getNumChannels(); ++ch)
+    {
+        if (ch < buffer.getNumChannels())
+            work.copyFrom(ch, 0, buffer, ch, 0, numSamples);
+        else
+            work.clear(ch, 0, numSamples);
+    }
+    workSamples = numSamples;
+
+    popOutput(buffer, numSamples);
+    submitted.store(true, std::memory_order_release);
+}
+
+void AsyncBlockProcessor::run()
+{
+    int idlePolls = 0;
+
+    while (! threadShouldExit())
+    {
+        if (! submitted.load(std::memory_order_acquire))
+        {
+            if (++idlePolls < spinPolls)
+                juce::Thread::yield();
+            else
+                wait(1);
+            continue;
+        }
+
+        idlePolls = 0;
+        {
+            COMPRESSOR_REALTIME_SCOPE();
+
+            // Refers to the prepared memory, so this allocates nothing
+            juce::AudioBuffer<float> block(work.getArrayOfWritePointers(), work.getNumChannels(), workSamples);
+            processCallback(block);
+        }
+
+        submitted.store(false, std::memory_order_release);
+    }
+}
+
+bool AsyncBlockProcessor::isWorkerBusy()
+{
+    if (! submitted.load(std::memory_order_acquire))
+        return false;
+
+    if (! isThreadRunning())
+    {
+        submitted = false;
+        return false;
+    }
+
+    return true;
+}
+
+void AsyncBlockProcessor::waitForWorker()
+{
+    while (isWorkerBusy())
+        juce::Thread::yield();
+}
+
+void AsyncBlockProcessor::popLateBlock(juce::AudioBuffer<float>& destination, int numSamples)
+{
+    // What the queue holds is due now. The rest of the block would have been the start
+    // of the worker's output, which goes out as silence and is skipped when it arrives.
+    const int available = juce::jmin(numSamples, outputSize);
+    popOutput(destination, available);
+    for (int ch = 0; ch < destination.getNumChannels(); ++ch)
+        destination.clear(ch, available, numSamples - available);
+
+    skippedSamples += numSamples - available;
+
+    // This block's input never reaches the worker, its place in the output stays silent
+    droppedSamples += numSamples;
+}
+
+void AsyncBlockProcessor::pushWorkerOutput()
+{
+    const int skippedWork = juce::jmin(skippedSamples, workSamples);
+    pushOutput(&work, skippedWork, workSamples - skippedWork);
+    pushOutput(nullptr, 0, droppedSamples - (skippedSamples - skippedWork));
+    skippedSamples = droppedSamples = 0;
+}
+
+void AsyncBlockProcessor::pushOutput(const juce::AudioBuffer<float>* source, int sourceStart, int numSamples)
+{
+    const int capacity = output.getNumSamples();
+    jassert(outputSize + numSamples <= capacity);
+
+    const int end = (outputStart + outputSize) % capacity;
+    const int first = juce::jmin(numSamples, capacity - end);
+
+    for (int ch = 0; ch < output.getNumChannels(); ++ch)
+    {
+        if (source == nullptr)
+        {
+            output.clear(ch, end, first);
+            if (first < numSamples)
+                output.clear(ch, 0, numSamples - first);
+        }
+        else
+        {
+            output.copyFrom(ch, end, *source, ch, sourceStart, first);
+            if (first < numSamples)
+                output.copyFrom(ch, 0, *source, ch, sourceStart + first, numSamples - first);
+        }
+    }
+
+    outputSize += numSamples;
+}
+
+void AsyncBlockProcessor::popOutput(juce::AudioBuffer<float>& destination, int numSamples)
+{
+    const int capacity = output.getNumSamples();
+    jassert(numSamples <= outputSize);
+
+    const int first = juce::jmin(numSamples, capacity - outputStart);
+
+    for (int ch = 0; ch < destination.getNumChannels(); ++ch)
+    {
+        destination.copyFrom(ch, 0, output, ch, outputStart, first);
+        if (first < numSamples)
+            destination.copyFrom(ch, first, output, ch, 0, numSamples - first);
+    }
+
+    outputStart = (outputStart + numSamples) % capacity;
+    outputSize -= numSamples;
+}
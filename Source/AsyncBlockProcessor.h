@@ -0,0 +1,114 @@
+/*
+  ==============================================================================
+
+    AsyncBlockProcessor.h
+    Created: 25 Oct 2026 9:12:40am
+    Author:  Linus
+
+  ==============================================================================
+*/
+
+#pragma once
+#include <atomic>
+#include <functional>
+#include <JuceHeader.h>
+
+// Runs the processing of each block on a real-time priority worker thread instead of
+// the host's audio thread, for hosts that call every plugin from one thread with large
+// blocks. process hands the block over and returns output that is one maximum block
+// size late, so the worker has a whole block's duration while the host runs the rest
+// of its chain. The audio thread never locks: a block is handed over through an
+// atomic flag. If the worker is still busy with the previous one, the audio thread
+// neither waits nor runs the processing at the same time: the block's input is dropped
+// and what the output has ready goes out, silence where it has nothing, with the
+// output staying aligned. An offline render waits instead, see setWaitsForWorker.
+class AsyncBlockProcessor : private juce::Thread
+{
+public:
+    using ProcessCallback = std::function<void(juce::AudioBuffer<float>&)>;
+
+    explicit AsyncBlockProcessor(ProcessCallback);
+    ~AsyncBlockProcessor() override;
+
+    // Allocates for blocks up to maximumBlockSize and restarts the worker if enabled.
+    // Call while process isn't running, e.g. from prepareToPlay.
+    void prepare(int numChannels, int maximumBlockSize);
+
+    // Stops the worker, e.g. from releaseResources
+    void release();
+
+    // Starts or stops the worker, so call from the message thread. process switches
+    // at the start of its next block; the blocks in flight are dropped.
+    void setEnabled(bool);
+
+    bool isEnabled() const;
+
+    // The maximum block size while enabled, the delay stays the same for smaller blocks
+    int getLatencyInSamples() const;
+
+    // Blocks the worker wasn't done with its previous block for, dropped or waited on
+    int getNumLateBlocks() const;
+
+    // While set, process waits for a late worker instead of dropping the block, for
+    // renders where every block must come out and time doesn't matter. Safe from any
+    // thread, e.g. set from the audio callback as the host's non-realtime flag changes.
+    void setWaitsForWorker(bool);
+
+    // Processes the block in place, on the worker while enabled
+    void process(juce::AudioBuffer<float>&);
+
+private:
+    void run() override;
+
+    // Allocates the buffers and starts the thread, from the message thread
+    void startWorker();
+
+    // Whether the worker still holds a block. A block left to a worker that stopped is
+    // dropped, nobody would ever finish it.
+    bool isWorkerBusy();
+
+    // Returns once the worker is done with the block it was handed
+    void waitForWorker();
+
+    // Sends out what the queue has for a block the worker was late for, and keeps
+    // account of the output that block's silence stands in for
+    void popLateBlock(juce::AudioBuffer<float>&, int numSamples);
+
+    // The worker's last block, less what went out as silence in its place, then the
+    // silence owed for the blocks that were dropped
+    void pushWorkerOutput();
+
+    // nullptr pushes silence
+    void pushOutput(const juce::AudioBuffer<float>*, int sourceStart, int numSamples);
+    void popOutput(juce::AudioBuffer<float>&, int numSamples);
+
+    ProcessCallback processCallback;
+
+    int maxBlockSize{ 0 };
+    int numPreparedChannels{ 0 };
+    bool prepared{ false };
+    std::atomic<bool> enabled{ false };
+    std::atomic<bool> waitsForWorker{ false };
+
+    // Only the audio thread knows whether the worker is in use
+    bool active{ false };
+
+    // Handed over while submitted is set, then only the worker touches it
+    juce::AudioBuffer<float> work;
+    int workSamples{ 0 };
+    std::atomic<bool> submitted{ false };
+
+    // Processed samples waiting to go out, only touched by the audio thread
+    juce::AudioBuffer<float> output;
+    int outputStart{ 0 };
+    int outputSize{ 0 };
+
+    // Since the worker was last late: samples of its output that already went out as
+    // silence, and samples of dropped input whose place in the output is silent
+    int skippedSamples{ 0 };
+    int droppedSamples{ 0 };
+
+    std::atomic<int> numLateBlocks{ 0 };
+
+    JUCE_DECLARE_NON_COPYABLE(AsyncBlockProcessor)
+};
@@ -0,0 +1,221 @@
+/*
+  ==============================================================================
+
+    AutoTuner.cpp
+    Created: 27 Oct 2026 10:22:47am
+    Author:  Linus
+
+  ==============================================================================
+*/
+
+#include "AutoTuner.h"
+#include <algorithm>
+#include <limits>
+#include <map>
+#include <utility>
+
+namespace
+{
+    // Process-wide, like the transfer curves, but never released: a tuning is a few bytes
+    struct Cache
+    {
+        juce::CriticalSection lock;
+        juce::File file;
+        std::map<std::pair<int, int>, AutoTuner::Tuning> tunings;     // by block size and channels
+    };
+
+    Cache& getCache()
+    {
+        static Cache cache;
+        return cache;
+    }
+
+    const char* getKernelName(Compressor::Kernel kernel)
+    {
+        return kernel == Compressor::Kernel::fused ? "fused" : "multi-pass";
+    }
+
+    // Tunings of this CPU model in the file, other models' are left alone
+    void loadTunings(Cache& cache)
+    {
+        const auto xml = juce::parseXML(cache.file);
+        if (xml == nullptr)
+            return;
+
+        const auto cpu = AutoTuner::getCpuModel();
+        for (auto* entry : xml->getChildWithTagNameIterator("TUNING"))
+        {
+            const int tileSize = entry->getIntAttribute("tileSize", -1);
+            if (entry->getStringAttribute("cpu") != cpu || tileSize < 0)
+                continue;
+
+            AutoTuner::Tuning tuning;
+            tuning.tileSize = tileSize;
+            tuning.kernel = entry->getStringAttribute("kernel") == "fused" ? Compressor::Kernel::fused
+                                                                           : Compressor::Kernel::multiPass;
+            cache.tunings.emplace(std::make_pair(entry->getIntAttribute("blockSize"), entry->getIntAttribute("channels")), tuning);
+        }
+    }
+
+    void saveTuning(const Cache& cache, int blockSize, int numChannels, const AutoTuner::Tuning& tuning)
+    {
+        if (cache.file == juce::File())
+            return;
+
+        auto xml = juce::parseXML(cache.file);
+        if (xml == nullptr || ! xml->hasTagName("AUTOTUNER"))
+            xml = std::make_unique<juce::XmlElement>("AUTOTUNER");
+
+        // Another process may have measured the same spec in the meantime
+        const auto cpu = AutoTuner::getCpuModel();
+        std::vector<juce::XmlElement*> replaced;
+        for (auto* entry : xml->getChildWithTagNameIterator("TUNING"))
+            if (entry->getStringAttribute("cpu") == cpu && entry->getIntAttribute("blockSize") == blockSize
+                && entry->getIntAttribute("channels") == numChannels)
+                replaced.push_back(entry);
+        for (auto* entry : replaced)
+            xml->removeChildElement(entry, true);
+
+        auto* entry = xml->createNewChildElement("TUNING");
+        entry->setAttribute("cpu", cpu);
+        entry->setAttribute("blockSize", blockSize);
+        entry->setAttribute("channels", numChannels);
+        entry->setAttribute("tileSize", tuning.tileSize);
+        entry->setAttribute("kernel", getKernelName(tuning.kernel));
+
+        cache.file.getParentDirectory().createDirectory();
+        xml->writeTo(cache.file);
+    }
+}
+
+AutoTuner::Tuning AutoTuner::getTuning(const juce::dsp::ProcessSpec& spec)
+{
+    auto& cache = getCache();
+    const int blockSize = static_cast<int>(spec.maximumBlockSize);
+    const int numChannels = static_cast<int>(spec.numChannels);
+
+    // Held while measuring, so instances prepared at once measure only once
+    const juce::ScopedLock sl(cache.lock);
+    const auto found = cache.tunings.find({ blockSize, numChannels });
+    if (found != cache.tunings.end())
+        return found->second;
+
+    const auto tuning = pick(measure(spec));
+    cache.tunings.emplace(std::make_pair(blockSize, numChannels), tuning);
+    saveTuning(cache, blockSize, numChannels, tuning);
+    return tuning;
+}
+
+void AutoTuner::setCacheFile(const juce::File& file)
+{
+    auto& cache = getCache();
+    const juce::ScopedLock sl(cache.lock);
+    if (file == cache.file)
+        return;
+
+    cache.file = file;
+    if (file.existsAsFile())
+        loadTunings(cache);
+}
+
+std::vector<AutoTuner::Measurement> AutoTuner::measure(const juce::dsp::ProcessSpec& spec)
+{
+    const int blockSize = juce::jmax(1, static_cast<int>(spec.maximumBlockSize));
+    const int numChannels = juce::jmax(1, static_cast<int>(spec.numChannels));
+    const int numBlocks = juce::jmax(1, framesPerRun / blockSize);
+
+    // Noise bursts in and out of compression, the same on every run
+    juce::Random random(0x54554e45);
+    juce::AudioBuffer<float> signal(numChannels, numBlocks * blockSize);
+    for (int ch = 0; ch < numChannels; ++ch)
+        for (int i = 0; i < signal.getNumSamples(); ++i)
+            signal.setSample(ch, i, ((i / 1024) % 2 == 0 ? 0.05f : 0.8f) * (2.0f * random.nextFloat() - 1.0f));
+
+    // Typical settings, with the shared curve the plugin would use
+    Compressor compressor;
+    compressor.prepare({ spec.sampleRate, static_cast<juce::uint32>(blockSize), static_cast<juce::uint32>(numChannels) });
+    compressor.setThreshold(-24.0f);
+    compressor.setRatio(4.0f);
+    compressor.setKnee(6.0f);
+    compressor.setAttack(5.0f);
+    compressor.setRelease(80.0f);
+    compressor.setMakeup(3.0f);
+    compressor.setTransferCurve(juce::SharedResourcePointer<TransferCurveCache>()->getCurve(-24.0f, 4.0f, 6.0f));
+
+    const auto candidates = getCandidates(blockSize);
+    std::vector<Measurement> measurements;
+    for (const auto& tuning : candidates)
+        measurements.push_back({ tuning, std::numeric_limits<double>::max() });
+
+    // Every candidate once per run, so a burst of noise from elsewhere can't favour one;
+    // the best run of each counts
+    juce::AudioBuffer<float> block(numChannels, blockSize);
+    for (int run = 0; run < numRuns; ++run)
+    {
+        for (auto& measurement : measurements)
+        {
+            compressor.setTuning(measurement.tuning);
+
+            const auto start = juce::Time::getHighResolutionTicks();
+            for (int b = 0; b < numBlocks; ++b)
+            {
+                for (int ch = 0; ch < numChannels; ++ch)
+                    block.copyFrom(ch, 0, signal, ch, b * blockSize, blockSize);
+                compressor.process(block);
+            }
+            const auto seconds = juce::Time::highResolutionTicksToSeconds(juce::Time::getHighResolutionTicks() - start);
+
+            measurement.nanosecondsPerFrame = juce::jmin(measurement.nanosecondsPerFrame,
+                                                         1.0e9 * seconds / static_cast<double>(numBlocks * blockSize));
+        }
+    }
+
+    std::stable_sort(measurements.begin(), measurements.end(), [](const Measurement& a, const Measurement& b)
+    {
+        return a.nanosecondsPerFrame < b.nanosecondsPerFrame;
+    });
+    return measurements;
+}
+
+AutoTuner::Tuning AutoTuner::pick(const std::vector<Measurement>& measurements)
+{
+    const auto byDefault = std::find_if(measurements.begin(), measurements.end(),
+                                        [](const Measurement& m) { return m.tuning == Tuning(); });
+    const auto fastest = std::min_element(measurements.begin(), measurements.end(), [](const Measurement& a, const Measurement& b)
+    {
+        return a.nanosecondsPerFrame < b.nanosecondsPerFrame;
+    });
+
+    if (fastest == measurements.end())
+        return {};
+
+    if (byDefault != measurements.end() && fastest->nanosecondsPerFrame * minimumSpeedup > byDefault->nanosecondsPerFrame)
+        return {};
+
+    return fastest->tuning;
+}
+
+std::vector<AutoTuner::Tuning> AutoTuner::getCandidates(int maxBlockSize)
+{
+    // A tile as big as the block is the whole block again
+    std::vector<int> tileSizes{ 0 };
+    for (int tileSize = minimumTileSize; 2 * tileSize <= maxBlockSize; tileSize *= 2)
+        tileSizes.push_back(tileSize);
+
+    std::vector<Tuning> candidates;
+    for (const auto kernel : { Compressor::Kernel::multiPass, Compressor::Kernel::fused })
+        for (const int tileSize : tileSizes)
+            candidates.push_back({ tileSize, kernel });
+    return candidates;
+}
+
+juce::String AutoTuner::describe(const Tuning& tuning)
+{
+    return juce::String(getKernelName(tuning.kernel)) + ", "
+         + (tuning.tileSize > 0 ? juce::String(tuning.tileSize) + " sample tiles" : juce::String("whole blocks"));
+}
+
+juce::String AutoTuner::getCpuModel()
+{
+    return juce::SystemStats::getCpuVendor() + " " + juce::SystemStats::getCpuModel();
+}
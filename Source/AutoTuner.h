@@ -0,0 +1,59 @@
+/*
+  ==============================================================================
+
+    AutoTuner.h
+    Created: 27 Oct 2026 9:41:05am
+    Author:  Linus
+
+  ==============================================================================
+*/
+
+#pragma once
+#include <vector>
+#include <JuceHeader.h>
+#include "Compressor.h"
+
+// Picks the fastest Compressor::Tuning for a spec on this machine. Every tuning
+// renders the same output, so the choice only ever changes the speed. A measurement
+// times each candidate over a few thousand frames of noise on a throwaway compressor,
+// a few milliseconds in all. Results are kept for the life of the process, keyed by
+// block size and channel count, and in the cache file if one is set, keyed by CPU
+// model as well. Safe from any thread but the audio thread.
+class AutoTuner
+{
+public:
+    using Tuning = Compressor::Tuning;
+
+    struct Measurement
+    {
+        Tuning tuning;
+        double nanosecondsPerFrame;
+    };
+
+    // The tuning for the spec, measured on first use for its block size and channel count
+    static Tuning getTuning(const juce::dsp::ProcessSpec&);
+
+    // Takes over the tunings measured on this CPU model from the file, and saves new
+    // ones to it. Setting the file that is already set does nothing.
+    static void setCacheFile(const juce::File&);
+
+    // Times every candidate for the spec, fastest first
+    static std::vector<Measurement> measure(const juce::dsp::ProcessSpec&);
+
+    // Of the measurements, the default tuning unless another beats it by minimumSpeedup
+    static Tuning pick(const std::vector<Measurement>&);
+
+    // The whole block and tiles from 64 samples up to half the block, each with both kernels
+    static std::vector<Tuning> getCandidates(int maxBlockSize);
+
+    // E.g. "fused, 256 sample tiles", for diagnostics
+    static juce::String describe(const Tuning&);
+
+    // What cached tunings are keyed by
+    static juce::String getCpuModel();
+
+    static constexpr double minimumSpeedup = 1.05;
+    static constexpr int minimumTileSize = 64;
+    static constexpr int framesPerRun = 8192;
+    static constexpr int numRuns = 3;
+};
@@ -9,46 +9,114 @@
 */
 
 #include "Compressor.h"
+#include "AutoTuner.h"
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <utility>
 
 Compressor::~Compressor()
 {
-    rawSidechainSignal = nullptr;
+    // The bus is shared, the slot would stay taken
+    if (linkSlot >= 0)
+        detectorBus->leave(linkGroup, linkSlot);
 }
 
 void Compressor::prepare(const juce::dsp::ProcessSpec& spec)
 {
+    procSpec = spec;
     ballistics.prepare(spec.sampleRate);
-    originalSignal.setSize(2, spec.maximumBlockSize);
-    sidechainSignal.resize(spec.maximumBlockSize, 0.0f);
-    rawSidechainSignal = sidechainSignal.data();
-    originalSignal.clear();
+    sideBallistics.prepare(spec.sampleRate);
+    for (int stage = 0; stage < maxStages - 1; ++stage)
+    {
+        stageBallistics[static_cast<size_t>(stage)].prepare(spec.sampleRate);
+        stageSideBallistics[static_cast<size_t>(stage)].prepare(spec.sampleRate);
+    }
+
+    truePeakLimiter.prepare(spec);
+    lastGain = -1.0f;
+    inputPeak = outputPeak = 0.0f;
+
+    // Measured once per block size and channel count, every other instance gets it cached
+    if (autoTune)
+        tuning = AutoTuner::getTuning(spec);
+    lastSideGain = -1.0f;
+
+    // Presets are built for one sample rate, and the bank rebuilds them after this
+    {
+        const juce::SpinLock::ScopedLockType sl(presetLock);
+        pendingPreset = nullptr;
+    }
+
+    // Side-chains (mid and side in M/S mode) are the only per-block buffers, plus a copy
+    // of the block while crossfading presets, a planar copy of interleaved input, the
+    // levels and stage input of a chain and whatever the ceiling needs
+    const int maxBlockSize = static_cast<int>(spec.maximumBlockSize);
+    const size_t blockSize = ScratchArena::getAlignedSize(spec.maximumBlockSize);
+    const size_t numCopied = juce::jmin(static_cast<size_t>(spec.numChannels), static_cast<size_t>(maxCopiedChannels));
+    scratch->reserve((4 + 2 * numCopied) * blockSize + truePeakLimiter.getScratchSize(maxBlockSize));
 }
 
 // Gain Computer setters
 void Compressor::setThreshold(float threshold)
 {
     gainComputer.setThreshold(threshold);
+    sideGainComputer.setThreshold(threshold);
 }
 
 void Compressor::setRatio(float ratio)
 {
     gainComputer.setRatio(ratio);
+    sideGainComputer.setRatio(ratio);
 }
 
 void Compressor::setKnee(float knee)
 {
     gainComputer.setKnee(knee);
+    sideGainComputer.setKnee(knee);
+}
+
+void Compressor::setTransferCurve(TransferCurve::Ptr curve)
+{
+    sideGainComputer.setTransferCurve(curve);
+    gainComputer.setTransferCurve(std::move(curve));
+}
+
+void Compressor::setGate(float threshold, float range)
+{
+    gainComputer.setGate(threshold, range);
+    sideGainComputer.setGate(threshold, range);
+}
+
+void Compressor::setExpander(float threshold, float ratio)
+{
+    gainComputer.setExpander(threshold, ratio);
+    sideGainComputer.setExpander(threshold, ratio);
+}
+
+void Compressor::setUpward(float threshold, float ratio, float maxBoost)
+{
+    gainComputer.setUpward(threshold, ratio, maxBoost);
+    sideGainComputer.setUpward(threshold, ratio, maxBoost);
+}
+
+void Compressor::setLimiter(float threshold)
+{
+    gainComputer.setLimiter(threshold);
+    sideGainComputer.setLimiter(threshold);
 }
 
 // Ballistics setters
 void Compressor::setAttack(float attack)
 {
     ballistics.setAttack(attack * 0.001);
+    sideBallistics.setAttack(attack * 0.001);
 }
 
 void Compressor::setRelease(float release)
 {
     ballistics.setRelease(release * 0.001);
+    sideBallistics.setRelease(release * 0.001);
 }
 
 // General setters
@@ -72,7 +140,122 @@ void Compressor::setMix(float mix)
     this->mix = mix;
 }
 
+void Compressor::setMidSide(bool midSide)
+{
+    this->midSide = midSide;
+}
+
+// Chain setters
+void Compressor::setNumStages(int newNumStages)
+{
+    newNumStages = juce::jlimit(1, maxStages, newNumStages);
+    for (int stage = numStages - 1; stage < newNumStages - 1; ++stage)
+    {
+        stageBallistics[static_cast<size_t>(stage)].reset();
+        stageSideBallistics[static_cast<size_t>(stage)].reset();
+    }
+
+    numStages = newNumStages;
+}
+
+int Compressor::getNumStages() const
+{
+    return numStages;
+}
+
+void Compressor::setStage(int index, const StageSettings& settings)
+{
+    jassert(index >= 1 && index < maxStages);
+    if (index < 1 || index >= maxStages)
+        return;
+
+    const auto stage = static_cast<size_t>(index - 1);
+    for (auto* computer : { &stageGainComputers[stage], &stageSideGainComputers[stage] })
+    {
+        computer->setThreshold(settings.threshold);
+        computer->setRatio(settings.ratio);
+        computer->setKnee(settings.knee);
+    }
+
+    for (auto* detector : { &stageBallistics[stage], &stageSideBallistics[stage] })
+    {
+        detector->setAttack(settings.attack * 0.001);
+        detector->setRelease(settings.release * 0.001);
+    }
+
+    stageMakeups[stage] = settings.makeup;
+}
+
+// True peak ceiling setters
+void Compressor::setTruePeak(bool truePeak)
+{
+    this->truePeak = truePeak;
+}
+
+void Compressor::setCeiling(float ceiling)
+{
+    truePeakLimiter.setCeiling(ceiling);
+}
+
+void Compressor::setPreset(CompressorPreset::Ptr preset, bool crossfade)
+{
+    const juce::SpinLock::ScopedLockType sl(presetLock);
+    pendingPreset = std::move(preset);
+    pendingCrossfade = crossfade;
+}
+
 // Getters
+void Compressor::setQuality(Quality newQuality)
+{
+    quality = newQuality;
+}
+
+Compressor::Quality Compressor::getQuality() const
+{
+    return quality;
+}
+
+void Compressor::setTuning(const Tuning& newTuning)
+{
+    tuning = newTuning;
+    autoTune = false;
+}
+
+Compressor::Tuning Compressor::getTuning() const
+{
+    return tuning;
+}
+
+void Compressor::setAutoTune(bool shouldAutoTune)
+{
+    autoTune = shouldAutoTune;
+}
+
+bool Compressor::isAutoTuned() const
+{
+    return autoTune;
+}
+
+void Compressor::setGainEnvelope(GainEnvelope* envelope)
+{
+    gainEnvelope = envelope;
+}
+
+void Compressor::setLinkGroup(int group)
+{
+    requestedLinkGroup = juce::jlimit(0, DetectorBus::numGroups, group);
+}
+
+int Compressor::getLinkGroup() const
+{
+    return linkSlot >= 0 ? linkGroup : 0;
+}
+
+bool Compressor::isLinkLeader() const
+{
+    return linkSlot >= 0 && detectorBus->isLeader(linkGroup, linkSlot);
+}
+
 float Compressor::getMakeup()
 {
     return makeup;
@@ -83,72 +266,1368 @@ double Compressor::getSampleRate()
     return procSpec.sampleRate;
 }
 
-float Compressor::getMaxGainReduction()
+float Compressor::getMaxGainReduction() const
 {
     return maxGainReduction;
 }
 
+float Compressor::getInputPeak() const
+{
+    return inputPeak;
+}
+
+float Compressor::getOutputPeak() const
+{
+    return outputPeak;
+}
+
+int Compressor::getLatencyInSamples() const
+{
+    return truePeak ? truePeakLimiter.getLatencyInSamples() : 0;
+}
+
+#if COMPRESSOR_PROFILING
+ProcessProfiler& Compressor::getProfiler()
+{
+    return profiler;
+}
+#endif
+
+namespace
+{
+    // Max |x| over the channels, a vectorised min and max per channel. Only for blocks
+    // nothing else passes over: bypassed ones and the true peak limiter's output
+    float getBlockPeak(const juce::AudioBuffer<float>& buffer, int numSamples)
+    {
+        float peak = 0.0f;
+        if (numSamples > 0)
+            for (int ch = 0; ch < buffer.getNumChannels(); ++ch)
+            {
+                const auto range = juce::FloatVectorOperations::findMinAndMax(buffer.getReadPointer(ch), numSamples);
+                peak = juce::jmax(peak, -range.getStart(), range.getEnd());
+            }
+        return peak;
+    }
+
+    // Max |x| of the samples as they come in, while ramping their gain from startGain
+    // towards endGain as AudioBuffer::applyGainRamp does
+    float getPeakAndApplyGainRamp(float* samples, int numSamples, float startGain, float endGain)
+    {
+        const float increment = (endGain - startGain) / static_cast<float>(numSamples);
+        float gain = startGain, peak = 0.0f;
+        for (int i = 0; i < numSamples; ++i)
+        {
+            peak = juce::jmax(peak, std::abs(samples[i]));
+            samples[i] *= gain;
+            gain += increment;
+        }
+        return peak;
+    }
+
+    // Multiplies the samples by the gains, returning max |x| of the result
+    float multiplyAndGetPeak(float* samples, const float* gains, int numSamples)
+    {
+        float peak = 0.0f;
+        for (int i = 0; i < numSamples; ++i)
+        {
+            samples[i] *= gains[i];
+            peak = juce::jmax(peak, std::abs(samples[i]));
+        }
+        return peak;
+    }
+}
+
 void Compressor::process(juce::AudioBuffer<float>& buffer)
 {
     if (bypassed)
+    {
+        inputPeak = outputPeak = getBlockPeak(buffer, buffer.getNumSamples());
         return;
+    }
 
     using namespace juce;
 
+    COMPRESSOR_PROFILE_BLOCK(profiler);
+
     const auto numSamples = buffer.getNumSamples();
-    const auto numChannels = buffer.getNumChannels();
+    const auto maxBlockSize = static_cast<int>(procSpec.maximumBlockSize);
 
-    jassert(numSamples == static_cast<int>(sidechainSignal.size()));
+    // More than prepare reserved scratch memory for goes through in parts that fit
+    if (numSamples > maxBlockSize && maxBlockSize > 0)
+    {
+        float blockInputPeak = 0.0f, blockOutputPeak = 0.0f, blockGainReduction = 0.0f;
+        for (int start = 0; start < numSamples; start += maxBlockSize)
+        {
+            AudioBuffer<float> part(buffer.getArrayOfWritePointers(), buffer.getNumChannels(), start, jmin(maxBlockSize, numSamples - start));
+            process(part);
+            blockInputPeak = jmax(blockInputPeak, inputPeak);
+            blockOutputPeak = jmax(blockOutputPeak, outputPeak);
+            blockGainReduction = jmin(blockGainReduction, maxGainReduction);
+        }
+        inputPeak = blockInputPeak;
+        outputPeak = blockOutputPeak;
+        maxGainReduction = blockGainReduction;
+        return;
+    }
 
-    // Clear any old samples
-    originalSignal.clear();
-    juce::FloatVectorOperations::fill(rawSidechainSignal, 0.0f, numSamples);
+    ScratchArena::Scope scratchScope(*scratch);
+    float* sidechainSignal = scratchScope.allocate(static_cast<size_t>(numSamples));
+    float* sideSignal = scratchScope.allocate(static_cast<size_t>(numSamples));
     maxGainReduction = 0.0f;
+    outputPeak = 0.0f;
+
+    // Without scratch memory the block is left as it is rather than written out of bounds
+    if (sidechainSignal == nullptr || sideSignal == nullptr)
+    {
+        inputPeak = outputPeak = getBlockPeak(buffer, numSamples);
+        return;
+    }
+
+    updateLink();
+
+    // Presets switch at the block boundary, all at once
+    bool crossfade = false;
+    const auto preset = takePendingPreset(crossfade);
+    if (preset != nullptr)
+    {
+        // The input gain ramps to its new value over the block, it needs no crossfade
+        input = preset->settings.inputGain;
+        if (! crossfade)
+            applyPreset(*preset);
+    }
 
     // Apply input gain
-    applyInputGain(buffer, numSamples);
+    {
+        COMPRESSOR_PROFILE_STAGE(profiler, inputGain);
+        applyInputGain(buffer, numSamples);
+    }
+
+    // Wider blocks than the scratch arena holds copies of, or has room for, switch at once
+    float* channels[maxCopiedChannels];
+    if (preset != nullptr && crossfade)
+    {
+        crossfade = buffer.getNumChannels() <= maxCopiedChannels;
+        for (int ch = 0; crossfade && ch < buffer.getNumChannels(); ++ch)
+        {
+            channels[ch] = scratchScope.allocate(static_cast<size_t>(numSamples));
+            crossfade = channels[ch] != nullptr;
+        }
+
+        if (! crossfade)
+            applyPreset(*preset);
+    }
 
-    // Get max l/r amplitude values and fill sidechain signal
-    FloatVectorOperations::abs(rawSidechainSignal, buffer.getReadPointer(0), numSamples);
-    FloatVectorOperations::max(rawSidechainSignal, rawSidechainSignal, buffer.getReadPointer(1), numSamples);
+    if (preset != nullptr && crossfade)
+    {
+        const int numChannels = buffer.getNumChannels();
 
-    // Compute attenuation - converts side-chain signal from linear to logarithmic domain
-    gainComputer.applyCompressionToBuffer(rawSidechainSignal, numSamples);
+        // Render a copy with the outgoing settings, then the block itself with the
+        // incoming ones, both from the same detector state
+        for (int ch = 0; ch < numChannels; ++ch)
+            FloatVectorOperations::copy(channels[ch], buffer.getReadPointer(ch), numSamples);
 
-    // Smooth attenuation - still logarithmic
-    ballistics.applyBallistics(rawSidechainSignal, numSamples);
+        AudioBuffer<float> outgoing(channels, numChannels, numSamples);
+        const LevelDetector ballisticsBefore = ballistics;
+        const LevelDetector sideBallisticsBefore = sideBallistics;
+        const auto stageBallisticsBefore = stageBallistics;
+        const auto stageSideBallisticsBefore = stageSideBallistics;
+        const float lastGainBefore = lastGain, lastSideGainBefore = lastSideGain;
+        auto* const envelope = std::exchange(gainEnvelope, nullptr);
+        const int slot = std::exchange(linkSlot, -1);
+        processGain(outgoing, sidechainSignal, sideSignal);
+        gainEnvelope = envelope;
+        linkSlot = slot;
 
-    // Get minimum = max. gain reduction from side chain buffer
-    maxGainReduction = FloatVectorOperations::findMinimum(rawSidechainSignal, numSamples);
+        ballistics = ballisticsBefore;
+        sideBallistics = sideBallisticsBefore;
+        stageBallistics = stageBallisticsBefore;
+        stageSideBallistics = stageSideBallisticsBefore;
+        lastGain = lastGainBefore;
+        lastSideGain = lastSideGainBefore;
+        applyPreset(*preset);
+        processGain(buffer, sidechainSignal, sideSignal);
 
-    // Add makeup gain and convert side-chain to linear domain
-    for (int i = 0; i < numSamples; ++i)
-        sidechainSignal[i] = Decibels::decibelsToGain(sidechainSignal[i] + makeup);
+        // Linear crossfade over the block, which is what leaves it
+        const float increment = 1.0f / static_cast<float>(numSamples);
+        outputPeak = 0.0f;
+        for (int ch = 0; ch < numChannels; ++ch)
+        {
+            float* incoming = buffer.getWritePointer(ch);
+            for (int i = 0; i < numSamples; ++i)
+            {
+                incoming[i] = channels[ch][i] + static_cast<float>(i + 1) * increment * (incoming[i] - channels[ch][i]);
+                outputPeak = jmax(outputPeak, std::abs(incoming[i]));
+            }
+        }
+    }
+    else
+    {
+        processGain(buffer, sidechainSignal, sideSignal);
+    }
 
-    // Copy buffer to original signal
-    for (int i = 0; i < numChannels; ++i)
-        originalSignal.copyFrom(i, 0, buffer, i, 0, numSamples);
+    // Hold inter-sample peaks under the ceiling, starting from a clean lookahead
+    if (truePeak != truePeakActive)
+    {
+        truePeakActive = truePeak;
+        truePeakLimiter.reset();
+    }
 
-    // Multiply attenuation with buffer - apply compression
-    for (int i = 0; i < numChannels; ++i)
-        FloatVectorOperations::multiply(buffer.getWritePointer(i), rawSidechainSignal, numSamples);
+    // The limiter delays and changes the block, so its output is metered in a pass of its own
+    if (truePeakActive)
+    {
+        COMPRESSOR_PROFILE_STAGE(profiler, truePeak);
+        truePeakLimiter.process(buffer, scratchScope);
+        outputPeak = getBlockPeak(buffer, numSamples);
+    }
+}
 
-    // Mix dry & wet signal
-    for (int i = 0; i < numChannels; ++i)
+void Compressor::processInterleaved(float* samples, int numChannels, int numFrames)
+{
+    processInterleavedSamples(samples, numChannels, numFrames);
+}
+
+void Compressor::processInterleaved(juce::int16* samples, int numChannels, int numFrames)
+{
+    processInterleavedSamples(samples, numChannels, numFrames);
+}
+
+namespace
+{
+    inline float toFloat(float sample)          { return sample; }
+    inline float toFloat(juce::int16 sample)    { return static_cast<float>(sample) * (1.0f / 32768.0f); }
+
+    inline void fromFloat(float value, float& sample)       { sample = value; }
+    inline void fromFloat(float value, juce::int16& sample)
+    {
+        sample = static_cast<juce::int16>(juce::jlimit(-32768, 32767, juce::roundToInt(value * 32768.0f)));
+    }
+
+    // Max |x| of interleaved samples, for blocks that pass through untouched
+    template <typename Sample>
+    float getInterleavedPeak(const Sample* samples, int numSamples)
     {
-        float* channelData = buffer.getWritePointer(i); //wet signal
-        FloatVectorOperations::multiply(channelData, mix, numSamples);
-        FloatVectorOperations::addWithMultiply(channelData, originalSignal.getReadPointer(i), 1 - mix, numSamples);
+        float peak = 0.0f;
+        for (int i = 0; i < numSamples; ++i)
+            peak = juce::jmax(peak, std::abs(toFloat(samples[i])));
+        return peak;
     }
 }
 
-inline void Compressor::applyInputGain(juce::AudioBuffer<float>& buffer, int numSamples)
+template <typename Sample>
+void Compressor::processInterleavedSamples(Sample* samples, int numChannels, int numFrames)
 {
-    if (prevInput == input)
-        buffer.applyGain(0, numSamples, juce::Decibels::decibelsToGain(prevInput));
+    if (bypassed)
+    {
+        inputPeak = outputPeak = getInterleavedPeak(samples, numChannels * numFrames);
+        return;
+    }
+
+    using namespace juce;
+
+    COMPRESSOR_PROFILE_BLOCK(profiler);
+
+    const auto maxBlockSize = static_cast<int>(procSpec.maximumBlockSize);
+
+    // In parts that fit the scratch memory, as process does
+    if (numFrames > maxBlockSize && maxBlockSize > 0)
+    {
+        float blockInputPeak = 0.0f, blockOutputPeak = 0.0f, blockGainReduction = 0.0f;
+        for (int start = 0; start < numFrames; start += maxBlockSize)
+        {
+            processInterleavedSamples(samples + start * numChannels, numChannels, jmin(maxBlockSize, numFrames - start));
+            blockInputPeak = jmax(blockInputPeak, inputPeak);
+            blockOutputPeak = jmax(blockOutputPeak, outputPeak);
+            blockGainReduction = jmin(blockGainReduction, maxGainReduction);
+        }
+        inputPeak = blockInputPeak;
+        outputPeak = blockOutputPeak;
+        maxGainReduction = blockGainReduction;
+        return;
+    }
+
+    ScratchArena::Scope scratchScope(*scratch);
+
+    // Wider blocks than the scratch arena holds copies of take the fused path below
+    if ((usesMidSide(numChannels) || truePeak || truePeakActive) && numChannels <= maxCopiedChannels)
+    {
+        // Deinterleave into the scratch arena and take the planar path
+        float* channels[maxCopiedChannels];
+        for (int ch = 0; ch < numChannels; ++ch)
+        {
+            channels[ch] = scratchScope.allocate(static_cast<size_t>(numFrames));
+            if (channels[ch] == nullptr)
+            {
+                inputPeak = outputPeak = getInterleavedPeak(samples, numChannels * numFrames);
+                maxGainReduction = 0.0f;
+                return;
+            }
+
+            for (int i = 0; i < numFrames; ++i)
+                channels[ch][i] = toFloat(samples[i * numChannels + ch]);
+        }
+
+        AudioBuffer<float> planar(channels, numChannels, numFrames);
+        process(planar);
+
+        for (int ch = 0; ch < numChannels; ++ch)
+            for (int i = 0; i < numFrames; ++i)
+                fromFloat(channels[ch][i], samples[i * numChannels + ch]);
+        return;
+    }
+
+    float* sidechainSignal = scratchScope.allocate(static_cast<size_t>(numFrames));
+    if (sidechainSignal == nullptr)
+    {
+        inputPeak = outputPeak = getInterleavedPeak(samples, numChannels * numFrames);
+        maxGainReduction = 0.0f;
+        return;
+    }
+
+    bool crossfade = false;
+    const auto preset = takePendingPreset(crossfade);
+    if (preset != nullptr)
+    {
+        input = preset->settings.inputGain;
+        applyPreset(*preset);
+    }
+
+    // The input gain ramp of applyInputGain, evaluated per frame in both passes instead
+    const float startGain = Decibels::decibelsToGain(prevInput);
+    const float gainIncrement = (Decibels::decibelsToGain(input) - startGain) / static_cast<float>(numFrames);
+    prevInput = input;
+
+    // First pass: deinterleave straight into the side-chain, max |x| over the frame,
+    // whose max over the block is the input peak
+    float blockPeak = 0.0f;
+    for (int i = 0; i < numFrames; ++i)
+    {
+        const Sample* frame = samples + i * numChannels;
+        float peak = 0.0f;
+        for (int ch = 0; ch < numChannels; ++ch)
+            peak = jmax(peak, std::abs(toFloat(frame[ch])));
+
+        blockPeak = jmax(blockPeak, peak);
+        sidechainSignal[i] = peak * (startGain + static_cast<float>(i) * gainIncrement);
+    }
+    inputPeak = blockPeak;
+
+    if (numStages > 1)
+    {
+        gainComputer.updateTransferCurve();
+        computeChainAttenuation(sidechainSignal, numFrames, false, false);
+    }
     else
     {
-        buffer.applyGainRamp(0, numSamples, juce::Decibels::decibelsToGain(prevInput), juce::Decibels::decibelsToGain(input));
-        prevInput = input;
+        gainComputer.applyCompressionToBuffer(sidechainSignal, numFrames);
+        ballistics.applyBallistics(sidechainSignal, numFrames);
     }
+    maxGainReduction = FloatVectorOperations::findMinimum(sidechainSignal, numFrames);
+    applyMakeupAndMix(sidechainSignal, numFrames);
+
+    if (gainEnvelope != nullptr)
+        gainEnvelope->append(sidechainSignal, nullptr, numFrames);
+
+    // Second pass: input gain and the final gain in one multiply, written back interleaved,
+    // measuring the output peak on the way
+    blockPeak = 0.0f;
+    for (int i = 0; i < numFrames; ++i)
+    {
+        const float gain = (startGain + static_cast<float>(i) * gainIncrement) * sidechainSignal[i];
+        Sample* frame = samples + i * numChannels;
+        for (int ch = 0; ch < numChannels; ++ch)
+        {
+            const float value = toFloat(frame[ch]) * gain;
+            blockPeak = jmax(blockPeak, std::abs(value));
+            fromFloat(value, frame[ch]);
+        }
+    }
+    outputPeak = blockPeak;
+}
+
+bool Compressor::processOffline(juce::AudioBuffer<float>& buffer, juce::ThreadPool& pool)
+{
+    // Only the chain's first stage has an offline form
+    jassert(numStages == 1);
+    if (numStages > 1)
+        return false;
+
+    if (bypassed)
+        return true;
+
+    using namespace juce;
+
+    COMPRESSOR_PROFILE_BLOCK(profiler);
+
+    const int numSamples = buffer.getNumSamples();
+    const int numChannels = buffer.getNumChannels();
+    const bool decodeMidSide = usesMidSide(numChannels);
+
+    std::vector<float> midSignal(static_cast<size_t>(numSamples));
+    std::vector<float> sideSignal(decodeMidSide ? static_cast<size_t>(numSamples) : 0);
+
+    // No ramps offline, the input gain is whatever it is now
+    const float inputGain = Decibels::decibelsToGain(input);
+    prevInput = input;
+
+    gainComputer.updateTransferCurve();
+    sideGainComputer.updateTransferCurve();
+
+    // First pass: the static curve is memoryless, so segments are independent
+    {
+        COMPRESSOR_PROFILE_STAGE(profiler, gainComputer);
+        ParallelSegments::forEach(pool, numSamples, ParallelSegments::defaultSegmentSize, [&](int start, int num)
+        {
+            for (int ch = 0; ch < numChannels; ++ch)
+                FloatVectorOperations::multiply(buffer.getWritePointer(ch, start), inputGain, num);
+
+            float* mid = midSignal.data() + start;
+            const float* left = buffer.getReadPointer(0, start);
+            const float* right = buffer.getReadPointer(jmin(1, numChannels - 1), start);
+
+            if (decodeMidSide)
+            {
+                float* side = sideSignal.data() + start;
+                for (int i = 0; i < num; ++i)
+                {
+                    mid[i] = std::abs(0.5f * (left[i] + right[i]));
+                    side[i] = std::abs(0.5f * (left[i] - right[i]));
+                }
+                sideGainComputer.computeAttenuation(side, num);
+            }
+            else
+            {
+                fillLinkedSidechain(buffer, start, num, mid);
+            }
+
+            gainComputer.computeAttenuation(mid, num);
+        });
+    }
+
+    // Second pass, serial: forward-backward smoothing of the whole curve
+    {
+        COMPRESSOR_PROFILE_STAGE(profiler, ballistics);
+        smoothForwardBackward(midSignal.data(), numSamples, ballistics);
+        maxGainReduction = FloatVectorOperations::findMinimum(midSignal.data(), numSamples);
+
+        if (decodeMidSide)
+        {
+            smoothForwardBackward(sideSignal.data(), numSamples, sideBallistics);
+            maxGainReduction = jmin(maxGainReduction, FloatVectorOperations::findMinimum(sideSignal.data(), numSamples));
+        }
+    }
+
+    // Third pass: makeup, mix and applying the gain are independent per sample again
+    {
+        COMPRESSOR_PROFILE_STAGE(profiler, mix);
+        ParallelSegments::forEach(pool, numSamples, ParallelSegments::defaultSegmentSize, [&](int start, int num)
+        {
+            float* mid = midSignal.data() + start;
+            applyMakeupAndMix(mid, num);
+
+            if (decodeMidSide)
+            {
+                float* side = sideSignal.data() + start;
+                applyMakeupAndMix(side, num);
+
+                float* left = buffer.getWritePointer(0, start);
+                float* right = buffer.getWritePointer(1, start);
+                for (int i = 0; i < num; ++i)
+                {
+                    const float m = 0.5f * (left[i] + right[i]) * mid[i];
+                    const float s = 0.5f * (left[i] - right[i]) * side[i];
+                    left[i] = m + s;
+                    right[i] = m - s;
+                }
+            }
+            else
+            {
+                for (int ch = 0; ch < numChannels; ++ch)
+                    FloatVectorOperations::multiply(buffer.getWritePointer(ch, start), mid, num);
+            }
+        });
+    }
+    return true;
+}
+
+bool Compressor::processParallel(juce::AudioBuffer<float>& buffer, juce::ThreadPool& pool, DetectorCheckpoints* checkpoints)
+{
+    // The pre-roll bound and the checkpoints cover the detectors of one stage
+    jassert(numStages == 1);
+    if (numStages > 1)
+        return false;
+
+    if (bypassed)
+        return true;
+
+    using namespace juce;
+
+    const int numSamples = buffer.getNumSamples();
+    const int numChannels = buffer.getNumChannels();
+
+    if (numSamples == 0)
+        return true;
+
+    COMPRESSOR_PROFILE_BLOCK(profiler);
+
+    const float inputGain = Decibels::decibelsToGain(input);
+    prevInput = input;
+
+    gainComputer.updateTransferCurve();
+    sideGainComputer.updateTransferCurve();
+
+    // Like a fresh compressor, so the pre-roll bound only has to cover this file
+    ballistics.reset();
+    sideBallistics.reset();
+
+    // The peak level sizes the pre-roll, scanned in parallel as well
+    const int numScanSegments = (numSamples + ParallelSegments::defaultSegmentSize - 1) / ParallelSegments::defaultSegmentSize;
+    std::vector<float> peaks(static_cast<size_t>(numScanSegments));
+    {
+        COMPRESSOR_PROFILE_STAGE(profiler, preRoll);
+        ParallelSegments::forEach(pool, numSamples, ParallelSegments::defaultSegmentSize, [&](int start, int num)
+        {
+            float peak = 0.0f;
+            for (int ch = 0; ch < numChannels; ++ch)
+                peak = jmax(peak, buffer.getMagnitude(ch, start, num));
+            peaks[static_cast<size_t>(start / ParallelSegments::defaultSegmentSize)] = peak;
+        });
+    }
+
+    const float peak = *std::max_element(peaks.begin(), peaks.end()) * inputGain;
+    const int preRoll = getParallelPreRoll(Decibels::gainToDecibels(peak, TransferCurve::minLevel));
+
+    // Segments of at least eight pre-rolls keep the warm-up under an eighth of the work
+    const int segmentSize = static_cast<int>(jlimit<int64>(1, numSamples, jmax<int64>(ParallelSegments::defaultSegmentSize, 8 * static_cast<int64>(preRoll))));
+    const size_t numSegments = static_cast<size_t>((numSamples + segmentSize - 1) / segmentSize);
+
+    // Detector of every segment, from rest
+    std::vector<LevelDetector> midDetectors(numSegments, ballistics);
+    std::vector<LevelDetector> sideDetectors(numSegments, sideBallistics);
+    std::vector<float> minima(numSegments, 0.0f);
+
+    if (checkpoints != nullptr)
+        checkpoints->prepare(numSamples);
+
+    // First pass: warm every detector up over the pre-roll before its segment. Only
+    // reads the input, so it cannot race with segments being written in the second pass.
+    {
+        COMPRESSOR_PROFILE_STAGE(profiler, preRoll);
+        ParallelSegments::forEach(pool, numSamples, segmentSize, [&](int start, int)
+        {
+            const size_t segment = static_cast<size_t>(start / segmentSize);
+            runDetectors(buffer, jmax(0, start - preRoll), start, inputGain, midDetectors[segment], sideDetectors[segment]);
+        });
+    }
+
+    // Second pass: every segment from its warmed-up detector, now writing the output
+    {
+        COMPRESSOR_PROFILE_STAGE(profiler, segments);
+        ParallelSegments::forEach(pool, numSamples, segmentSize, [&](int start, int num)
+        {
+            const size_t segment = static_cast<size_t>(start / segmentSize);
+            minima[segment] = renderSegment(buffer, start, num, inputGain, midDetectors[segment], sideDetectors[segment], checkpoints);
+        });
+    }
+
+    // Carry on from the end of the file
+    ballistics = midDetectors.back();
+    sideBallistics = sideDetectors.back();
+    maxGainReduction = *std::min_element(minima.begin(), minima.end());
+    return true;
+}
+
+bool Compressor::processRegion(juce::AudioBuffer<float>& buffer, int start, int numSamples, const DetectorCheckpoints& checkpoints)
+{
+    // Checkpoints hold the detectors of one stage, as processParallel renders
+    jassert(numStages == 1);
+    if (numStages > 1)
+        return false;
+
+    if (bypassed)
+        return true;
+
+    using namespace juce;
+
+    jassert(start >= 0 && numSamples >= 0 && start + numSamples <= buffer.getNumSamples());
+
+    if (numSamples <= 0)
+        return true;
+
+    COMPRESSOR_PROFILE_BLOCK(profiler);
+
+    const float inputGain = Decibels::decibelsToGain(input);
+    prevInput = input;
+
+    gainComputer.updateTransferCurve();
+    sideGainComputer.updateTransferCurve();
+
+    // Without a checkpoint before the region the render started from rest at the top
+    const int from = checkpoints.findNearest(start);
+    if (from >= 0)
+    {
+        ballistics.setState(checkpoints.get(from).mid);
+        sideBallistics.setState(checkpoints.get(from).side);
+    }
+    else
+    {
+        ballistics.reset();
+        sideBallistics.reset();
+    }
+
+    {
+        COMPRESSOR_PROFILE_STAGE(profiler, preRoll);
+        runDetectors(buffer, jmax(0, from), start, inputGain, ballistics, sideBallistics);
+    }
+    {
+        COMPRESSOR_PROFILE_STAGE(profiler, segments);
+        maxGainReduction = renderSegment(buffer, start, numSamples, inputGain, ballistics, sideBallistics, nullptr);
+    }
+    return true;
+}
+
+int Compressor::getParallelPreRoll(float peakLevel) const
+{
+    using namespace juce;
+
+    // Deepest attenuation (or highest boost) at any level the side-chain can see. Between
+    // the 0.25 dB steps the steepest section, a 1:8 expander, moves it by at most 1 dB.
+    float depth = 0.0f;
+    const float maxLevel = jmax(peakLevel, TransferCurve::minLevel);
+    for (float level = TransferCurve::minLevel; level < maxLevel; level += TransferCurve::resolution)
+        depth = jmax(depth, std::abs(gainComputer.applyCompression(level) - level));
+    depth = jmax(depth, std::abs(gainComputer.applyCompression(maxLevel) - maxLevel)) + 1.0f;
+
+    // The branched detector is continuous and piecewise linear in its state, with slopes
+    // of the attack and release coefficients. Two detectors fed the same attenuation thus
+    // close in by at least the larger coefficient per sample, from a distance of at most
+    // the depth, as the state is always an average of rest and past attenuations.
+    const auto coefficients = ballistics.getCoefficients();
+    const double contraction = jmax(coefficients.attackCoefficient, coefficients.releaseCoefficient);
+
+    if (contraction <= 0.0)
+        return 0;
+    if (contraction >= 1.0)
+        return std::numeric_limits<int>::max();
+
+    const double preRoll = std::ceil(std::log(parallelTolerance / depth) / std::log(contraction));
+    return static_cast<int>(jlimit(0.0, static_cast<double>(std::numeric_limits<int>::max()), preRoll));
+}
+
+void Compressor::computeSegmentAttenuation(const juce::AudioBuffer<float>& buffer, int start, int numSamples, float inputGain,
+                                           LevelDetector& midDetector, LevelDetector& sideDetector,
+                                           float* left, float* right, float* mid, float* side) const
+{
+    using namespace juce;
+
+    // The same operations as process, in the same order, so results match to the bit
+    // whenever the detectors do. Linked, |x| * gain is |x * gain| exactly and the
+    // maximum commutes with the rounding, so the gain can come last.
+    if (usesMidSide(buffer.getNumChannels()))
+    {
+        FloatVectorOperations::multiply(left, buffer.getReadPointer(0, start), inputGain, numSamples);
+        FloatVectorOperations::multiply(right, buffer.getReadPointer(1, start), inputGain, numSamples);
+
+        for (int i = 0; i < numSamples; ++i)
+        {
+            mid[i] = std::abs(0.5f * (left[i] + right[i]));
+            side[i] = std::abs(0.5f * (left[i] - right[i]));
+        }
+
+        sideGainComputer.computeAttenuation(side, numSamples);
+        sideDetector.applyBallistics(side, numSamples);
+    }
+    else
+    {
+        fillLinkedSidechain(buffer, start, numSamples, mid);
+        FloatVectorOperations::multiply(mid, inputGain, numSamples);
+    }
+
+    gainComputer.computeAttenuation(mid, numSamples);
+    midDetector.applyBallistics(mid, numSamples);
+}
+
+void Compressor::runDetectors(const juce::AudioBuffer<float>& buffer, int start, int end, float inputGain,
+                              LevelDetector& midDetector, LevelDetector& sideDetector) const
+{
+    std::vector<float> chunk(4 * parallelChunkSize);
+
+    for (int position = start; position < end; position += parallelChunkSize)
+        computeSegmentAttenuation(buffer, position, juce::jmin(parallelChunkSize, end - position), inputGain, midDetector, sideDetector,
+                                  chunk.data(), chunk.data() + parallelChunkSize, chunk.data() + 2 * parallelChunkSize,
+                                  chunk.data() + 3 * parallelChunkSize);
+}
+
+float Compressor::renderSegment(juce::AudioBuffer<float>& buffer, int start, int numSamples, float inputGain,
+                                LevelDetector& midDetector, LevelDetector& sideDetector, DetectorCheckpoints* checkpoints) const
+{
+    using namespace juce;
+
+    const int numChannels = buffer.getNumChannels();
+    std::vector<float> chunk(4 * parallelChunkSize);
+    float* left = chunk.data();
+    float* right = left + parallelChunkSize;
+    float* mid = right + parallelChunkSize;
+    float* side = mid + parallelChunkSize;
+    float minimum = 0.0f;
+    const bool decodeMidSide = usesMidSide(numChannels);
+
+    for (int position = start, count = 0; position < start + numSamples; position += count)
+    {
+        // Chunks end where a checkpoint is due, which then holds the detectors right before its sample
+        count = jmin(parallelChunkSize, start + numSamples - position);
+        if (checkpoints != nullptr)
+        {
+            if (checkpoints->isDue(position))
+                checkpoints->store(position, midDetector.getState(), sideDetector.getState());
+            count = jmin(count, checkpoints->getSamplesToNext(position));
+        }
+
+        computeSegmentAttenuation(buffer, position, count, inputGain, midDetector, sideDetector, left, right, mid, side);
+
+        minimum = jmin(minimum, FloatVectorOperations::findMinimum(mid, count));
+        applyMakeupAndMix(mid, count);
+
+        if (decodeMidSide)
+        {
+            minimum = jmin(minimum, FloatVectorOperations::findMinimum(side, count));
+            applyMakeupAndMix(side, count);
+
+            float* outLeft = buffer.getWritePointer(0, position);
+            float* outRight = buffer.getWritePointer(1, position);
+            for (int i = 0; i < count; ++i)
+            {
+                const float m = 0.5f * (left[i] + right[i]) * mid[i];
+                const float s = 0.5f * (left[i] - right[i]) * side[i];
+                outLeft[i] = m + s;
+                outRight[i] = m - s;
+            }
+        }
+        else
+        {
+            for (int ch = 0; ch < numChannels; ++ch)
+            {
+                float* samples = buffer.getWritePointer(ch, position);
+                FloatVectorOperations::multiply(samples, inputGain, count);
+                FloatVectorOperations::multiply(samples, mid, count);
+            }
+        }
+    }
+
+    return minimum;
+}
+
+void Compressor::smoothForwardBackward(float* attenuation, int numSamples, LevelDetector& detector)
+{
+    if (numSamples == 0)
+        return;
+
+    const double attack = detector.getAttackCoefficient();
+    const double release = detector.getReleaseCoefficient();
+
+    // Forward: the causal branched peak detector, from rest
+    double state = 0.0;
+    for (int i = 0; i < numSamples; ++i)
+    {
+        const double coefficient = attenuation[i] < state ? attack : release;
+        state = coefficient * state + (1.0 - coefficient) * attenuation[i];
+        attenuation[i] = static_cast<float>(state);
+    }
+
+    // Backward with the attack time only: the forward attack lag is mirrored into an
+    // equal lead, and the release tail, already smooth, is barely touched
+    state = attenuation[numSamples - 1];
+    for (int i = numSamples - 1; i >= 0; --i)
+    {
+        state = attack * state + (1.0 - attack) * attenuation[i];
+        attenuation[i] = static_cast<float>(state);
+    }
+}
+
+void Compressor::updateLink()
+{
+    const int requested = requestedLinkGroup.load(std::memory_order_relaxed);
+    if (requested == linkGroup)
+        return;
+
+    if (linkSlot >= 0)
+        detectorBus->leave(linkGroup, linkSlot);
+
+    // A full group leaves this instance on its own detector until the group changes again
+    linkGroup = requested;
+    linkSlot = requested > 0 ? detectorBus->join(requested) : -1;
+
+    if (linkSlot >= 0)
+    {
+        linkAttenuation = detectorBus->getAttenuation(linkGroup);
+        lastLeaderBlock = detectorBus->getLeaderBlock(linkGroup);
+        staleLeaderBlocks = 0;
+    }
+}
+
+Compressor::LinkRole Compressor::shareLinkedDetector(float* sidechainSignal, int numSamples)
+{
+    using namespace juce;
+
+    if (detectorBus->isLeader(linkGroup, linkSlot))
+    {
+        // Every other member's latest envelope joins the side-chain, each point over
+        // its part of the block
+        DetectorBus::Envelope others;
+        if (detectorBus->getEnvelopeOfOthers(linkGroup, linkSlot, others) > 0.0f)
+        {
+            for (int point = 0; point < DetectorBus::numEnvelopePoints; ++point)
+            {
+                const int start = DetectorBus::getPointStart(point, numSamples);
+                const int end = DetectorBus::getPointStart(point + 1, numSamples);
+                const float level = others[static_cast<size_t>(point)];
+                if (end > start && level > 0.0f)
+                    FloatVectorOperations::max(sidechainSignal + start, sidechainSignal + start, level, end - start);
+            }
+        }
+        return LinkRole::leader;
+    }
+
+    detectorBus->publishEnvelope(linkGroup, linkSlot, sidechainSignal, numSamples);
+
+    // A leader that stopped processing leaves the follower on its own detector
+    const auto leaderBlock = detectorBus->getLeaderBlock(linkGroup);
+    staleLeaderBlocks = leaderBlock != lastLeaderBlock ? 0 : staleLeaderBlocks + 1;
+    lastLeaderBlock = leaderBlock;
+    if (static_cast<juce::uint32>(staleLeaderBlocks) > DetectorBus::maxStaleBlocks)
+        return LinkRole::none;
+
+    // Ramp to the leader's latest attenuation over the block
+    const float target = detectorBus->getAttenuation(linkGroup);
+    const float step = (target - linkAttenuation) / static_cast<float>(jmax(1, numSamples));
+    for (int i = 0; i < numSamples; ++i)
+        sidechainSignal[i] = linkAttenuation + step * static_cast<float>(i + 1);
+
+    linkAttenuation = target;
+    return LinkRole::follower;
+}
+
+CompressorPreset::Ptr Compressor::takePendingPreset(bool& crossfade)
+{
+    // Never blocks, if the message thread is just handing one over it is taken next block
+    const juce::SpinLock::ScopedTryLockType sl(presetLock);
+    if (! sl.isLocked() || pendingPreset == nullptr)
+        return nullptr;
+
+    crossfade = pendingCrossfade;
+    CompressorPreset::Ptr preset = pendingPreset;
+    pendingPreset = nullptr;
+    return preset;
+}
+
+void Compressor::applyPreset(const CompressorPreset& preset)
+{
+    // Everything was computed when the preset was built, this only copies
+    gainComputer.setCompressorSection(preset.compressorSection, preset.transferCurve);
+    sideGainComputer.setCompressorSection(preset.compressorSection, preset.transferCurve);
+    ballistics.setCoefficients(preset.ballistics);
+    sideBallistics.setCoefficients(preset.ballistics);
+
+    makeup = preset.settings.makeup;
+    mix = preset.settings.mix;
+}
+
+void Compressor::processGain(juce::AudioBuffer<float>& buffer, float* sidechainSignal, float* sideSignal)
+{
+    const bool decodeMidSide = usesMidSide(buffer.getNumChannels());
+    if (decodeMidSide)
+    {
+        processMidSide(buffer, sidechainSignal, sideSignal);
+    }
+    else
+    {
+        processLinked(buffer, sidechainSignal);
+    }
+
+    // Both side-chains hold the final linear gains by now
+    if (gainEnvelope != nullptr)
+        gainEnvelope->append(sidechainSignal, decodeMidSide ? sideSignal : nullptr, buffer.getNumSamples());
+}
+
+bool Compressor::usesMidSide(int numChannels) const
+{
+    return midSide && numChannels >= 2;
+}
+
+void Compressor::processLinked(juce::AudioBuffer<float>& buffer, float* sidechainSignal)
+{
+    using namespace juce;
+
+    // Outside a link group at full or approximate quality the block goes through the tuned kernel
+    if (linkSlot < 0 && quality != Quality::decimated)
+    {
+        processTiled(buffer, sidechainSignal);
+        return;
+    }
+
+    const auto numSamples = buffer.getNumSamples();
+    const auto numChannels = buffer.getNumChannels();
+
+    {
+        COMPRESSOR_PROFILE_STAGE(profiler, sidechain);
+        fillLinkedSidechain(buffer, 0, numSamples, sidechainSignal);
+    }
+
+    // Linked with other instances, a follower takes the group's attenuation instead
+    const auto link = linkSlot >= 0 ? shareLinkedDetector(sidechainSignal, numSamples) : LinkRole::none;
+
+    if (link == LinkRole::follower)
+    {
+        COMPRESSOR_PROFILE_STAGE(profiler, gainConversion);
+        maxGainReduction = FloatVectorOperations::findMinimum(sidechainSignal, numSamples);
+        applyMakeupAndMix(sidechainSignal, numSamples, quality != Quality::full);
+    }
+    else if (quality == Quality::decimated)
+    {
+        maxGainReduction = computeDecimatedGain(sidechainSignal, numSamples, false);
+    }
+    else
+    {
+        gainComputer.updateTransferCurve();
+        maxGainReduction = computeLinkedGain(sidechainSignal, numSamples, quality == Quality::approximate);
+    }
+
+    // The detectors end on the attenuation of the last sample, which the followers continue from
+    if (link == LinkRole::leader)
+    {
+        float attenuation = ballistics.getLevel();
+        for (int stage = 0; stage < numStages - 1; ++stage)
+            attenuation += stageBallistics[static_cast<size_t>(stage)].getLevel();
+        detectorBus->publishAttenuation(linkGroup, attenuation);
+    }
+
+    COMPRESSOR_PROFILE_STAGE(profiler, mix);
+
+    // Multiply attenuation with buffer - apply compression, metering the output on the way
+    for (int i = 0; i < numChannels; ++i)
+        outputPeak = jmax(outputPeak, multiplyAndGetPeak(buffer.getWritePointer(i), sidechainSignal, numSamples));
+}
+
+void Compressor::fillLinkedSidechain(const juce::AudioBuffer<float>& buffer, int start, int numSamples, float* sidechainSignal)
+{
+    juce::FloatVectorOperations::abs(sidechainSignal, buffer.getReadPointer(0, start), numSamples);
+
+    for (int ch = 1; ch < buffer.getNumChannels(); ++ch)
+    {
+        const float* samples = buffer.getReadPointer(ch, start);
+        for (int i = 0; i < numSamples; ++i)
+            sidechainSignal[i] = juce::jmax(sidechainSignal[i], std::abs(samples[i]));
+    }
+}
+
+void Compressor::processTiled(juce::AudioBuffer<float>& buffer, float* sidechainSignal)
+{
+    using namespace juce;
+
+    const auto numSamples = buffer.getNumSamples();
+    const auto numChannels = buffer.getNumChannels();
+    const bool approximate = quality == Quality::approximate;
+    const int tileSize = tuning.tileSize > 0 ? tuning.tileSize : numSamples;
+
+    // One curve for the whole block, however it is tiled
+    gainComputer.updateTransferCurve();
+
+    for (int start = 0; start < numSamples; start += tileSize)
+    {
+        const int num = jmin(tileSize, numSamples - start);
+        float* tile = sidechainSignal + start;
+        float minimum;
+
+        if (tuning.kernel == Kernel::fused && numStages == 1)
+        {
+            minimum = approximate
+                ? processFusedTile(buffer, start, num, tile, [](float gain) { return FastDecibels::gainToDecibels(gain); },
+                                   [](float decibels) { return FastDecibels::decibelsToGain(decibels); })
+                : processFusedTile(buffer, start, num, tile, [](float gain) { return Decibels::gainToDecibels(gain); },
+                                   [](float decibels) { return Decibels::decibelsToGain(decibels); });
+        }
+        else
+        {
+            {
+                COMPRESSOR_PROFILE_STAGE(profiler, sidechain);
+                fillLinkedSidechain(buffer, start, num, tile);
+            }
+
+            minimum = computeLinkedGain(tile, num, approximate);
+
+            COMPRESSOR_PROFILE_STAGE(profiler, mix);
+            for (int i = 0; i < numChannels; ++i)
+                outputPeak = jmax(outputPeak, multiplyAndGetPeak(buffer.getWritePointer(i, start), tile, num));
+        }
+
+        maxGainReduction = start == 0 ? minimum : jmin(maxGainReduction, minimum);
+    }
+}
+
+float Compressor::computeLinkedGain(float* sidechainSignal, int numSamples, bool approximate)
+{
+    using namespace juce;
+
+    if (numStages > 1)
+    {
+        computeChainAttenuation(sidechainSignal, numSamples, approximate, false);
+    }
+    else
+    {
+        // Compute attenuation - converts side-chain signal from linear to logarithmic domain
+        {
+            COMPRESSOR_PROFILE_STAGE(profiler, gainComputer);
+            gainComputer.computeAttenuation(sidechainSignal, numSamples, approximate);
+        }
+
+        // Smooth attenuation - still logarithmic
+        {
+            COMPRESSOR_PROFILE_STAGE(profiler, ballistics);
+            ballistics.applyBallistics(sidechainSignal, numSamples);
+        }
+    }
+
+    COMPRESSOR_PROFILE_STAGE(profiler, gainConversion);
+
+    // Get minimum = max. gain reduction from side chain buffer
+    const float minimum = FloatVectorOperations::findMinimum(sidechainSignal, numSamples);
+
+    // Add makeup gain and convert side-chain to linear domain
+    applyMakeupAndMix(sidechainSignal, numSamples, approximate);
+
+    if (numSamples > 0)
+        lastGain = sidechainSignal[numSamples - 1];
+
+    return minimum;
+}
+
+template <typename ToDecibels, typename ToGain>
+float Compressor::processFusedTile(juce::AudioBuffer<float>& buffer, int start, int numSamples, float* sidechainSignal,
+                                   ToDecibels&& toDecibels, ToGain&& toGain)
+{
+    using namespace juce;
+
+    // All of it is one stage here
+    COMPRESSOR_PROFILE_STAGE(profiler, gainComputer);
+
+    const int numChannels = buffer.getNumChannels();
+    float* left = buffer.getWritePointer(0, start);
+    float* right = numChannels > 1 ? buffer.getWritePointer(1, start) : nullptr;
+    const float* const* channels = buffer.getArrayOfReadPointers();
+    const float dry = 1 - mix;
+    float minimum = std::numeric_limits<float>::max();
+    float peak = outputPeak;
+
+    gainComputer.withAttenuation(toDecibels, [&](auto&& attenuationOf)
+    {
+        for (int i = 0; i < numSamples; ++i)
+        {
+            // The side-chain level exactly as fillLinkedSidechain computes it
+            float level = std::abs(left[i]);
+            if (right != nullptr)
+                level = jmax(level, std::abs(right[i]));
+            for (int ch = 2; ch < numChannels; ++ch)
+                level = jmax(level, std::abs(channels[ch][start + i]));
+            const float attenuation = ballistics.processPeakBranched(attenuationOf(level));
+            minimum = jmin(minimum, attenuation);
+
+            // Makeup, then the mix folded into the gain, as applyMakeupAndMix does it
+            float gain = toGain(attenuation + makeup);
+            gain *= mix;
+            gain += dry;
+
+            sidechainSignal[i] = gain;
+            left[i] *= gain;
+            peak = jmax(peak, std::abs(left[i]));
+            if (right != nullptr)
+            {
+                right[i] *= gain;
+                peak = jmax(peak, std::abs(right[i]));
+            }
+        }
+    });
+
+    for (int ch = 2; ch < numChannels; ++ch)
+        peak = jmax(peak, multiplyAndGetPeak(buffer.getWritePointer(ch, start), sidechainSignal, numSamples));
+    outputPeak = peak;
+
+    if (numSamples > 0)
+        lastGain = sidechainSignal[numSamples - 1];
+
+    return minimum;
+}
+
+void Compressor::processMidSide(juce::AudioBuffer<float>& buffer, float* midSignal, float* sideSignal)
+{
+    using namespace juce;
+
+    const auto numSamples = buffer.getNumSamples();
+    float* left = buffer.getWritePointer(0);
+    float* right = buffer.getWritePointer(1);
+
+    // Encode to M/S while filling both side-chains, the encoded signal itself is never stored
+    {
+        COMPRESSOR_PROFILE_STAGE(profiler, sidechain);
+        for (int i = 0; i < numSamples; ++i)
+        {
+            midSignal[i] = std::abs(0.5f * (left[i] + right[i]));
+            sideSignal[i] = std::abs(0.5f * (left[i] - right[i]));
+        }
+    }
+
+    if (quality == Quality::decimated)
+    {
+        maxGainReduction = jmin(computeDecimatedGain(midSignal, numSamples, false),
+                                computeDecimatedGain(sideSignal, numSamples, true));
+    }
+    else
+    {
+        const bool approximate = quality == Quality::approximate;
+
+        if (numStages > 1)
+        {
+            gainComputer.updateTransferCurve();
+            sideGainComputer.updateTransferCurve();
+            computeChainAttenuation(midSignal, numSamples, approximate, false);
+            computeChainAttenuation(sideSignal, numSamples, approximate, true);
+        }
+        else
+        {
+            {
+                COMPRESSOR_PROFILE_STAGE(profiler, gainComputer);
+                gainComputer.applyCompressionToBuffer(midSignal, numSamples, approximate);
+                sideGainComputer.applyCompressionToBuffer(sideSignal, numSamples, approximate);
+            }
+
+            {
+                COMPRESSOR_PROFILE_STAGE(profiler, ballistics);
+                ballistics.applyBallistics(midSignal, numSamples);
+                sideBallistics.applyBallistics(sideSignal, numSamples);
+            }
+        }
+
+        {
+            COMPRESSOR_PROFILE_STAGE(profiler, gainConversion);
+            maxGainReduction = jmin(FloatVectorOperations::findMinimum(midSignal, numSamples),
+                                    FloatVectorOperations::findMinimum(sideSignal, numSamples));
+            applyMakeupAndMix(midSignal, numSamples, approximate);
+            applyMakeupAndMix(sideSignal, numSamples, approximate);
+        }
+
+        if (numSamples > 0)
+        {
+            lastGain = midSignal[numSamples - 1];
+            lastSideGain = sideSignal[numSamples - 1];
+        }
+    }
+
+    COMPRESSOR_PROFILE_STAGE(profiler, mix);
+
+    // Apply both gains and decode back to L/R in the same pass, metering the output
+    float peak = 0.0f;
+    for (int i = 0; i < numSamples; ++i)
+    {
+        const float mid = 0.5f * (left[i] + right[i]) * midSignal[i];
+        const float side = 0.5f * (left[i] - right[i]) * sideSignal[i];
+        left[i] = mid + side;
+        right[i] = mid - side;
+        peak = jmax(peak, std::abs(left[i]), std::abs(right[i]));
+    }
+    outputPeak = peak;
+}
+
+float Compressor::computeDecimatedGain(float* sidechainSignal, int numSamples, bool side)
+{
+    using namespace juce;
+
+    if (numSamples <= 0)
+        return 0.0f;
+
+    auto& computer = side ? sideGainComputer : gainComputer;
+    auto& detector = side ? sideBallistics : ballistics;
+    float& previousGain = side ? lastSideGain : lastGain;
+
+    constexpr int factor = sidechainDecimation;
+    const int numGroups = (numSamples + factor - 1) / factor;
+
+    // Peak of every group of samples, packed in place at the front: group k only
+    // writes index k, which it has read already or which belongs to an earlier group
+    {
+        COMPRESSOR_PROFILE_STAGE(profiler, sidechain);
+        for (int k = 0; k < numGroups; ++k)
+        {
+            const int start = k * factor;
+            const int end = jmin(start + factor, numSamples);
+            float peak = sidechainSignal[start];
+            for (int i = start + 1; i < end; ++i)
+                peak = jmax(peak, sidechainSignal[i]);
+            sidechainSignal[k] = peak;
+        }
+    }
+
+    if (numStages > 1)
+    {
+        computer.updateTransferCurve();
+        computeChainAttenuation(sidechainSignal, numGroups, true, side, factor);
+    }
+    else
+    {
+        {
+            COMPRESSOR_PROFILE_STAGE(profiler, gainComputer);
+            computer.applyCompressionToBuffer(sidechainSignal, numGroups, true);
+        }
+
+        {
+            COMPRESSOR_PROFILE_STAGE(profiler, ballistics);
+            applyBallistics(detector, sidechainSignal, numGroups, factor);
+        }
+    }
+
+    COMPRESSOR_PROFILE_STAGE(profiler, gainConversion);
+
+    const float minimum = FloatVectorOperations::findMinimum(sidechainSignal, numGroups);
+    applyMakeupAndMix(sidechainSignal, numGroups, true);
+
+    // Interpolate the linear gain back to full rate, each group ending on its own value.
+    // Backwards, so a group never overwrites a value that is still to be read.
+    for (int k = numGroups - 1; k >= 0; --k)
+    {
+        const float to = sidechainSignal[k];
+        const float from = k > 0 ? sidechainSignal[k - 1] : (previousGain >= 0.0f ? previousGain : to);
+        const int start = k * factor;
+        const int length = jmin(factor, numSamples - start);
+        const float step = (to - from) / static_cast<float>(length);
+
+        for (int j = length - 1; j >= 0; --j)
+            sidechainSignal[start + j] = from + step * static_cast<float>(j + 1);
+    }
+
+    previousGain = sidechainSignal[numSamples - 1];
+    return minimum;
+}
+
+void Compressor::computeChainAttenuation(float* sidechainSignal, int numSamples, bool approximate, bool side, int decimation)
+{
+    using namespace juce;
+
+    ScratchArena::Scope scratchScope(*scratch);
+    float* levels = scratchScope.allocate(static_cast<size_t>(numSamples));
+    float* stageAttenuation = scratchScope.allocate(static_cast<size_t>(numSamples));
+
+    // Out of scratch memory the chain takes nothing off this block
+    if (levels == nullptr || stageAttenuation == nullptr)
+    {
+        FloatVectorOperations::clear(sidechainSignal, numSamples);
+        return;
+    }
+
+    {
+        COMPRESSOR_PROFILE_STAGE(profiler, gainComputer);
+
+        // The side-chain in dB once, as every stage's curve takes it
+        if (approximate)
+        {
+            for (int i = 0; i < numSamples; ++i)
+                levels[i] = FastDecibels::gainToDecibels(jmax(std::abs(sidechainSignal[i]), 1e-6f));
+        }
+        else
+        {
+            for (int i = 0; i < numSamples; ++i)
+                levels[i] = Decibels::gainToDecibels(jmax(std::abs(sidechainSignal[i]), 1e-6f));
+        }
+
+        (side ? sideGainComputer : gainComputer).computeAttenuationInDecibels(levels, sidechainSignal, numSamples);
+    }
+
+    {
+        COMPRESSOR_PROFILE_STAGE(profiler, ballistics);
+        applyBallistics(side ? sideBallistics : ballistics, sidechainSignal, numSamples, decimation);
+    }
+
+    // A stage in series sees the level its input had, plus everything the stages before
+    // it took away and their makeup
+    float makeupBefore = makeup;
+    for (size_t stage = 0; stage < static_cast<size_t>(numStages - 1); ++stage)
+    {
+        {
+            COMPRESSOR_PROFILE_STAGE(profiler, gainComputer);
+            for (int i = 0; i < numSamples; ++i)
+                stageAttenuation[i] = levels[i] + sidechainSignal[i] + makeupBefore;
+
+            (side ? stageSideGainComputers : stageGainComputers)[stage].computeAttenuationInDecibels(stageAttenuation, stageAttenuation, numSamples);
+        }
+
+        {
+            COMPRESSOR_PROFILE_STAGE(profiler, ballistics);
+            applyBallistics((side ? stageSideBallistics : stageBallistics)[stage], stageAttenuation, numSamples, decimation);
+            FloatVectorOperations::add(sidechainSignal, stageAttenuation, numSamples);
+        }
+
+        makeupBefore += stageMakeups[stage];
+    }
+}
+
+void Compressor::applyBallistics(LevelDetector& detector, float* attenuation, int numSamples, int decimation)
+{
+    if (decimation <= 1)
+    {
+        detector.applyBallistics(attenuation, numSamples);
+        return;
+    }
+
+    // One step of the detector at the lower rate is decimation steps at the full rate
+    const auto coefficients = detector.getCoefficients();
+    auto decimated = coefficients;
+    for (int i = 1; i < decimation; ++i)
+    {
+        decimated.attackCoefficient *= coefficients.attackCoefficient;
+        decimated.releaseCoefficient *= coefficients.releaseCoefficient;
+    }
+
+    detector.setCoefficients(decimated);
+    detector.applyBallistics(attenuation, numSamples);
+    detector.setCoefficients(coefficients);
+}
+
+float Compressor::getChainMakeup() const
+{
+    float chainMakeup = makeup;
+    for (int stage = 0; stage < numStages - 1; ++stage)
+        chainMakeup += stageMakeups[static_cast<size_t>(stage)];
+    return chainMakeup;
+}
+
+void Compressor::applyMakeupAndMix(float* sidechainSignal, int numSamples, bool approximate) const
+{
+    using namespace juce;
+
+    // Add makeup gain and convert side-chain to linear domain
+    const float chainMakeup = getChainMakeup();
+    if (approximate)
+    {
+        for (int i = 0; i < numSamples; ++i)
+            sidechainSignal[i] = FastDecibels::decibelsToGain(sidechainSignal[i] + chainMakeup);
+    }
+    else
+    {
+        for (int i = 0; i < numSamples; ++i)
+            sidechainSignal[i] = Decibels::decibelsToGain(sidechainSignal[i] + chainMakeup);
+    }
+
+    // Mix dry & wet signal - wet * mix + dry * (1 - mix) is dry * (gain * mix + 1 - mix),
+    // so the mix is folded into the gain and the dry signal never needs a copy
+    FloatVectorOperations::multiply(sidechainSignal, mix, numSamples);
+    FloatVectorOperations::add(sidechainSignal, 1 - mix, numSamples);
+}
+
+inline void Compressor::applyInputGain(juce::AudioBuffer<float>& buffer, int numSamples)
+{
+    // The input meter reads each sample before the gain, in the pass that applies it
+    const float startGain = juce::Decibels::decibelsToGain(prevInput);
+    const float endGain = juce::Decibels::decibelsToGain(input);
+    prevInput = input;
+
+    inputPeak = 0.0f;
+    if (numSamples > 0)
+        for (int ch = 0; ch < buffer.getNumChannels(); ++ch)
+            inputPeak = juce::jmax(inputPeak, getPeakAndApplyGainRamp(buffer.getWritePointer(ch), numSamples, startGain, endGain));
 }
\ No newline at end of file
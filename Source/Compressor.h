@@ -9,9 +9,20 @@
 */
 
 #pragma once
+#include <array>
+#include <atomic>
+#include <vector>
+#include "CompressorPreset.h"
+#include "DetectorBus.h"
+#include "DetectorCheckpoints.h"
 #include "LevelDetector.h"
 #include "GainComputer.h"
-#include "../JuceLibraryCode/JuceHeader.h"
+#include "GainEnvelope.h"
+#include "ParallelSegments.h"
+#include "ProcessProfiler.h"
+#include "ScratchArena.h"
+#include "TruePeakLimiter.h"
+#include <JuceHeader.h>
 
 class Compressor
 {
@@ -29,6 +40,17 @@ public:
 
     void setKnee(float);
 
+    void setTransferCurve(TransferCurve::Ptr);
+
+    // Further sections of the static curve, see GainComputer
+    void setGate(float threshold, float range);
+
+    void setExpander(float threshold, float ratio);
+
+    void setUpward(float threshold, float ratio, float maxBoost);
+
+    void setLimiter(float threshold);
+
     // Ballistics setters
     void setAttack(float);
 
@@ -43,31 +65,353 @@ public:
 
     void setMix(float);
 
+    // Compress mid and side with independent detectors instead of linked L/R. A block
+    // of fewer than two channels has no mid and side and is compressed linked instead.
+    void setMidSide(bool);
+
+    // Serial chain of up to maxStages compressors in one, e.g. a fast peak stage into a
+    // slow levelling stage. Stage 0 is the one the setters above configure; every stage
+    // after it detects on what the stage before it puts out, with its own static curve
+    // and ballistics, linked or per mid and side like stage 0. Their attenuations add up
+    // in dB, so the block is still read, gained and written once, and input gain, mix
+    // and the ceiling apply once to the whole chain. process and processInterleaved run
+    // every stage at every quality; followers of a link group follow the leader's chain.
+    // processOffline, processParallel and processRegion take a single stage only, see there.
+    static constexpr int maxStages = 4;
+
+    struct StageSettings
+    {
+        float threshold{ 0.0f };
+        float ratio{ 1.0f };
+        float knee{ 0.0f };
+        float attack{ 10.0f };      // ms
+        float release{ 140.0f };    // ms
+        float makeup{ 0.0f };
+    };
+
+    // 1 to maxStages, 1 is the plain compressor. Set between blocks from the thread that
+    // calls process; a stage switched in starts from rest.
+    void setNumStages(int);
+
+    int getNumStages() const;
+
+    // Settings of stage 1 to maxStages - 1, whether it is in the chain or not
+    void setStage(int index, const StageSettings&);
+
+    // True peak ceiling setters
+    void setTruePeak(bool);
+
+    void setCeiling(float);
+
+    // Cost against accuracy of process, stepped by the plugin under CPU load, see
+    // QualityGovernor. approximate converts between gain and dB with FastDecibels,
+    // within 0.01 dB. decimated also runs the static curve, the ballistics and the gain
+    // conversion on the side-chain peak of every sidechainDecimation samples and
+    // interpolates the gain back. Set from the audio thread between blocks; the offline,
+    // parallel and interleaved paths always run at full quality.
+    enum class Quality
+    {
+        full = 0,
+        approximate,
+        decimated
+    };
+
+    static constexpr int numQualities = 3;
+    static constexpr int sidechainDecimation = 4;
+
+    void setQuality(Quality);
+
+    Quality getQuality() const;
+
+    // How process works through a block of the linked path, never what it renders.
+    // tileSize splits the block into tiles of at most that many samples, so the
+    // side-chain stays in cache between its passes, 0 takes the whole block. fused runs
+    // the static curve, ballistics, gain conversion and gain of a sample in one loop
+    // instead of a pass each, for a single stage; a chain always takes multiPass. Only
+    // processLinked outside a link group at full or approximate quality is tiled; the
+    // profiler adds up a stage's tiles and counts them as one block.
+    enum class Kernel
+    {
+        multiPass = 0,
+        fused
+    };
+
+    struct Tuning
+    {
+        int tileSize{ 0 };
+        Kernel kernel{ Kernel::multiPass };
+
+        bool operator==(const Tuning& other) const { return tileSize == other.tileSize && kernel == other.kernel; }
+        bool operator!=(const Tuning& other) const { return ! operator==(other); }
+    };
+
+    // Fixes the tuning, e.g. to reproduce a measurement, and turns auto tuning off.
+    // Call from the thread that prepares, not while processing.
+    void setTuning(const Tuning&);
+
+    Tuning getTuning() const;
+
+    // Lets prepare pick the fastest tuning for its spec with AutoTuner. Off by default.
+    void setAutoTune(bool);
+
+    bool isAutoTuned() const;
+
+    // Shares one detector with every other Compressor in the process linked to the same
+    // group of the DetectorBus, 1 to DetectorBus::numGroups, 0 unlinks. The leader's
+    // static curve and ballistics then apply to the whole group, the others follow its
+    // attenuation one block later with their own makeup and mix. Only the linked stereo
+    // path of process takes part; mid/side keeps its own detectors. DetectorBus says how
+    // closely the leader tracks the others' levels. Safe from any thread, taken over at
+    // the start of the next block.
+    void setLinkGroup(int);
+
+    // Group this instance is a member of, 0 while unlinked or the group is full
+    int getLinkGroup() const;
+
+    bool isLinkLeader() const;
+
+    // Records the gain of every block process and processInterleaved render into the
+    // envelope until it is full, nullptr stops. Set between blocks from the thread that
+    // calls process; the caller keeps the envelope alive. A crossfaded preset switch is
+    // recorded with the incoming settings.
+    void setGainEnvelope(GainEnvelope*);
+
+    // Channels a block can be copied for in the scratch arena, for crossfades and interleaved I/O
+    static constexpr int maxCopiedChannels = 8;
+
+    // Hands over a preset from the message thread. It is switched in as a whole at
+    // the start of the next block; with crossfade that block is rendered with the
+    // old and the new settings and faded across, for blocks of up to maxCopiedChannels
+    // channels. Wider blocks switch at once. The caller keeps the preset alive.
+    void setPreset(CompressorPreset::Ptr, bool crossfade);
+
     // Getters
     float getMakeup();
 
     double getSampleRate();
 
-    float getMaxGainReduction();
+    float getMaxGainReduction() const;
+
+    // Peaks of the last block over all channels, linear, for the meters: the input before
+    // the input gain and the output as it leaves. process measures them on the block while
+    // it has it in cache, processInterleaved on its own passes; 0 before the first block.
+    float getInputPeak() const;
+    float getOutputPeak() const;
+
+    // Delay added by the true peak ceiling, 0 while it is off
+    int getLatencyInSamples() const;
+
+#if COMPRESSOR_PROFILING
+    // Stage timings of process and of the offline renders, safe to read from any thread
+    ProcessProfiler& getProfiler();
+#endif
 
+    // Blocks longer than prepare's maximumBlockSize are processed in parts that fit
+    // the scratch memory it reserved. A block that gets no scratch memory at all
+    // passes through untouched, metered as if bypassed.
     void process(juce::AudioBuffer<float>& buffer);
+
+    // Processes interleaved PCM in place, numChannels samples per frame, in parts of at
+    // most maximumBlockSize frames like process. The linked compressor runs as one fused pass reading
+    // and writing the interleaved data directly; mid/side and the true peak ceiling
+    // go through a planar copy in the scratch arena, for up to maxCopiedChannels
+    // channels. Wider blocks are compressed linked, without either. Presets switch
+    // without a crossfade here. int16 is scaled by 1/32768 and saturates on the way back.
+    void processInterleaved(float* samples, int numChannels, int numFrames);
+    void processInterleaved(juce::int16* samples, int numChannels, int numFrames);
+
+    // Non-causal processing of a whole file, for offline mastering. The static curve
+    // is computed for the entire file in parallel segments on the pool, then smoothed
+    // forward with the usual ballistics and backward with the attack time, so gain
+    // reduction leads transients instead of lagging them. The true peak ceiling is
+    // not applied. Allocates, never call it from the audio thread.
+    // A chain of more than one stage asserts and returns false, leaving the buffer
+    // as it was: the later stages' ballistics depend on the earlier stages' smoothed
+    // gain, which this smoothing doesn't model.
+    bool processOffline(juce::AudioBuffer<float>& buffer, juce::ThreadPool& pool);
+
+    // Causal processing of a whole file in parallel segments on the pool, for offline
+    // rendering of long files. Same result as process with a constant input gain, up to
+    // a detector error of at most parallelTolerance dB: every segment warms up its own
+    // detector over a pre-roll long enough for any state difference to decay below it.
+    // The detectors continue from the end of the file. The true peak ceiling is not
+    // applied. Allocates, never call it from the audio thread. With checkpoints, stores
+    // the detector states at every multiple of their interval for processRegion.
+    // A chain of more than one stage asserts and returns false, leaving the buffer as it
+    // was: the pre-roll and the checkpoints only cover the detectors of stage 0.
+    bool processParallel(juce::AudioBuffer<float>& buffer, juce::ThreadPool& pool, DetectorCheckpoints* checkpoints = nullptr);
+
+    // Renders numSamples from start of a file again as processParallel rendered it, from
+    // the nearest of its checkpoints at or before start: the detectors run over at most
+    // one interval of pre-roll instead of everything before the region. buffer holds the
+    // unprocessed file, read from that checkpoint on; only the region is written. With
+    // the settings and the audio before the region unchanged since the render, the
+    // region matches it to the bit up to the next boundary of processParallel's
+    // segments, and within parallelTolerance after it. Allocates. Like processParallel,
+    // asserts and returns false without writing for a chain of more than one stage.
+    bool processRegion(juce::AudioBuffer<float>& buffer, int start, int numSamples, const DetectorCheckpoints& checkpoints);
+
+    // Bound on the gain error of processParallel against process, in dB
+    static constexpr float parallelTolerance = 1.0e-5f;
+
+    // Samples of pre-roll processParallel needs for this peak input level in dB
+    int getParallelPreRoll(float peakLevel) const;
+
 private:
+    // Ramps the input gain over the block, taking inputPeak in the same pass
     inline void applyInputGain(juce::AudioBuffer<float>&, int);
 
+    // Takes over a preset handed to setPreset, returns nullptr if there is none
+    CompressorPreset::Ptr takePendingPreset(bool& crossfade);
+
+    // Everything of a preset but the input gain, which process ramps
+    void applyPreset(const CompressorPreset&);
+
+    // Everything between the input gain and the ceiling, linked or mid/side
+    void processGain(juce::AudioBuffer<float>&, float* sidechainSignal, float* sideSignal);
+
+    // Whether a block of that many channels is compressed mid/side, which needs a stereo pair
+    bool usesMidSide(int numChannels) const;
+
+    enum class LinkRole
+    {
+        none,
+        leader,
+        follower
+    };
+
+    // Joins or leaves a detector group as setLinkGroup asked
+    void updateLink();
+
+    // Shares the block's side-chain with the group. The leader's side-chain takes the
+    // other members' envelopes on top; a follower's is replaced by the group attenuation in dB.
+    LinkRole shareLinkedDetector(float* sidechainSignal, int numSamples);
+
+    // The linked side-chain: max |x| over every channel of the block, so |L| and |R| in
+    // stereo. Every linked path detects on exactly this, processInterleaved frame by frame.
+    static void fillLinkedSidechain(const juce::AudioBuffer<float>&, int start, int numSamples, float* sidechainSignal);
+
+    // Side-chain, gain and mix for linked channels, detecting on fillLinkedSidechain.
+    // This and the other gain paths raise outputPeak in the loop that applies the gain.
+    void processLinked(juce::AudioBuffer<float>&, float* sidechainSignal);
+
+    // processLinked outside a link group at full or approximate quality, tile by tile as tuned
+    void processTiled(juce::AudioBuffer<float>&, float* sidechainSignal);
+
+    // Static curve, ballistics and gain conversion of processLinked as a pass each, in
+    // place on the side-chain. Returns the deepest attenuation.
+    float computeLinkedGain(float* sidechainSignal, int numSamples, bool approximate);
+
+    // Kernel::fused: one loop over a tile from the samples to the gained samples. Does
+    // what the side-chain pass, computeLinkedGain and the gain multiply do, in the same
+    // order per sample, and leaves the gain in sidechainSignal.
+    template <typename ToDecibels, typename ToGain>
+    float processFusedTile(juce::AudioBuffer<float>&, int start, int numSamples, float* sidechainSignal,
+                           ToDecibels&&, ToGain&&);
+
+    // Same for mid/side, with the M/S matrix fused into the first and last pass
+    void processMidSide(juce::AudioBuffer<float>&, float* midSignal, float* sideSignal);
+
+    template <typename Sample>
+    void processInterleavedSamples(Sample* samples, int numChannels, int numFrames);
+
+    // Side-chain, static curve and ballistics of a stretch of processParallel. Reads only;
+    // leaves the attenuation in mid/side and, for mid/side, the input with gain in left/right.
+    void computeSegmentAttenuation(const juce::AudioBuffer<float>&, int start, int numSamples, float inputGain,
+                                   LevelDetector& midDetector, LevelDetector& sideDetector,
+                                   float* left, float* right, float* mid, float* side) const;
+
+    // The detectors of processParallel over samples start to end, reading only
+    void runDetectors(const juce::AudioBuffer<float>&, int start, int end, float inputGain,
+                      LevelDetector& midDetector, LevelDetector& sideDetector) const;
+
+    // A stretch of processParallel in place, storing the checkpoints due in it if there
+    // are any. Returns the deepest attenuation.
+    float renderSegment(juce::AudioBuffer<float>&, int start, int numSamples, float inputGain,
+                        LevelDetector& midDetector, LevelDetector& sideDetector, DetectorCheckpoints*) const;
+
+    static constexpr int parallelChunkSize = 4096;
+
+    // Zero-phase smoothing of a whole attenuation curve for processOffline
+    static void smoothForwardBackward(float* attenuation, int numSamples, LevelDetector&);
+
+    // Static curve, ballistics and gain conversion of Quality::decimated, in place on a
+    // full-rate side-chain, of the side channel or the linked/mid one. Returns the
+    // deepest attenuation; lastGain or lastSideGain carries the interpolation across blocks.
+    float computeDecimatedGain(float* sidechainSignal, int numSamples, bool side);
+
+    // Static curves and ballistics of every stage of the chain, in place on a side-chain:
+    // linear levels in, the summed attenuation in dB out, without makeup. decimation is
+    // the number of full-rate samples one side-chain sample stands for.
+    void computeChainAttenuation(float* sidechainSignal, int numSamples, bool approximate, bool side, int decimation = 1);
+
+    // Ballistics of a side-chain at 1 / decimation of the sample rate
+    static void applyBallistics(LevelDetector&, float* attenuation, int numSamples, int decimation);
+
+    // Makeup of the whole chain
+    float getChainMakeup() const;
+
+    // Converts attenuation in dB into the final linear gain including makeup and mix
+    void applyMakeupAndMix(float* sidechainSignal, int numSamples, bool approximate = false) const;
+
     //Directly initialize process spec to avoid debugging problems
     juce::dsp::ProcessSpec procSpec{-1, 0, 0};
 
-    juce::AudioBuffer<float> originalSignal;
-    std::vector<float> sidechainSignal;
-    float* rawSidechainSignal{ nullptr };
+    // Block buffers (side-chains and the copies of crossfades and interleaved blocks) are borrowed from here
+    juce::SharedResourcePointer<ScratchArena> scratch;
 
     LevelDetector ballistics;
     GainComputer gainComputer;
 
+    // Second path for the side channel in M/S mode
+    LevelDetector sideBallistics;
+    GainComputer sideGainComputer;
+
+    // Stages 1 to maxStages - 1 of the chain, the side ones for M/S mode
+    std::array<GainComputer, maxStages - 1> stageGainComputers, stageSideGainComputers;
+    std::array<LevelDetector, maxStages - 1> stageBallistics, stageSideBallistics;
+    std::array<float, maxStages - 1> stageMakeups{};
+    int numStages{ 1 };
+
+    TruePeakLimiter truePeakLimiter;
+
+    GainEnvelope* gainEnvelope{ nullptr };
+
+    juce::SharedResourcePointer<DetectorBus> detectorBus;
+    std::atomic<int> requestedLinkGroup{ 0 };
+    int linkGroup{ 0 };
+    int linkSlot{ -1 };
+    float linkAttenuation{ 0.0f };
+    juce::uint32 lastLeaderBlock{ 0 };
+    int staleLeaderBlocks{ 0 };
+
+    CompressorPreset::Ptr pendingPreset;
+    bool pendingCrossfade{ false };
+    juce::SpinLock presetLock;
+
+
     float input{ 0.0f };
     float prevInput{ 0.0f };
     float makeup{ 0.0f };
     bool bypassed{ false };
     float mix{ 1.0f };
+    bool midSide{ false };
     float maxGainReduction{ 0.0f };
+    // Max |x| of the last block as it came in and as it left, taken in the passes over it
+    float inputPeak{ 0.0f };
+    float outputPeak{ 0.0f };
+    bool truePeak{ false };
+    bool truePeakActive{ false };
+    Quality quality{ Quality::full };
+    Tuning tuning;
+    bool autoTune{ false };
+
+    // Last linear gain of the previous block, where decimated interpolation starts.
+    // Negative before the first block, a gain never is.
+    float lastGain{ -1.0f };
+    float lastSideGain{ -1.0f };
+
+#if COMPRESSOR_PROFILING
+    ProcessProfiler profiler;
+#endif
 };
\ No newline at end of file
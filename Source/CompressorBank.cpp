@@ -0,0 +1,220 @@
+/*
+  ==============================================================================
+
+    CompressorBank.cpp
+    Created: 21 Oct 2026 9:13:02am
+    Author:  Linus
+
+  ==============================================================================
+*/
+
+#include "CompressorBank.h"
+#include <cmath>
+
+namespace
+{
+    using Lane = CompressorBank::Lane;
+
+    void setLane(std::vector<Lane>& lanes, int channel, float value)
+    {
+        lanes[static_cast<size_t>(channel / CompressorBank::laneWidth)].set(static_cast<size_t>(channel % CompressorBank::laneWidth), value);
+    }
+
+    float getLane(const std::vector<Lane>& lanes, int channel)
+    {
+        return lanes[static_cast<size_t>(channel / CompressorBank::laneWidth)].get(static_cast<size_t>(channel % CompressorBank::laneWidth));
+    }
+}
+
+void CompressorBank::prepare(const juce::dsp::ProcessSpec& spec)
+{
+    procSpec = spec;
+
+    const int previousNumChannels = numChannels;
+    numChannels = static_cast<int>(spec.numChannels);
+
+    // Pad to whole registers, unused lanes just compress silence
+    const size_t numGroups = static_cast<size_t>((numChannels + laneWidth - 1) / laneWidth);
+    for (auto* lanes : { &threshold, &slope, &kneeWidth, &inverseKnee, &makeup,
+                         &attackCoefficient, &releaseCoefficient, &state, &gainReduction })
+        lanes->resize(numGroups, Lane::expand(0.0f));
+
+    attackTimes.resize(static_cast<size_t>(numChannels));
+    releaseTimes.resize(static_cast<size_t>(numChannels));
+
+    for (int channel = previousNumChannels; channel < numChannels; ++channel)
+        setDefaults(channel);
+
+    for (int channel = 0; channel < numChannels; ++channel)
+    {
+        setLane(attackCoefficient, channel, calculateCoefficient(attackTimes[static_cast<size_t>(channel)]));
+        setLane(releaseCoefficient, channel, calculateCoefficient(releaseTimes[static_cast<size_t>(channel)]));
+    }
+
+    // Levels of all channels in a group are transposed into one scratch block
+    scratch->reserve(ScratchArena::getAlignedSize(static_cast<size_t>(spec.maximumBlockSize * laneWidth)));
+
+    reset();
+}
+
+void CompressorBank::reset()
+{
+    std::fill(state.begin(), state.end(), Lane::expand(0.0f));
+    std::fill(gainReduction.begin(), gainReduction.end(), Lane::expand(0.0f));
+}
+
+int CompressorBank::getNumChannels() const
+{
+    return numChannels;
+}
+
+void CompressorBank::setDefaults(int channel)
+{
+    // Same defaults as GainComputer and LevelDetector
+    setThreshold(channel, -20.0f);
+    setRatio(channel, 2.0f);
+    setKnee(channel, 6.0f);
+    setMakeup(channel, 0.0f);
+    attackTimes[static_cast<size_t>(channel)] = 0.01f;
+    releaseTimes[static_cast<size_t>(channel)] = 0.14f;
+}
+
+void CompressorBank::setThreshold(int channel, float newThreshold)
+{
+    jassert(juce::isPositiveAndBelow(channel, numChannels));
+    setLane(threshold, channel, newThreshold);
+}
+
+void CompressorBank::setRatio(int channel, float ratio)
+{
+    jassert(juce::isPositiveAndBelow(channel, numChannels));
+
+    // Above 23.9:1 it becomes a limiter, as in GainComputer
+    setLane(slope, channel, ratio > 23.9f ? -1.0f : 1.0f / ratio - 1.0f);
+}
+
+void CompressorBank::setKnee(int channel, float knee)
+{
+    jassert(juce::isPositiveAndBelow(channel, numChannels));
+    setLane(kneeWidth, channel, knee / 2.0f);
+    setLane(inverseKnee, channel, knee > 0.0f ? 1.0f / (2.0f * knee) : 0.0f);
+}
+
+void CompressorBank::setAttack(int channel, float attack)
+{
+    jassert(juce::isPositiveAndBelow(channel, numChannels));
+    attackTimes[static_cast<size_t>(channel)] = attack * 0.001f;
+    setLane(attackCoefficient, channel, calculateCoefficient(attack * 0.001f));
+}
+
+void CompressorBank::setRelease(int channel, float release)
+{
+    jassert(juce::isPositiveAndBelow(channel, numChannels));
+    releaseTimes[static_cast<size_t>(channel)] = release * 0.001f;
+    setLane(releaseCoefficient, channel, calculateCoefficient(release * 0.001f));
+}
+
+void CompressorBank::setMakeup(int channel, float newMakeup)
+{
+    jassert(juce::isPositiveAndBelow(channel, numChannels));
+    setLane(makeup, channel, newMakeup);
+}
+
+float CompressorBank::getGainReduction(int channel) const
+{
+    jassert(juce::isPositiveAndBelow(channel, numChannels));
+    return getLane(gainReduction, channel);
+}
+
+float CompressorBank::calculateCoefficient(float timeInSeconds) const
+{
+    if (procSpec.sampleRate <= 0.0)
+        return 0.0f;
+
+    return static_cast<float>(std::exp(-1.0 / (timeInSeconds * procSpec.sampleRate)));
+}
+
+void CompressorBank::process(juce::AudioBuffer<float>& buffer)
+{
+    using namespace juce;
+
+    const int numSamples = buffer.getNumSamples();
+
+    jassert(buffer.getNumChannels() == numChannels);
+    jassert(numSamples <= static_cast<int>(procSpec.maximumBlockSize));
+
+    ScratchArena::Scope scratchScope(*scratch);
+
+    // One register of levels per sample: levels[i * laneWidth + k] is sample i of channel k of the group
+    float* levels = scratchScope.allocate(static_cast<size_t>(numSamples * laneWidth));
+
+    // Without room in the scratch arena the block stays as it is
+    if (levels == nullptr)
+        return;
+
+    for (size_t group = 0; group < state.size(); ++group)
+    {
+        const int firstChannel = static_cast<int>(group) * laneWidth;
+        const int numInGroup = jmin(laneWidth, numChannels - firstChannel);
+
+        // Side-chain levels in dB, transposed so the channels of the group sit side by side
+        for (int k = 0; k < laneWidth; ++k)
+        {
+            if (k < numInGroup)
+            {
+                const float* samples = buffer.getReadPointer(firstChannel + k);
+                for (int i = 0; i < numSamples; ++i)
+                    levels[i * laneWidth + k] = Decibels::gainToDecibels(jmax(std::abs(samples[i]), 1e-6f));
+            }
+            else
+            {
+                for (int i = 0; i < numSamples; ++i)
+                    levels[i * laneWidth + k] = -120.0f;
+            }
+        }
+
+        const Lane groupThreshold = threshold[group];
+        const Lane groupSlope = slope[group];
+        const Lane groupKneeWidth = kneeWidth[group];
+        const Lane groupInverseKnee = inverseKnee[group];
+        const Lane groupMakeup = makeup[group];
+        const Lane attack = attackCoefficient[group];
+        const Lane release = releaseCoefficient[group];
+        const Lane zero = Lane::expand(0.0f);
+
+        Lane groupState = state[group];
+        Lane minimum = zero;
+
+        for (int i = 0; i < numSamples; ++i)
+        {
+            float* frame = levels + i * laneWidth;
+            const Lane level = Lane::fromRawArray(frame);
+
+            // Soft knee attenuation without branches: the knee term is zero below the knee
+            // and for a hard knee, above the knee the straight line takes over
+            const Lane overshoot = level - groupThreshold;
+            const Lane kneeOffset = Lane::max(overshoot + groupKneeWidth, zero);
+            const Lane soft = groupSlope * kneeOffset * kneeOffset * groupInverseKnee;
+            const Lane full = groupSlope * overshoot;
+            const Lane attenuation = soft + ((full - soft) & Lane::greaterThan(overshoot, groupKneeWidth));
+
+            // Branched peak detector, attack while the attenuation deepens
+            const Lane coefficient = release + ((attack - release) & Lane::lessThan(attenuation, groupState));
+            groupState = attenuation + coefficient * (groupState - attenuation);
+
+            minimum = Lane::min(minimum, groupState);
+            (groupState + groupMakeup).copyToRawArray(frame);
+        }
+
+        state[group] = groupState;
+        gainReduction[group] = minimum;
+
+        // Back to linear gain, one channel at a time
+        for (int k = 0; k < numInGroup; ++k)
+        {
+            float* samples = buffer.getWritePointer(firstChannel + k);
+            for (int i = 0; i < numSamples; ++i)
+                samples[i] *= Decibels::decibelsToGain(levels[i * laneWidth + k]);
+        }
+    }
+}
@@ -0,0 +1,67 @@
+/*
+  ==============================================================================
+
+    CompressorBank.h
+    Created: 21 Oct 2026 9:12:40am
+    Author:  Linus
+
+  ==============================================================================
+*/
+
+#pragma once
+#include <vector>
+#include "ScratchArena.h"
+#include <JuceHeader.h>
+
+// Many independent mono compressors in one object, for consoles with dozens of
+// channels. Parameters, coefficients and detector states are stored as structure
+// of arrays, one SIMD register per group of channels, so gain computation and
+// ballistics advance a whole register of channels per instruction instead of
+// running one scalar Compressor per channel.
+class CompressorBank
+{
+public:
+    using Lane = juce::dsp::SIMDRegister<float>;
+    static constexpr int laneWidth = static_cast<int>(Lane::SIMDNumElements);
+
+    CompressorBank() = default;
+
+    // One compressor per channel of the spec, parameters survive a re-prepare
+    void prepare(const juce::dsp::ProcessSpec& spec);
+    void reset();
+
+    int getNumChannels() const;
+
+    // Per channel setters, same units as Compressor
+    void setThreshold(int channel, float);
+    void setRatio(int channel, float);
+    void setKnee(int channel, float);
+    void setAttack(int channel, float);
+    void setRelease(int channel, float);
+    void setMakeup(int channel, float);
+
+    // Largest gain reduction of the channel in the last block, in dB
+    float getGainReduction(int channel) const;
+
+    void process(juce::AudioBuffer<float>&);
+
+private:
+    void setDefaults(int channel);
+    float calculateCoefficient(float timeInSeconds) const;
+
+    juce::dsp::ProcessSpec procSpec{ -1, 0, 0 };
+    juce::SharedResourcePointer<ScratchArena> scratch;
+    int numChannels{ 0 };
+
+    // Gain computer, slope is 1 / ratio - 1 and the knee term is 1 / (2 * knee) or 0 for a hard knee
+    std::vector<Lane> threshold, slope, kneeWidth, inverseKnee, makeup;
+
+    // Ballistics
+    std::vector<float> attackTimes, releaseTimes;
+    std::vector<Lane> attackCoefficient, releaseCoefficient, state;
+
+    // Meters
+    std::vector<Lane> gainReduction;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(CompressorBank)
+};
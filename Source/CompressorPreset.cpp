@@ -0,0 +1,122 @@
+/*
+  ==============================================================================
+
+    CompressorPreset.cpp
+    Created: 22 Oct 2026 2:33:47pm
+    Author:  Linus
+
+  ==============================================================================
+*/
+
+#include "CompressorPreset.h"
+#include <iterator>
+
+CompressorPreset::CompressorPreset(const Settings& settings, double sampleRate, TransferCurve::Ptr curve)
+    : settings(settings), transferCurve(std::move(curve))
+{
+    // Let the real classes normalise and derive, so a preset always matches the setters
+    GainComputer gainComputer;
+    gainComputer.setThreshold(settings.threshold);
+    gainComputer.setRatio(settings.ratio);
+    gainComputer.setKnee(settings.knee);
+    compressorSection = gainComputer.getCompressorSection();
+
+    LevelDetector detector;
+    detector.prepare(sampleRate);
+    detector.setAttack(settings.attack * 0.001);
+    detector.setRelease(settings.release * 0.001);
+    ballistics = detector.getCoefficients();
+}
+
+//==============================================================================
+namespace
+{
+    struct FactoryProgram
+    {
+        const char* name;
+        CompressorPreset::Settings settings;
+    };
+
+    // Factory programs, the first one is the parameter defaults
+    //                                      input  thresh  ratio  knee  attack  release  makeup  mix
+    const FactoryProgram factoryPrograms[] = {
+        { "Default",          { 0.0f, -10.0f,  2.0f,  6.0f,  2.0f,  140.0f,  0.0f, 1.0f } },
+        { "Gentle Glue",      { 0.0f, -18.0f,  1.5f, 12.0f, 30.0f,  300.0f,  2.0f, 1.0f } },
+        { "Vocal Leveler",    { 0.0f, -24.0f,  3.0f,  8.0f,  5.0f,  120.0f,  6.0f, 1.0f } },
+        { "Drum Bus",         { 0.0f, -16.0f,  4.0f,  4.0f, 10.0f,   80.0f,  4.0f, 1.0f } },
+        { "Parallel Smash",   { 0.0f, -40.0f, 10.0f,  0.0f,  0.5f,   50.0f, 12.0f, 0.35f } },
+        { "Brickwall",        { 0.0f,  -3.0f, 24.0f,  0.0f,  0.0f,   60.0f,  2.0f, 1.0f } },
+    };
+
+    constexpr int numFactoryPrograms = static_cast<int>(std::size(factoryPrograms));
+}
+
+std::vector<CompressorPreset::Ptr> PresetBank::SharedPresets::getPresets(double sampleRate)
+{
+    const juce::ScopedLock sl(lock);
+
+    auto& built = presetsBySampleRate[sampleRate];
+    if (built.empty())
+    {
+        built.reserve(static_cast<size_t>(numFactoryPrograms));
+        for (const auto& program : factoryPrograms)
+        {
+            const auto& settings = program.settings;
+            built.push_back(new CompressorPreset(settings, sampleRate,
+                                                 curveCache->getCurve(settings.threshold, settings.ratio, settings.knee)));
+        }
+    }
+
+    return built;
+}
+
+PresetBank::PresetBank()
+{
+    names.reserve(static_cast<size_t>(numFactoryPrograms));
+    for (const auto& program : factoryPrograms)
+        names.push_back(program.name);
+}
+
+void PresetBank::prepare(double sampleRate)
+{
+    auto newPresets = sharedPresets->getPresets(sampleRate);
+
+    const juce::ScopedLock sl(lock);
+    presets.swap(newPresets);
+}
+
+int PresetBank::getNumPresets() const
+{
+    return numFactoryPrograms;
+}
+
+CompressorPreset::Ptr PresetBank::getPreset(int index) const
+{
+    const juce::ScopedLock sl(lock);
+    if (! juce::isPositiveAndBelow(index, static_cast<int>(presets.size())))
+        return nullptr;
+
+    return presets[static_cast<size_t>(index)];
+}
+
+const CompressorPreset::Settings& PresetBank::getSettings(int index) const
+{
+    jassert(juce::isPositiveAndBelow(index, getNumPresets()));
+    return factoryPrograms[index].settings;
+}
+
+juce::String PresetBank::getName(int index) const
+{
+    const juce::ScopedLock sl(lock);
+    if (! juce::isPositiveAndBelow(index, getNumPresets()))
+        return {};
+
+    return names[static_cast<size_t>(index)];
+}
+
+void PresetBank::setName(int index, const juce::String& newName)
+{
+    const juce::ScopedLock sl(lock);
+    if (juce::isPositiveAndBelow(index, getNumPresets()))
+        names[static_cast<size_t>(index)] = newName;
+}
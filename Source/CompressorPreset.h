@@ -0,0 +1,85 @@
+/*
+  ==============================================================================
+
+    CompressorPreset.h
+    Created: 22 Oct 2026 2:31:08pm
+    Author:  Linus
+
+  ==============================================================================
+*/
+
+#pragma once
+#include <map>
+#include <vector>
+#include <JuceHeader.h>
+#include "GainComputer.h"
+#include "LevelDetector.h"
+#include "TransferCurve.h"
+
+// Immutable program of the plugin: the main compressor settings plus everything
+// derived from them for one sample rate, computed off the audio thread so that
+// switching to it costs a pointer swap. The curve sections, mid/side and the true
+// peak ceiling are not part of a preset and keep their current settings.
+class CompressorPreset : public juce::ReferenceCountedObject
+{
+public:
+    using Ptr = juce::ReferenceCountedObjectPtr<CompressorPreset>;
+
+    // Parameter values as the plugin shows them (dB, ms, 0..1 mix)
+    struct Settings
+    {
+        float inputGain, threshold, ratio, knee, attack, release, makeup, mix;
+    };
+
+    CompressorPreset(const Settings&, double sampleRate, TransferCurve::Ptr);
+
+    const Settings settings;
+
+    // Derived state, ready to be handed to the gain computer and the detectors
+    GainComputer::CompressorSection compressorSection;
+    LevelDetector::Coefficients ballistics;
+    TransferCurve::Ptr transferCurve;
+};
+
+// The programs of one plugin instance. The factory settings are a static table and
+// the built CompressorPresets are shared by every bank at the same sample rate, so a
+// new instance copies pointers instead of deriving coefficients. The bank holds the
+// presets of its sample rate, which also keeps them alive while a Compressor switches,
+// so no preset is ever freed on the audio thread.
+class PresetBank
+{
+public:
+    PresetBank();
+
+    // Takes the presets for the sample rate, building them if no other bank has.
+    // Call from prepareToPlay, with the audio callback stopped.
+    void prepare(double sampleRate);
+
+    int getNumPresets() const;
+
+    // nullptr until prepare has been called
+    CompressorPreset::Ptr getPreset(int index) const;
+
+    const CompressorPreset::Settings& getSettings(int index) const;
+
+    juce::String getName(int index) const;
+    void setName(int index, const juce::String&);
+
+private:
+    // Presets of the factory programs by sample rate, for every bank in the process
+    class SharedPresets
+    {
+    public:
+        std::vector<CompressorPreset::Ptr> getPresets(double sampleRate);
+
+    private:
+        std::map<double, std::vector<CompressorPreset::Ptr>> presetsBySampleRate;
+        juce::SharedResourcePointer<TransferCurveCache> curveCache;
+        juce::CriticalSection lock;
+    };
+
+    std::vector<juce::String> names;
+    std::vector<CompressorPreset::Ptr> presets;
+    juce::SharedResourcePointer<SharedPresets> sharedPresets;
+    juce::CriticalSection lock;
+};
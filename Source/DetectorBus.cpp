@@ -0,0 +1,146 @@
+/*
+  ==============================================================================
+
+    DetectorBus.cpp
+    Created: 24 Oct 2026 2:31:04pm
+    Author:  Linus
+
+  ==============================================================================
+*/
+
+#include "DetectorBus.h"
+
+DetectorBus::Group& DetectorBus::getGroup(int group)
+{
+    jassert(group >= 1 && group <= numGroups);
+    return groups[static_cast<size_t>(group - 1)];
+}
+
+const DetectorBus::Group& DetectorBus::getGroup(int group) const
+{
+    jassert(group >= 1 && group <= numGroups);
+    return groups[static_cast<size_t>(group - 1)];
+}
+
+int DetectorBus::join(int group)
+{
+    if (group < 1 || group > numGroups)
+        return -1;
+
+    auto& slots = getGroup(group).slots;
+    for (int i = 0; i < maxMembers; ++i)
+    {
+        auto& slot = slots[static_cast<size_t>(i)];
+        bool expected = false;
+        if (slot.occupied.compare_exchange_strong(expected, true, std::memory_order_acq_rel))
+        {
+            // Nothing counts until the new member publishes
+            for (auto& point : slot.envelope)
+                point.store(0.0f, std::memory_order_relaxed);
+            return i;
+        }
+    }
+
+    return -1;
+}
+
+void DetectorBus::leave(int group, int slot)
+{
+    if (group < 1 || group > numGroups || ! juce::isPositiveAndBelow(slot, maxMembers))
+        return;
+
+    auto& s = getGroup(group).slots[static_cast<size_t>(slot)];
+    for (auto& point : s.envelope)
+        point.store(0.0f, std::memory_order_relaxed);
+    s.occupied.store(false, std::memory_order_release);
+}
+
+int DetectorBus::getNumMembers(int group) const
+{
+    int numMembers = 0;
+    for (const auto& slot : getGroup(group).slots)
+        numMembers += slot.occupied.load(std::memory_order_acquire) ? 1 : 0;
+    return numMembers;
+}
+
+bool DetectorBus::isLeader(int group, int slot) const
+{
+    const auto& slots = getGroup(group).slots;
+    for (int i = 0; i < slot; ++i)
+        if (slots[static_cast<size_t>(i)].occupied.load(std::memory_order_acquire))
+            return false;
+
+    return true;
+}
+
+int DetectorBus::getPointStart(int point, int numSamples)
+{
+    return static_cast<int>(static_cast<juce::int64>(point) * numSamples / numEnvelopePoints);
+}
+
+void DetectorBus::publishEnvelope(int group, int slot, const float* sidechain, int numSamples)
+{
+    auto& g = getGroup(group);
+    auto& s = g.slots[static_cast<size_t>(slot)];
+
+    // Only this member ever writes its slot, so reading it back is no race
+    const auto now = g.leaderBlock.load(std::memory_order_acquire);
+    const bool combine = s.stamp.load(std::memory_order_relaxed) == now;
+
+    for (int point = 0; point < numEnvelopePoints; ++point)
+    {
+        const int start = getPointStart(point, numSamples);
+        const int end = getPointStart(point + 1, numSamples);
+        float peak = end > start ? juce::FloatVectorOperations::findMaximum(sidechain + start, end - start) : 0.0f;
+
+        auto& p = s.envelope[static_cast<size_t>(point)];
+        if (combine)
+            peak = juce::jmax(peak, p.load(std::memory_order_relaxed));
+        p.store(peak, std::memory_order_relaxed);
+    }
+
+    s.stamp.store(now, std::memory_order_release);
+}
+
+float DetectorBus::getEnvelopeOfOthers(int group, int slot, Envelope& envelope) const
+{
+    const auto& g = getGroup(group);
+    const auto now = g.leaderBlock.load(std::memory_order_acquire);
+
+    envelope.fill(0.0f);
+    float peak = 0.0f;
+    for (int i = 0; i < maxMembers; ++i)
+    {
+        const auto& s = g.slots[static_cast<size_t>(i)];
+        if (i == slot || ! s.occupied.load(std::memory_order_acquire))
+            continue;
+
+        if (now - s.stamp.load(std::memory_order_acquire) > maxStaleBlocks)
+            continue;
+
+        for (size_t point = 0; point < envelope.size(); ++point)
+        {
+            envelope[point] = juce::jmax(envelope[point], s.envelope[point].load(std::memory_order_relaxed));
+            peak = juce::jmax(peak, envelope[point]);
+        }
+    }
+
+    return peak;
+}
+
+void DetectorBus::publishAttenuation(int group, float attenuation)
+{
+    auto& g = getGroup(group);
+    g.attenuation.store(attenuation, std::memory_order_relaxed);
+    g.leaderBlock.fetch_add(1, std::memory_order_release);
+}
+
+float DetectorBus::getAttenuation(int group) const
+{
+    return getGroup(group).attenuation.load(std::memory_order_relaxed);
+}
+
+juce::uint32 DetectorBus::getLeaderBlock(int group) const
+{
+    return getGroup(group).leaderBlock.load(std::memory_order_acquire);
+}
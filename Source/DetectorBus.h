@@ -0,0 +1,92 @@
+/*
+  ==============================================================================
+
+    DetectorBus.h
+    Created: 24 Oct 2026 2:15:36pm
+    Author:  Linus
+
+  ==============================================================================
+*/
+
+#pragma once
+#include <array>
+#include <atomic>
+#include <JuceHeader.h>
+
+// Lets Compressors in one process share a detector, e.g. every track of a drum group,
+// through juce::SharedResourcePointer. Members of a group publish a decimated envelope
+// of each block's side-chain into their own slot: its peak over each of
+// numEnvelopePoints equal parts of the block. The leader, the member in the lowest
+// slot, folds those envelopes into its own side-chain part by part, runs the one
+// static curve and detector of the group and publishes the attenuation. The other
+// members only apply it.
+// Within a block the group's detector sees each member's peak over the whole part of
+// the block it falls in, so up to 1/numEnvelopePoints of a block before and after the
+// peak itself, never lower. Across blocks it sees what the members published before
+// the leader ran, so a member the host processes after the leader counts a block late.
+// Every call is wait-free: slots have a single writer and are read with atomics only,
+// so all of it may run on any number of audio threads at once. A leader reading while
+// a member publishes may mix points of two of its blocks.
+class DetectorBus
+{
+public:
+    static constexpr int numGroups = 16;
+    static constexpr int maxMembers = 32;
+    static constexpr int numEnvelopePoints = 16;
+
+    using Envelope = std::array<float, numEnvelopePoints>;
+
+    // Leader blocks after which a peak that hasn't been refreshed stops counting,
+    // so a member that stopped processing doesn't hold the group down
+    static constexpr juce::uint32 maxStaleBlocks = 8;
+
+    DetectorBus() = default;
+
+    // Groups are numbered from 1. Returns the slot taken, -1 if the group is full.
+    int join(int group);
+    void leave(int group, int slot);
+
+    int getNumMembers(int group) const;
+
+    bool isLeader(int group, int slot) const;
+
+    // First sample of a block of numSamples that an envelope point covers; point
+    // numEnvelopePoints gives the end of the block
+    static int getPointStart(int point, int numSamples);
+
+    // Envelope of a member's latest block of side-chain levels. Blocks published before
+    // the leader's next one are combined point by point, so none is lost when members
+    // run more often than the leader.
+    void publishEnvelope(int group, int slot, const float* sidechain, int numSamples);
+
+    // Point by point the highest envelope of the other members that is still current,
+    // all 0 if there is none. Returns its highest point.
+    float getEnvelopeOfOthers(int group, int slot, Envelope&) const;
+
+    // Attenuation in dB at the end of the leader's block, and how many it has published
+    void publishAttenuation(int group, float attenuation);
+    float getAttenuation(int group) const;
+    juce::uint32 getLeaderBlock(int group) const;
+
+private:
+    struct Slot
+    {
+        std::atomic<bool> occupied{ false };
+        std::array<std::atomic<float>, numEnvelopePoints> envelope{};
+        std::atomic<juce::uint32> stamp{ 0 };   // leader block the envelope was published in
+    };
+
+    struct Group
+    {
+        std::array<Slot, maxMembers> slots;
+        std::atomic<float> attenuation{ 0.0f };
+        std::atomic<juce::uint32> leaderBlock{ 0 };
+    };
+
+    Group& getGroup(int group);
+    const Group& getGroup(int group) const;
+
+    std::array<Group, numGroups> groups;
+
+    JUCE_DECLARE_NON_COPYABLE(DetectorBus)
+};
@@ -0,0 +1,72 @@
+/*
+  ==============================================================================
+
+    DetectorCheckpoints.cpp
+    Created: 28 Oct 2026 2:05:31pm
+    Author:  Linus
+
+  ==============================================================================
+*/
+
+#include "DetectorCheckpoints.h"
+#include <JuceHeader.h>
+
+DetectorCheckpoints::DetectorCheckpoints(int interval)
+    : interval(juce::jmax(1, interval))
+{
+}
+
+int DetectorCheckpoints::getInterval() const
+{
+    return interval;
+}
+
+void DetectorCheckpoints::prepare(int numSamples)
+{
+    checkpoints.assign(static_cast<size_t>(juce::jmax(0, numSamples - 1) / interval + 1), Checkpoint());
+}
+
+bool DetectorCheckpoints::isDue(int position) const
+{
+    return position % interval == 0 && static_cast<size_t>(position / interval) < checkpoints.size();
+}
+
+int DetectorCheckpoints::getSamplesToNext(int position) const
+{
+    return interval - position % interval;
+}
+
+void DetectorCheckpoints::store(int position, const LevelDetector::State& mid, const LevelDetector::State& side)
+{
+    jassert(isDue(position));
+    auto& checkpoint = checkpoints[static_cast<size_t>(position / interval)];
+    checkpoint.mid = mid;
+    checkpoint.side = side;
+    checkpoint.stored = true;
+}
+
+int DetectorCheckpoints::findNearest(int position) const
+{
+    if (position < 0)
+        return -1;
+
+    for (int index = juce::jmin(position / interval, static_cast<int>(checkpoints.size()) - 1); index >= 0; --index)
+        if (checkpoints[static_cast<size_t>(index)].stored)
+            return index * interval;
+
+    return -1;
+}
+
+const DetectorCheckpoints::Checkpoint& DetectorCheckpoints::get(int position) const
+{
+    jassert(position % interval == 0 && static_cast<size_t>(position / interval) < checkpoints.size());
+    return checkpoints[static_cast<size_t>(position / interval)];
+}
+
+int DetectorCheckpoints::getNumStored() const
+{
+    int numStored = 0;
+    for (const auto& checkpoint : checkpoints)
+        numStored += checkpoint.stored ? 1 : 0;
+    return numStored;
+}
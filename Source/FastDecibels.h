@@ -0,0 +1,58 @@
+/*
+  ==============================================================================
+
+    FastDecibels.h
+    Created: 23 Oct 2026 3:12:40pm
+    Author:  Linus
+
+  ==============================================================================
+*/
+
+#pragma once
+#include <cmath>
+#include <cstring>
+#include <JuceHeader.h>
+
+// Polynomial stand-ins for juce::Decibels in the gain path, for when the CPU is short.
+// Exponent from the float bits, a cubic for the mantissa: within 0.008 dB for
+// gainToDecibels and 0.003 dB for decibelsToGain, with juce's -100 dB floor.
+namespace FastDecibels
+{
+    inline float gainToDecibels(float gain) noexcept
+    {
+        if (! (gain > 0.0f))
+            return -100.0f;
+
+        juce::int32 bits;
+        std::memcpy(&bits, &gain, sizeof(bits));
+        const auto exponent = static_cast<float>(((bits >> 23) & 0xff) - 127);
+
+        // Mantissa in [1, 2)
+        bits = (bits & 0x007fffff) | 0x3f800000;
+        float mantissa;
+        std::memcpy(&mantissa, &bits, sizeof(mantissa));
+
+        const float t = mantissa - 1.0f;
+        const float log2 = exponent + t * (1.42349024f + t * (-0.58775347f + t * 0.16557608f));
+
+        // 20 * log10(2)
+        return juce::jmax(-100.0f, log2 * 6.02059991f);
+    }
+
+    inline float decibelsToGain(float decibels) noexcept
+    {
+        if (decibels <= -100.0f)
+            return 0.0f;
+
+        // log2(10) / 20, then 2^x as 2^floor(x) from the bits times a cubic for the fraction
+        const float x = juce::jmin(decibels * 0.16609640f, 127.0f);
+        const float whole = std::floor(x);
+        const float t = x - whole;
+
+        const auto bits = static_cast<juce::int32>((static_cast<int>(whole) + 127) << 23);
+        float scale;
+        std::memcpy(&scale, &bits, sizeof(scale));
+
+        return scale * (1.0f + t * (0.69542908f + t * (0.22694386f + t * 0.07737736f)));
+    }
+}
@@ -12,7 +12,7 @@
 #include <algorithm>
 #include <limits>
 #include <cmath>
-#include "../JuceLibraryCode/JuceHeader.h"
+#include <JuceHeader.h>
 
 GainComputer::GainComputer()
 {
@@ -21,6 +21,17 @@ GainComputer::GainComputer()
     slope = 1.0f / ratio - 1.0f;
     knee = 6.0f;
     kneeWidth = 3.0f;
+    inverseKnee = 1.0f / 12.0f;
+
+    // Every further section starts out neutral
+    gateThreshold = -std::numeric_limits<float>::infinity();
+    gateRange = 0.0f;
+    expanderThreshold = 0.0f;
+    expanderSlope = 0.0f;
+    upwardThreshold = 0.0f;
+    upwardSlope = 0.0f;
+    upwardMaxBoost = 0.0f;
+    limiterThreshold = std::numeric_limits<float>::infinity();
 }
 
 
@@ -41,7 +52,7 @@ void GainComputer::setRatio(float ratio)
     this->ratio = ratio;
     if (ratio > 23.9f)
         this->ratio = -std::numeric_limits<float>::infinity(); // You have become a limiter
-    slope = 1.0f / ratio - 1.0f;
+    slope = 1.0f / this->ratio - 1.0f;
 }
 
 void GainComputer::setKnee(float knee)
@@ -50,11 +61,107 @@ void GainComputer::setKnee(float knee)
     {
         this->knee = knee;
         kneeWidth = knee / 2.0f;
+        inverseKnee = knee > 0.0f ? 1.0f / (2.0f * knee) : 0.0f;
     }
     
 }
 
-float GainComputer::applyCompression(float input)
+void GainComputer::setGate(float threshold, float range)
+{
+    gateThreshold = threshold > -100.0f ? threshold : -std::numeric_limits<float>::infinity();
+    gateRange = range;
+    updateSectionsActive();
+}
+
+void GainComputer::setExpander(float threshold, float ratio)
+{
+    expanderThreshold = threshold;
+    expanderSlope = 1.0f - ratio;
+    updateSectionsActive();
+}
+
+void GainComputer::setUpward(float threshold, float ratio, float maxBoost)
+{
+    upwardThreshold = threshold;
+    upwardSlope = 1.0f - 1.0f / ratio;
+    upwardMaxBoost = maxBoost;
+    updateSectionsActive();
+}
+
+void GainComputer::setLimiter(float threshold)
+{
+    limiterThreshold = threshold;
+    updateSectionsActive();
+}
+
+void GainComputer::updateSectionsActive()
+{
+    sectionsActive = gateThreshold > -100.0f || expanderSlope != 0.0f || upwardSlope != 0.0f
+                  || limiterThreshold < std::numeric_limits<float>::infinity();
+}
+
+float GainComputer::getThreshold() const
+{
+    return threshold;
+}
+
+float GainComputer::getRatio() const
+{
+    return ratio;
+}
+
+float GainComputer::getKnee() const
+{
+    return knee;
+}
+
+GainComputer::CompressorSection GainComputer::getCompressorSection() const
+{
+    return { threshold, ratio, knee, kneeWidth, slope, inverseKnee };
+}
+
+void GainComputer::setCompressorSection(const CompressorSection& section, TransferCurve::Ptr newCurve)
+{
+    threshold = section.threshold;
+    ratio = section.ratio;
+    knee = section.knee;
+    kneeWidth = section.kneeWidth;
+    slope = section.slope;
+    inverseKnee = section.inverseKnee;
+
+    // The curve in use belongs to the audio thread; a pending one that no longer
+    // matches is simply never used, see computeAttenuation
+    curve = std::move(newCurve);
+}
+
+void GainComputer::setTransferCurve(TransferCurve::Ptr newCurve)
+{
+    const juce::SpinLock::ScopedLockType sl(curveLock);
+    pendingCurve = std::move(newCurve);
+}
+
+float GainComputer::applyCompression(float input) const
+{
+    return applySections(input, applyCompressorSection(input));
+}
+
+float GainComputer::kneeRamp(float x) const
+{
+    // Clamped to the knee the parabola tops out at kneeWidth, the rest continues linearly
+    const float inKnee = juce::jlimit(0.0f, knee, x + kneeWidth);
+    return inKnee * inKnee * inverseKnee + juce::jmax(x - kneeWidth, 0.0f);
+}
+
+float GainComputer::applySections(float input, float output) const
+{
+    // Written without branches so the buffer loop stays one straight pass
+    output -= input < gateThreshold ? gateRange : 0.0f;
+    output += expanderSlope * kneeRamp(expanderThreshold - input);
+    output += juce::jmin(upwardSlope * kneeRamp(upwardThreshold - input), upwardMaxBoost);
+    return juce::jmin(output, limiterThreshold);
+}
+
+float GainComputer::applyCompressorSection(float input) const
 {
     const float overshoot = input - threshold;
 
@@ -63,19 +170,51 @@ float GainComputer::applyCompression(float input)
         return input;
     
     // Compression within the knee range
-    if (overshoot <= kneeWidth/2)
-        return input + (slope * juce::square(overshoot + kneeWidth)) / knee;
+    if (knee > 0.0f && overshoot <= kneeWidth)
+        return input + (slope * juce::square(overshoot + kneeWidth)) / (2.0f * knee);
     
     // Full compression (overshoot has exceeded the knee range)
     return threshold + overshoot/ratio;
 }
 
-void GainComputer::applyCompressionToBuffer(float* buffer, int numSamples)
+void GainComputer::applyCompressionToBuffer(float* buffer, int numSamples, bool approximate)
 {
-    for (int i = 0; i < numSamples; i++)
+    updateTransferCurve();
+    computeAttenuation(buffer, numSamples, approximate);
+}
+
+void GainComputer::updateTransferCurve()
+{
+    // Pick up a new curve without ever blocking; the cache keeps the old one alive,
+    // so releasing it here never frees memory on the audio thread
+    const juce::SpinLock::ScopedTryLockType sl(curveLock);
+    if (sl.isLocked() && pendingCurve != nullptr)
     {
-        const float level = std::max(abs(buffer[i]), 1e-6f);
-        float levelInDecibels = juce::Decibels::gainToDecibels(level);
-        buffer[i] = applyCompression(levelInDecibels);
+        curve = pendingCurve;
+        pendingCurve = nullptr;
     }
+}
+
+void GainComputer::computeAttenuation(float* buffer, int numSamples, bool approximate) const
+{
+    // The single pass over the side-chain: linear level in, attenuation in dB out
+    const auto pass = [buffer, numSamples](auto&& attenuationOf)
+    {
+        for (int i = 0; i < numSamples; i++)
+            buffer[i] = attenuationOf(buffer[i]);
+    };
+
+    if (approximate)
+        withAttenuation([](float gain) { return FastDecibels::gainToDecibels(gain); }, pass);
+    else
+        withAttenuation([](float gain) { return juce::Decibels::gainToDecibels(gain); }, pass);
+}
+
+void GainComputer::computeAttenuationInDecibels(const float* levels, float* attenuation, int numSamples) const
+{
+    withCurve([levels, attenuation, numSamples](auto&& outputLevel)
+    {
+        for (int i = 0; i < numSamples; i++)
+            attenuation[i] = outputLevel(levels[i]) - levels[i];
+    });
 }
\ No newline at end of file
@@ -9,6 +9,10 @@
 */
 
 #pragma once
+#include <algorithm>
+#include <cmath>
+#include "FastDecibels.h"
+#include "TransferCurve.h"
 
 class GainComputer
 {
@@ -19,13 +23,115 @@ public:
     void setRatio(float);
     void setKnee(float);
 
-    float applyCompression(float);
+    float getThreshold() const;
+    float getRatio() const;
+    float getKnee() const;
 
-    void applyCompressionToBuffer(float*, int);
+    // Everything the compressor section derives from threshold, ratio and knee,
+    // so it can be worked out ahead of time and switched in as a whole
+    struct CompressorSection
+    {
+        float threshold, ratio, knee, kneeWidth, slope, inverseKnee;
+    };
+
+    CompressorSection getCompressorSection() const;
+
+    // Takes over precomputed settings together with their curve, for the audio thread:
+    // no maths, no locks. The caller keeps the curve alive, e.g. through the cache.
+    void setCompressorSection(const CompressorSection&, TransferCurve::Ptr);
+
+    // Further sections of the static curve, applied on the same side-chain level.
+    // Gate: levels below the threshold drop by range dB. Off at -100 dB and below.
+    void setGate(float threshold, float range);
+
+    // Downward expander below the threshold, ratio 1 is off
+    void setExpander(float threshold, float ratio);
+
+    // Upward compressor below the threshold, boosting by at most maxBoost dB. Ratio 1 is off.
+    void setUpward(float threshold, float ratio, float maxBoost);
+
+    // Hard ceiling on the output level, off at +inf
+    void setLimiter(float threshold);
+
+    // Hands over a precomputed curve from the message thread. It is picked up
+    // at the start of the next block and only used while it matches the settings.
+    void setTransferCurve(TransferCurve::Ptr);
+
+    // Static transfer curve: output level in dB for an input level in dB
+    float applyCompression(float) const;
+
+    // The soft-knee compressor section alone, which is what a TransferCurve tabulates
+    float applyCompressorSection(float) const;
+
+    // Replaces the linear side-chain levels with the attenuation in dB. With approximate
+    // the levels are converted with FastDecibels, see Compressor::Quality.
+    void applyCompressionToBuffer(float*, int, bool approximate = false);
+
+    // The two halves of applyCompressionToBuffer: taking over a curve handed to
+    // setTransferCurve, and the pass itself, which may run on several threads at once
+    void updateTransferCurve();
+    void computeAttenuation(float*, int, bool approximate = false) const;
+
+    // Same on levels already in dB, e.g. the output of an earlier stage in a chain:
+    // output level minus input level. attenuation may be levels.
+    void computeAttenuationInDecibels(const float* levels, float* attenuation, int) const;
+
+    // Calls body once with the static curve, an input level in dB in and the output
+    // level in dB out, its evaluation picked once for the whole call
+    template <typename Body>
+    void withCurve(Body&& body) const
+    {
+        // Fall back to evaluating the curve while a matching one is being built
+        if (curve != nullptr && curve->matches(threshold, ratio, knee))
+        {
+            if (sectionsActive)
+                body([this](float level) { return applySections(level, curve->lookup(level)); });
+            else
+                body([this](float level) { return curve->lookup(level); });
+        }
+        else if (sectionsActive)
+            body([this](float level) { return applyCompression(level); });
+        else
+            body([this](float level) { return applyCompressorSection(level); });
+    }
+
+    // Calls body once with the per-sample form of computeAttenuation, a linear level in
+    // and the attenuation in dB out, the curve evaluation picked once for the whole call.
+    // For kernels that fuse the static curve with the passes after it.
+    template <typename ToDecibels, typename Body>
+    void withAttenuation(ToDecibels&& toDecibels, Body&& body) const
+    {
+        withCurve([&](auto&& outputLevel)
+        {
+            body([&](float level)
+            {
+                const float levelInDecibels = toDecibels(std::max(std::abs(level), 1e-6f));
+                return outputLevel(levelInDecibels) - levelInDecibels;
+            });
+        });
+    }
 
 private:
+    // Adds the gate, expander, upward and limiter sections to the compressor output
+    float applySections(float input, float output) const;
+
+    // Soft-knee ramp: 0 below -kneeWidth, x above kneeWidth, a parabola in between
+    float kneeRamp(float x) const;
+
+    void updateSectionsActive();
+
     float threshold;
     float ratio;
     float knee, kneeWidth;
     float slope;
+    float inverseKnee;      // 1 / (2 * knee), 0 for a hard knee
+
+    float gateThreshold, gateRange;
+    float expanderThreshold, expanderSlope;
+    float upwardThreshold, upwardSlope, upwardMaxBoost;
+    float limiterThreshold;
+    bool sectionsActive{ false };
+
+    TransferCurve::Ptr curve, pendingCurve;
+    juce::SpinLock curveLock;
 };
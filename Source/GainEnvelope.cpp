@@ -0,0 +1,162 @@
+/*
+  ==============================================================================
+
+    GainEnvelope.cpp
+    Created: 24 Oct 2026 10:02:51am
+    Author:  Linus
+
+  ==============================================================================
+*/
+
+#include "GainEnvelope.h"
+#include <cmath>
+#include <limits>
+
+GainEnvelope::GainEnvelope(double sampleRate, bool midSide, int capacity)
+    : sampleRate(sampleRate), midSide(midSide), capacity(juce::jmax(0, capacity)),
+      gains(static_cast<size_t>(this->capacity) * (midSide ? 2 : 1), 1.0f)
+{
+}
+
+double GainEnvelope::getSampleRate() const
+{
+    return sampleRate;
+}
+
+bool GainEnvelope::isMidSide() const
+{
+    return midSide;
+}
+
+int GainEnvelope::getNumSamples() const
+{
+    return numSamples;
+}
+
+int GainEnvelope::getCapacity() const
+{
+    return capacity;
+}
+
+const float* GainEnvelope::getGains(int curve) const
+{
+    jassert(curve == 0 || (curve == 1 && midSide));
+    return gains.data() + static_cast<size_t>(curve) * static_cast<size_t>(capacity);
+}
+
+void GainEnvelope::append(const float* newGains, const float* sideGains, int numNewSamples)
+{
+    // A linked envelope has nowhere to keep a side gain
+    jassert(sideGains == nullptr || midSide);
+
+    const int num = juce::jmin(numNewSamples, capacity - numSamples);
+    if (num <= 0)
+        return;
+
+    float* mid = gains.data() + numSamples;
+    juce::FloatVectorOperations::copy(mid, newGains, num);
+
+    if (midSide)
+        juce::FloatVectorOperations::copy(mid + capacity, sideGains != nullptr ? sideGains : newGains, num);
+
+    numSamples += num;
+}
+
+void GainEnvelope::clear()
+{
+    numSamples = 0;
+}
+
+void GainEnvelope::apply(juce::AudioBuffer<float>& buffer, int startSample) const
+{
+    const int num = juce::jmin(buffer.getNumSamples(), numSamples - startSample);
+    if (num <= 0 || startSample < 0)
+        return;
+
+    const float* mid = getGains(0) + startSample;
+
+    if (! midSide || buffer.getNumChannels() < 2)
+    {
+        // Without a side a mid/side gain is the mid gain
+        for (int ch = 0; ch < buffer.getNumChannels(); ++ch)
+            juce::FloatVectorOperations::multiply(buffer.getWritePointer(ch), mid, num);
+        return;
+    }
+
+    // Encode, apply both gains and decode in one pass, as Compressor::processMidSide does
+    const float* side = getGains(1) + startSample;
+    float* left = buffer.getWritePointer(0);
+    float* right = buffer.getWritePointer(1);
+    for (int i = 0; i < num; ++i)
+    {
+        const float m = 0.5f * (left[i] + right[i]) * mid[i];
+        const float s = 0.5f * (left[i] - right[i]) * side[i];
+        left[i] = m + s;
+        right[i] = m - s;
+    }
+}
+
+namespace
+{
+    // Silence is the lowest step, everything else is rounded to the nearest step
+    constexpr int silence = std::numeric_limits<juce::int16>::min();
+
+    juce::int16 toStep(float gain)
+    {
+        if (! (gain > 0.0f))
+            return static_cast<juce::int16>(silence);
+
+        const float steps = std::round(20.0f * std::log10(gain) * GainEnvelope::stepsPerDecibel);
+        return static_cast<juce::int16>(juce::jlimit(static_cast<float>(silence + 1), 32767.0f, steps));
+    }
+
+    float fromStep(juce::int16 step)
+    {
+        if (step == silence)
+            return 0.0f;
+
+        return std::pow(10.0f, static_cast<float>(step) / (20.0f * GainEnvelope::stepsPerDecibel));
+    }
+}
+
+void GainEnvelope::writeTo(juce::OutputStream& stream) const
+{
+    stream.writeInt(magic);
+    stream.writeInt(version);
+    stream.writeDouble(sampleRate);
+    stream.writeInt(midSide ? 1 : 0);
+    stream.writeInt(numSamples);
+
+    for (int curve = 0; curve < (midSide ? 2 : 1); ++curve)
+    {
+        const float* curveGains = getGains(curve);
+        for (int i = 0; i < numSamples; ++i)
+            stream.writeShort(toStep(curveGains[i]));
+    }
+}
+
+std::unique_ptr<GainEnvelope> GainEnvelope::readFrom(juce::InputStream& stream)
+{
+    if (stream.readInt() != magic || stream.readInt() != version)
+        return nullptr;
+
+    const double sampleRate = stream.readDouble();
+    const bool midSide = stream.readInt() != 0;
+    const int numSamples = stream.readInt();
+    const int numCurves = midSide ? 2 : 1;
+
+    if (! (sampleRate > 0.0) || numSamples < 0
+        || stream.getNumBytesRemaining() < static_cast<juce::int64>(numSamples) * numCurves * 2)
+        return nullptr;
+
+    auto envelope = std::make_unique<GainEnvelope>(sampleRate, midSide, numSamples);
+    for (int curve = 0; curve < numCurves; ++curve)
+    {
+        float* curveGains = envelope->gains.data() + static_cast<size_t>(curve) * static_cast<size_t>(numSamples);
+        for (int i = 0; i < numSamples; ++i)
+            curveGains[i] = fromStep(stream.readShort());
+    }
+
+    envelope->numSamples = numSamples;
+    return envelope;
+}
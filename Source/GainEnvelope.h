@@ -0,0 +1,68 @@
+/*
+  ==============================================================================
+
+    GainEnvelope.h
+    Created: 24 Oct 2026 9:48:22am
+    Author:  Linus
+
+  ==============================================================================
+*/
+
+#pragma once
+#include <memory>
+#include <vector>
+#include <JuceHeader.h>
+
+// The linear gain Compressor::process applies, recorded once and applied to any
+// number of other signals with a multiply, e.g. the compression of the full mix
+// on every stem. One curve for linked stereo, mid and side curves for mid/side.
+// The gain includes makeup and mix; the input gain and the true peak ceiling are
+// not part of it.
+class GainEnvelope
+{
+public:
+    // Room for capacity samples, allocated here so recording never allocates
+    GainEnvelope(double sampleRate, bool midSide, int capacity);
+
+    double getSampleRate() const;
+    bool isMidSide() const;
+    int getNumSamples() const;
+    int getCapacity() const;
+
+    // Curve 0 is the linked or mid gain, curve 1 the side gain
+    const float* getGains(int curve) const;
+
+    // Appends the gains of one block, dropping what doesn't fit. sideGains is nullptr
+    // for linked gains, which a mid/side envelope stores as equal mid and side gains.
+    void append(const float* gains, const float* sideGains, int numSamples);
+
+    void clear();
+
+    // Multiplies the signal by the gains from startSample of the envelope on, with
+    // the M/S matrix fused in for a mid/side envelope. Samples past the end of the
+    // envelope are left as they are.
+    void apply(juce::AudioBuffer<float>&, int startSample = 0) const;
+
+    // Compact stream format: a small header, then every gain in dB as a 16 bit step
+    // of 1/256 dB, so a stored curve is within 0.002 dB of the recorded one
+    void writeTo(juce::OutputStream&) const;
+
+    // nullptr if the stream doesn't hold a complete envelope
+    static std::unique_ptr<GainEnvelope> readFrom(juce::InputStream&);
+
+    static constexpr float stepsPerDecibel = 256.0f;
+
+private:
+    static constexpr int magic = 0x56454743;    // "CGEV"
+    static constexpr int version = 1;
+
+    double sampleRate;
+    bool midSide;
+    int numSamples{ 0 };
+    int capacity;
+
+    // Mid (or linked) curve then side curve, capacity samples each
+    std::vector<float> gains;
+
+    JUCE_DECLARE_NON_COPYABLE(GainEnvelope)
+};
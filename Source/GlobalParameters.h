@@ -62,5 +62,50 @@ namespace GlobalParameters
         constexpr float mixStart = 0.0f;
         constexpr float mixEnd = 1.0f;
         constexpr float mixInterval = 0.001f;
+
+        // Gate is off at its lowest threshold, the limiter at its highest
+        constexpr float gateStart = -100.0f;
+        constexpr float gateEnd = 0.0f;
+        constexpr float gateInterval = 0.1f;
+        constexpr float gateRange = 80.0f;
+
+        constexpr float expanderRatioStart = 1.0f;
+        constexpr float expanderRatioEnd = 8.0f;
+        constexpr float expanderRatioInterval = 0.05f;
+
+        constexpr float upwardRatioStart = 1.0f;
+        constexpr float upwardRatioEnd = 4.0f;
+        constexpr float upwardRatioInterval = 0.05f;
+        constexpr float upwardMaxBoost = 12.0f;
+
+        constexpr float limitStart = -30.0f;
+        constexpr float limitEnd = 6.0f;
+        constexpr float limitInterval = 0.1f;
+
+        constexpr float ceilingStart = -12.0f;
+        constexpr float ceilingEnd = 0.0f;
+        constexpr float ceilingInterval = 0.1f;
+
+        // Share of a block's duration processing may take before the quality steps down
+        constexpr float cpuLimitStart = 10.0f;
+        constexpr float cpuLimitEnd = 100.0f;
+        constexpr float cpuLimitInterval = 1.0f;
+
+        // What the library and the batch daemon accept from a caller, NaN and infinities fail every check
+        struct Bounds
+        {
+            float start, end;
+            constexpr bool contains(float value) const { return value >= start && value <= end; }
+        };
+
+        constexpr Bounds inputBounds{ inputStart, inputEnd };
+        constexpr Bounds thresholdBounds{ thresholdStart, thresholdEnd };
+        constexpr Bounds ratioBounds{ ratioStart, ratioEnd };
+        constexpr Bounds kneeBounds{ kneeStart, kneeEnd };
+        constexpr Bounds attackBounds{ attackStart, attackEnd };
+        constexpr Bounds releaseBounds{ releaseStart, releaseEnd };
+        constexpr Bounds makeupBounds{ makeupStart, makeupEnd };
+        constexpr Bounds mixBounds{ mixStart, mixEnd };
+        constexpr Bounds ceilingBounds{ ceilingStart, ceilingEnd };
     }
 }
\ No newline at end of file
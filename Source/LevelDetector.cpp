@@ -9,7 +9,7 @@
 */
 
 #include "LevelDetector.h"
-#include "../JuceLibraryCode/JuceHeader.h"
+#include <JuceHeader.h>
 
 // fs = sampling frequency
 void LevelDetector::prepare(const double& fs)
@@ -19,6 +19,11 @@ void LevelDetector::prepare(const double& fs)
     attackCoefficient = calculateCoefficient(attackTimeInSeconds);
     // Calculate release coefficient
     releaseCoefficient = calculateCoefficient(releaseTimeInSeconds);
+    reset();
+}
+
+void LevelDetector::reset()
+{
     state01 = 0.0;
     state02 = 0.0;
 }
@@ -56,6 +61,35 @@ double LevelDetector::getReleaseCoefficient()
     return releaseCoefficient;
 }
 
+LevelDetector::Coefficients LevelDetector::getCoefficients() const
+{
+    return { attackTimeInSeconds, attackCoefficient, releaseTimeInSeconds, releaseCoefficient };
+}
+
+void LevelDetector::setCoefficients(const Coefficients& coefficients)
+{
+    attackTimeInSeconds = coefficients.attackTimeInSeconds;
+    attackCoefficient = coefficients.attackCoefficient;
+    releaseTimeInSeconds = coefficients.releaseTimeInSeconds;
+    releaseCoefficient = coefficients.releaseCoefficient;
+}
+
+float LevelDetector::getLevel() const
+{
+    return static_cast<float>(state01);
+}
+
+LevelDetector::State LevelDetector::getState() const
+{
+    return { state01, state02 };
+}
+
+void LevelDetector::setState(const State& state)
+{
+    state01 = state.state01;
+    state02 = state.state02;
+}
+
 float LevelDetector::processPeakBranched(const float& input)
 {
     //Smooth branched peak detector
@@ -17,6 +17,9 @@ public:
 
     void prepare(const double& fs);
 
+    // Back to rest, keeping the coefficients
+    void reset();
+
     void setAttack(const double&);
     void setRelease(const double&);
     double getAttack();
@@ -24,6 +27,30 @@ public:
     double getAttackCoefficient();
     double getReleaseCoefficient();
 
+    // Attack and release times with their coefficients for one sample rate,
+    // worked out ahead of time so they can be switched in without calling exp
+    struct Coefficients
+    {
+        double attackTimeInSeconds, attackCoefficient;
+        double releaseTimeInSeconds, releaseCoefficient;
+    };
+
+    Coefficients getCoefficients() const;
+    void setCoefficients(const Coefficients&);
+
+    // Output of the branched detector for the last sample it processed
+    float getLevel() const;
+
+    // Everything the detector remembers of its past input, to continue a render from
+    // where another detector with the same coefficients was
+    struct State
+    {
+        double state01, state02;
+    };
+
+    State getState() const;
+    void setState(const State&);
+
     float processPeakBranched(const float&);
     float precessPeakDecoupled(const float&);
     void applyBallistics(float*, int);
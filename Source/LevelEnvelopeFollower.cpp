@@ -10,18 +10,24 @@
 
 #include "LevelEnvelopeFollower.h"
 
+#include <JuceHeader.h>
 #include <cmath>
 #include <cassert>
+#include <algorithm>
 
 void LevelEnvelopeFollower::prepare(const double& fs)
 {
     sampleRate = fs;
 
+    // Coefficients per sample, so the decay takes as long at any sample rate; none before
+    // there is one
     peakDecayInSamples = static_cast<int>(peakDecayInSeconds * sampleRate);
-    peakDecay = 1.0f - 1.0f / static_cast<float>(peakDecayInSeconds);
+    peakDecay = peakDecayInSamples > 0 ? 1.0f - 1.0f / static_cast<float>(peakDecayInSamples) : 0.0f;
 
     rmsDecayInSamples = static_cast<int>(rmsDecayInSeconds * sampleRate);
-    rmsDecay = 1.0f - 1.0f / static_cast<float>(rmsDecayInSamples);
+    rmsDecay = rmsDecayInSamples > 0 ? 1.0f - 1.0f / static_cast<float>(rmsDecayInSamples) : 0.0f;
+
+    blockDecaySamples = 0;
 }
 
 void LevelEnvelopeFollower::setPeakDecay(float dc)
@@ -41,20 +47,34 @@ void LevelEnvelopeFollower::updatePeak(const float* const* channelData, int numC
     assert(numChannels >= 0 && numSamples >= 0 && channelData != nullptr);
     if (numChannels > 0 && numSamples > 0)
     {
-        for (int i = 0; i < numSamples; ++i)
+        float blockPeak = 0.0f;
+        for (int j = 0; j < numChannels; ++j)
         {
-            float sum = 0.0f;
-            for (int j = 0; j < numChannels; ++j)
-                sum += std::abs(channelData[j][i]);
+            const auto range = juce::FloatVectorOperations::findMinAndMax(channelData[j], numSamples);
+            blockPeak = std::max({ blockPeak, -range.getStart(), range.getEnd() });
+        }
 
-            sum /= static_cast<float>(numChannels);
+        updatePeak(blockPeak, numSamples);
+    }
+}
 
-            if (sum > currMaxPeak)
-                currMaxPeak = sum;
-            else if (currMaxPeak > 0.001f)
-                currMaxPeak *= peakDecay;
-            else currMaxPeak = 0.0f;
+void LevelEnvelopeFollower::updatePeak(float blockPeak, int numSamples)
+{
+    assert(numSamples >= 0);
+    if (numSamples > 0)
+    {
+        // One pow per block size, hosts mostly keep theirs
+        if (numSamples != blockDecaySamples)
+        {
+            blockDecay = std::pow(peakDecay, static_cast<float>(numSamples));
+            blockDecaySamples = numSamples;
         }
+
+        float decayed = currMaxPeak * blockDecay;
+        if (decayed <= 0.001f)
+            decayed = 0.0f;
+
+        currMaxPeak = std::max(blockPeak, decayed);
     }
 }
 
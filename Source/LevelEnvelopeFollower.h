@@ -26,9 +26,13 @@ public:
     // Set rms decay
     void setRmsDecay(float dc);
 
-    // Updates peak envelope follower from given audio buffer
+    // Updates peak envelope follower from given audio buffer, with the max |x| over all channels
     void updatePeak(const float* const* channelData, int numChannels, int numSamples);
 
+    // Updates peak envelope follower from a block's peak, e.g. Compressor::getInputPeak: the peak
+    // holds against the envelope decayed over the whole block, in closed form
+    void updatePeak(float blockPeak, int numSamples);
+
     // Updates rms envelope follower from given audio buffer
     void updateRMS(const float* const* channelData, int numChannels, int numSamples);
 
@@ -47,5 +51,7 @@ private:
     float rmsDecayInSeconds{ 0.0f };
     int peakDecayInSamples{ 0 };
     int rmsDecayInSamples{ 0 };
+    float blockDecay{ 1.0f };       // peakDecay to the power of blockDecaySamples
+    int blockDecaySamples{ 0 };
     double sampleRate{ 0.0f };
 };
\ No newline at end of file
@@ -0,0 +1,68 @@
+/*
+  ==============================================================================
+
+    LevelMeter.cpp
+    Created: 21 Oct 2026 10:16:02am
+    Author:  Linus
+
+  ==============================================================================
+*/
+
+#include "LevelMeter.h"
+#include "GlobalParameters.h"
+
+LevelMeter::LevelMeter(const juce::Atomic<float>& s, float min, bool gainReduction)
+    : source(s), minLevel(min), isGainReduction(gainReduction)
+{
+    setOpaque(true);
+}
+
+void LevelMeter::refresh()
+{
+    const int newExtent = levelToExtent(source.get());
+    if (newExtent == extent)
+        return;
+
+    // Repaint only the strip that changed
+    const auto area = getBarArea();
+    const int from = juce::jmin(extent, newExtent);
+    const int to = juce::jmax(extent, newExtent);
+    extent = newExtent;
+
+    if (isGainReduction)
+        repaint(area.getX(), area.getY() + from, area.getWidth(), to - from);
+    else
+        repaint(area.getX(), area.getBottom() - to, area.getWidth(), to - from);
+}
+
+void LevelMeter::paint(juce::Graphics& g)
+{
+    using namespace GlobalParameters;
+
+    g.fillAll(juce::Colour(Colors::bg_DarkGrey));
+
+    const auto area = getBarArea();
+    g.setColour(juce::Colour(isGainReduction ? Colors::bg_LightGrey : Colors::statusOutline));
+
+    if (isGainReduction)
+        g.fillRect(area.withHeight(extent));
+    else
+        g.fillRect(area.withTop(area.getBottom() - extent));
+}
+
+void LevelMeter::resized()
+{
+    extent = levelToExtent(source.get());
+}
+
+int LevelMeter::levelToExtent(float level) const
+{
+    // Both kinds of meter span minLevel..0 dB
+    const float magnitude = isGainReduction ? -level : level - minLevel;
+    return juce::roundToInt(juce::jlimit(0.0f, 1.0f, magnitude / -minLevel) * static_cast<float>(getBarArea().getHeight()));
+}
+
+juce::Rectangle<int> LevelMeter::getBarArea() const
+{
+    return getLocalBounds().reduced(static_cast<int>(GlobalParameters::Margins::small));
+}
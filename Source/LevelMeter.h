@@ -0,0 +1,39 @@
+/*
+  ==============================================================================
+
+    LevelMeter.h
+    Created: 21 Oct 2026 10:15:26am
+    Author:  Linus
+
+  ==============================================================================
+*/
+
+#pragma once
+#include <JuceHeader.h>
+
+// Vertical bar meter fed from one of the processor's metering atomics.
+// Only the strip between the previous and the new bar height is repainted.
+class LevelMeter : public juce::Component
+{
+public:
+    // Gain reduction meters grow downwards from 0 dB
+    LevelMeter(const juce::Atomic<float>& source, float minLevel, bool isGainReduction);
+
+    // Reads the source and repaints the changed region, call from the editor's refresh tick
+    void refresh();
+
+    void paint(juce::Graphics&) override;
+    void resized() override;
+
+private:
+    // Bar height in pixels for the given level
+    int levelToExtent(float level) const;
+    juce::Rectangle<int> getBarArea() const;
+
+    const juce::Atomic<float>& source;
+    const float minLevel;
+    const bool isGainReduction;
+    int extent{ 0 };
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(LevelMeter)
+};
@@ -0,0 +1,39 @@
+/*
+  ==============================================================================
+
+    ParallelSegments.cpp
+    Created: 22 Oct 2026 9:47:40am
+    Author:  Linus
+
+  ==============================================================================
+*/
+
+#include "ParallelSegments.h"
+#include <atomic>
+
+void ParallelSegments::forEach(juce::ThreadPool& pool, int numSamples, int segmentSize,
+                               const std::function<void(int start, int numSamples)>& job)
+{
+    jassert(segmentSize > 0);
+
+    const int numSegments = (numSamples + segmentSize - 1) / segmentSize;
+    if (numSegments == 0)
+        return;
+
+    std::atomic<int> remaining{ numSegments };
+    juce::WaitableEvent finished;
+
+    for (int segment = 0; segment < numSegments; ++segment)
+    {
+        pool.addJob([&, segment]
+        {
+            const int start = segment * segmentSize;
+            job(start, juce::jmin(segmentSize, numSamples - start));
+
+            if (--remaining == 0)
+                finished.signal();
+        });
+    }
+
+    finished.wait();
+}
@@ -0,0 +1,26 @@
+/*
+  ==============================================================================
+
+    ParallelSegments.h
+    Created: 22 Oct 2026 9:47:12am
+    Author:  Linus
+
+  ==============================================================================
+*/
+
+#pragma once
+#include <functional>
+#include <JuceHeader.h>
+
+// Splits offline work on a whole file into fixed-size segments and runs them
+// on a juce::ThreadPool. Only for passes whose segments are independent;
+// anything with state across segments has to run serially or warm up itself.
+namespace ParallelSegments
+{
+    // Large enough that scheduling is noise, small enough to balance a few cores
+    constexpr int defaultSegmentSize = 1 << 16;
+
+    // Calls job(start, numSamples) for every segment and waits for all of them
+    void forEach(juce::ThreadPool& pool, int numSamples, int segmentSize,
+                 const std::function<void(int start, int numSamples)>& job);
+}
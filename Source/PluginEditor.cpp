@@ -8,14 +8,92 @@
 
 #include "PluginProcessor.h"
 #include "PluginEditor.h"
+#include "GlobalParameters.h"
+#include "DetectorBus.h"
+
+namespace
+{
+    // The main row first, then the further curve sections
+    const char* const controlIDs[] = { "inputgain", "threshold", "ratio", "knee", "attack", "release", "makeup", "mix", "ceiling",
+                                       "gate", "expthreshold", "expratio", "upthreshold", "upratio", "limit" };
+    constexpr size_t numMainControls = 9;
+
+    // Item i of the link selector is group i, the first one unlinked
+    juce::StringArray getLinkGroupNames()
+    {
+        juce::StringArray names{ "No Link" };
+        for (int group = 1; group <= DetectorBus::numGroups; ++group)
+            names.add ("Link " + juce::String (group));
+        return names;
+    }
+
+    // Item i of the tuning selector is the parameter's value i, the first one auto
+    juce::StringArray getTuningNames()
+    {
+        juce::StringArray names{ "Auto Tuning" };
+        for (const auto& tuning : CompressorAudioProcessor::getPinnedTunings())
+            names.add (AutoTuner::describe (tuning));
+        return names;
+    }
+}
 
 //==============================================================================
 CompressorAudioProcessorEditor::CompressorAudioProcessorEditor (CompressorAudioProcessor& p)
-    : AudioProcessorEditor (&p), audioProcessor (p)
+    : AudioProcessorEditor (&p), audioProcessor (p),
+      truePeakAttachment (p.getValueTreeState(), "truepeak", truePeakButton),
+      midSideAttachment (p.getValueTreeState(), "midside", midSideButton),
+      adaptiveAttachment (p.getValueTreeState(), "adaptive", adaptiveButton),
+      asyncAttachment (p.getValueTreeState(), "async", asyncButton),
+      transferCurve (p.getValueTreeState()),
+      inputMeter (p.currentInput, -60.0f, false),
+      gainReductionMeter (p.gainReduction, -30.0f, true),
+      outputMeter (p.currentOutput, -60.0f, false),
+      vBlankAttachment (this, [this] { onVBlank(); })
 {
-    // Make sure that before the constructor has finished, you've set the
-    // editor's size to whatever you need it to be.
-    setSize (400, 300);
+    using namespace GlobalParameters;
+
+    auto& parameters = audioProcessor.getValueTreeState();
+
+    for (size_t i = 0; i < controls.size(); ++i)
+    {
+        auto& control = controls[i];
+        control.slider.setSliderStyle (juce::Slider::RotaryHorizontalVerticalDrag);
+        control.slider.setTextBoxStyle (juce::Slider::TextBoxBelow, false, 70, 18);
+        control.slider.setColour (juce::Slider::rotarySliderFillColourId, juce::Colour (Colors::statusOutline));
+        control.slider.setColour (juce::Slider::rotarySliderOutlineColourId, juce::Colour (Colors::knobShadow));
+        control.attachment = std::make_unique<juce::AudioProcessorValueTreeState::SliderAttachment> (parameters, controlIDs[i], control.slider);
+
+        control.label.setText (parameters.getParameter (controlIDs[i])->getName (16), juce::dontSendNotification);
+        control.label.setJustificationType (juce::Justification::centred);
+
+        addAndMakeVisible (control.slider);
+        addAndMakeVisible (control.label);
+    }
+
+    addAndMakeVisible (truePeakButton);
+    addAndMakeVisible (midSideButton);
+    addAndMakeVisible (adaptiveButton);
+
+    qualityLabel.setJustificationType (juce::Justification::centredLeft);
+    addAndMakeVisible (qualityLabel);
+    addAndMakeVisible (transferCurve);
+    addAndMakeVisible (inputMeter);
+    addAndMakeVisible (gainReductionMeter);
+    addAndMakeVisible (outputMeter);
+
+    // The items have to be there before the attachment selects one
+    linkBox.addItemList (getLinkGroupNames(), 1);
+    linkAttachment = std::make_unique<juce::AudioProcessorValueTreeState::ComboBoxAttachment> (parameters, "link", linkBox);
+    addAndMakeVisible (linkBox);
+    addAndMakeVisible (asyncButton);
+
+    tuningBox.addItemList (getTuningNames(), 1);
+    tuningAttachment = std::make_unique<juce::AudioProcessorValueTreeState::ComboBoxAttachment> (parameters, "tuning", tuningBox);
+    addAndMakeVisible (tuningBox);
+    tuningLabel.setJustificationType (juce::Justification::centredLeft);
+    addAndMakeVisible (tuningLabel);
+
+    setSize (800, 560);
 }
 
 CompressorAudioProcessorEditor::~CompressorAudioProcessorEditor()
@@ -25,16 +103,80 @@ CompressorAudioProcessorEditor::~CompressorAudioProcessorEditor()
 //==============================================================================
 void CompressorAudioProcessorEditor::paint (juce::Graphics& g)
 {
-    // (Our component is opaque, so we must completely fill the background with a solid colour)
-    g.fillAll (getLookAndFeel().findColour (juce::ResizableWindow::backgroundColourId));
-
-    g.setColour (juce::Colours::white);
-    g.setFont (15.0f);
-    g.drawFittedText ("Hello to the World!", getLocalBounds(), juce::Justification::centred, 1);
+    g.fillAll (juce::Colour (GlobalParameters::Colors::bg_App));
 }
 
 void CompressorAudioProcessorEditor::resized()
 {
-    // This is generally where you'll want to lay out the positions of any
-    // subcomponents in your editor..
+    using namespace GlobalParameters;
+
+    const int margin = static_cast<int> (Margins::big);
+    auto bounds = getLocalBounds().reduced (margin);
+
+    // Main knob row along the bottom, curve sections above it with the mode
+    // switches and the quality readout over the mix and ceiling knobs
+    auto knobRow = bounds.removeFromBottom (120);
+    auto sectionRow = bounds.removeFromBottom (120);
+    const int knobWidth = knobRow.getWidth() / static_cast<int> (numMainControls);
+
+    auto switches = sectionRow.removeFromRight (2 * knobWidth).withSizeKeepingCentre (2 * knobWidth, 4 * 24 + 3 * margin);
+    auto modeRow = switches.removeFromTop (24);
+    truePeakButton.setBounds (modeRow.removeFromRight (knobWidth));
+    midSideButton.setBounds (modeRow);
+
+    auto linkRow = switches.removeFromBottom (24);
+    linkBox.setBounds (linkRow.removeFromLeft (knobWidth));
+    asyncButton.setBounds (linkRow.reduced (static_cast<int> (Margins::small), 0));
+
+    switches.removeFromTop (margin);
+    auto qualityRow = switches.removeFromTop (24);
+    adaptiveButton.setBounds (qualityRow.removeFromLeft (knobWidth));
+    qualityLabel.setBounds (qualityRow);
+
+    // The tuning in use next to the selector, which names it only when pinned
+    switches.removeFromTop (margin);
+    auto tuningRow = switches.removeFromTop (24);
+    tuningBox.setBounds (tuningRow.removeFromLeft (knobWidth));
+    tuningLabel.setBounds (tuningRow.reduced (static_cast<int> (Margins::small), 0));
+
+    for (size_t i = 0; i < controls.size(); ++i)
+    {
+        auto& row = i < numMainControls ? knobRow : sectionRow;
+        auto cell = row.removeFromLeft (knobWidth).reduced (static_cast<int> (Margins::small));
+        controls[i].label.setBounds (cell.removeFromTop (18));
+        controls[i].slider.setBounds (cell);
+    }
+
+    bounds.removeFromBottom (margin);
+
+    // Meters on the right, curve fills the rest
+    auto meters = bounds.removeFromRight (3 * 24 + 2 * margin);
+    outputMeter.setBounds (meters.removeFromRight (24));
+    meters.removeFromRight (margin);
+    gainReductionMeter.setBounds (meters.removeFromRight (24));
+    meters.removeFromRight (margin);
+    inputMeter.setBounds (meters.removeFromRight (24));
+
+    bounds.removeFromRight (margin);
+    transferCurve.setBounds (bounds.withSizeKeepingCentre (juce::jmin (bounds.getWidth(), bounds.getHeight()), bounds.getHeight()));
+}
+
+void CompressorAudioProcessorEditor::onVBlank()
+{
+    // The display may refresh at 120 Hz or more, meters don't need to
+    const double now = juce::Time::getMillisecondCounterHiRes();
+    if (now - lastRefreshMs < 1000.0 / refreshRateHz)
+        return;
+
+    lastRefreshMs = now;
+    transferCurve.refresh();
+    inputMeter.refresh();
+    gainReductionMeter.refresh();
+    outputMeter.refresh();
+
+    const auto& governor = audioProcessor.getQualityGovernor();
+    qualityLabel.setText (juce::String (QualityGovernor::getQualityName (governor.getQuality())) + " "
+                              + juce::String (juce::roundToInt (100.0f * governor.getLoad())) + "%",
+                          juce::dontSendNotification);
+    tuningLabel.setText (AutoTuner::describe (audioProcessor.getCompressorTuning()), juce::dontSendNotification);
 }
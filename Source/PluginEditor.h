@@ -10,6 +10,8 @@
 
 #include <JuceHeader.h>
 #include "PluginProcessor.h"
+#include "TransferCurveDisplay.h"
+#include "LevelMeter.h"
 
 //==============================================================================
 /**
@@ -25,9 +27,42 @@ public:
     void resized() override;
 
 private:
+    // Called on every display refresh, throttled to refreshRateHz
+    void onVBlank();
+
+    static constexpr double refreshRateHz = 30.0;
+
+    struct Control
+    {
+        juce::Slider slider;
+        juce::Label label;
+        std::unique_ptr<juce::AudioProcessorValueTreeState::SliderAttachment> attachment;
+    };
+
     // This reference is provided as a quick way for your editor to
     // access the processor object that created it.
     CompressorAudioProcessor& audioProcessor;
 
+    std::array<Control, 15> controls;
+    juce::ToggleButton truePeakButton{ "True Peak" };
+    juce::AudioProcessorValueTreeState::ButtonAttachment truePeakAttachment;
+    juce::ToggleButton midSideButton{ "Mid/Side" };
+    juce::AudioProcessorValueTreeState::ButtonAttachment midSideAttachment;
+    juce::ToggleButton adaptiveButton{ "Adaptive" };
+    juce::AudioProcessorValueTreeState::ButtonAttachment adaptiveAttachment;
+    juce::Label qualityLabel;
+    juce::ComboBox linkBox;
+    std::unique_ptr<juce::AudioProcessorValueTreeState::ComboBoxAttachment> linkAttachment;
+    juce::ToggleButton asyncButton{ "Async" };
+    juce::AudioProcessorValueTreeState::ButtonAttachment asyncAttachment;
+    juce::ComboBox tuningBox;
+    std::unique_ptr<juce::AudioProcessorValueTreeState::ComboBoxAttachment> tuningAttachment;
+    juce::Label tuningLabel;
+    TransferCurveDisplay transferCurve;
+    LevelMeter inputMeter, gainReductionMeter, outputMeter;
+
+    juce::VBlankAttachment vBlankAttachment;
+    double lastRefreshMs{ 0.0 };
+
     JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (CompressorAudioProcessorEditor)
 };
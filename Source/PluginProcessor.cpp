@@ -7,9 +7,165 @@
 */
 
 #include "PluginProcessor.h"
-#include "PluginEditor.h"
-#include "Constants.h"
+#if ! COMPRESSOR_HEADLESS
+ #include "PluginEditor.h"
+#endif
+#include "GlobalParameters.h"
 #include <cstdint>
+#include <iterator>
+
+namespace
+{
+    // What a parameter is, the same in every instance. Built once per process, so the
+    // parameters of a new instance share these strings rather than allocating their own.
+    struct ParameterInfo
+    {
+        enum class Kind { toggle, integer, decimal };
+
+        Kind kind;
+        juce::String id, name, label;
+        juce::NormalisableRange<float> range;
+        float defaultValue;
+        juce::String (*toText)(float);
+    };
+
+    // The parameters a program sets, in the order setParametersFromPreset gives their values
+    const char* const presetParameterIDs[] = { "inputgain", "threshold", "ratio", "knee", "attack", "release", "makeup", "mix" };
+
+    bool isPresetParameter(const juce::String& parameterID)
+    {
+        for (const auto* id : presetParameterIDs)
+            if (parameterID == id)
+                return true;
+        return false;
+    }
+
+    juce::String toDecibels(float value) { return juce::String(value, 1) + " dB"; }
+
+    const std::vector<ParameterInfo>& getParameterInfos()
+    {
+        using namespace GlobalParameters::Parameter;
+        using Kind = ParameterInfo::Kind;
+        using Range = juce::NormalisableRange<float>;
+
+        static const std::vector<ParameterInfo> infos{
+            { Kind::toggle, "power", "Power", {}, {}, 1.0f, nullptr },
+            { Kind::decimal, "inputgain", "Input", {}, Range(inputStart, inputEnd, inputInterval), 0.0f, toDecibels },
+            { Kind::decimal, "threshold", "Tresh", {}, Range(thresholdStart, thresholdEnd, thresholdInterval), -10.0f, toDecibels },
+            { Kind::decimal, "ratio", "Ratio", {}, Range(ratioStart, ratioEnd, ratioInterval, 0.5f), 2.0f,
+              [](float value)
+              {
+                  if (value > 23.9f) return juce::String("Infinity") + ":1";
+                  return juce::String(value, 1) + ":1";
+              } },
+            { Kind::decimal, "knee", "Knee", {}, Range(kneeStart, kneeEnd, kneeInterval), 6.0f, toDecibels },
+            { Kind::decimal, "attack", "Attack", "ms", Range(attackStart, attackEnd, attackInterval, 0.5f), 2.0f,
+              [](float value)
+              {
+                  if (value == 100.0f) return juce::String(value, 0) + " ms";
+                  return juce::String(value, 2) + " ms";
+              } },
+            { Kind::decimal, "release", "Release", {}, Range(releaseStart, releaseEnd, releaseInterval, 0.35f), 140.0f,
+              [](float value)
+              {
+                  if (value <= 100) return juce::String(value, 2) + " ms";
+                  if (value >= 1000) return juce::String(value * 0.001f, 2) + " s";
+                  return juce::String(value, 1) + " ms";
+              } },
+            { Kind::decimal, "makeup", "Makeup", {}, Range(makeupStart, makeupEnd, makeupInterval), 0.0f,
+              [](float value) { return juce::String(value, 1) + " dB "; } },
+            { Kind::decimal, "mix", "Mix", "%", Range(mixStart, mixEnd, mixInterval), 1.0f,
+              [](float value) { return juce::String(value * 100.0f, 1) + " %"; } },
+            { Kind::decimal, "gate", "Gate", {}, Range(gateStart, gateEnd, gateInterval), gateStart,
+              [](float value)
+              {
+                  if (value <= gateStart) return juce::String("Off");
+                  return toDecibels(value);
+              } },
+            { Kind::decimal, "expthreshold", "Exp Thresh", {}, Range(thresholdStart, thresholdEnd, thresholdInterval), -50.0f, toDecibels },
+            { Kind::decimal, "expratio", "Exp Ratio", {}, Range(expanderRatioStart, expanderRatioEnd, expanderRatioInterval, 0.5f), 1.0f,
+              [](float value)
+              {
+                  if (value <= 1.0f) return juce::String("Off");
+                  return "1:" + juce::String(value, 1);
+              } },
+            { Kind::decimal, "upthreshold", "Up Thresh", {}, Range(thresholdStart, thresholdEnd, thresholdInterval), -40.0f, toDecibels },
+            { Kind::decimal, "upratio", "Up Ratio", {}, Range(upwardRatioStart, upwardRatioEnd, upwardRatioInterval), 1.0f,
+              [](float value)
+              {
+                  if (value <= 1.0f) return juce::String("Off");
+                  return juce::String(value, 1) + ":1";
+              } },
+            { Kind::decimal, "limit", "Limit", {}, Range(limitStart, limitEnd, limitInterval), limitEnd,
+              [](float value)
+              {
+                  if (value >= limitEnd) return juce::String("Off");
+                  return toDecibels(value);
+              } },
+            { Kind::toggle, "midside", "Mid/Side", {}, {}, 0.0f, nullptr },
+            { Kind::toggle, "truepeak", "True Peak", {}, {}, 0.0f, nullptr },
+            { Kind::decimal, "ceiling", "Ceiling", {}, Range(ceilingStart, ceilingEnd, ceilingInterval), -1.0f,
+              [](float value) { return juce::String(value, 1) + " dBTP"; } },
+            { Kind::integer, "link", "Link Group", {}, Range(0.0f, static_cast<float>(DetectorBus::numGroups)), 0.0f,
+              [](float value)
+              {
+                  if (value == 0.0f) return juce::String("Off");
+                  return juce::String(juce::roundToInt(value));
+              } },
+            { Kind::toggle, "adaptive", "Adaptive Quality", {}, {}, 1.0f, nullptr },
+            // Processes on a worker thread with a block of latency, for hosts with large blocks
+            { Kind::toggle, "async", "Async Processing", {}, {}, 0.0f, nullptr },
+            { Kind::decimal, "cpulimit", "CPU Limit", "%", Range(cpuLimitStart, cpuLimitEnd, cpuLimitInterval), 70.0f,
+              [](float value) { return juce::String(value, 0) + " %"; } },
+            // Auto lets the auto tuner pick at every prepare, the rest pin one of its candidates
+            { Kind::integer, "tuning", "Tuning", {}, Range(0.0f, static_cast<float>(CompressorAudioProcessor::getPinnedTunings().size())), 0.0f,
+              [](float value)
+              {
+                  const int index = juce::roundToInt(value);
+                  if (index == 0) return juce::String("Auto");
+                  return AutoTuner::describe(CompressorAudioProcessor::getPinnedTunings()[static_cast<size_t>(index - 1)]);
+              } }
+        };
+        return infos;
+    }
+
+    // Measured once per machine and host block size, then read back from the cache file.
+    // The file is the same for every instance, so only the first one sets it.
+    void setAutoTunerCacheFile()
+    {
+        static const bool isSet = []
+        {
+            const auto directory = juce::File::getSpecialLocation(juce::File::userApplicationDataDirectory)
+                                       .getChildFile("linus_silfver").getChildFile("Compressor");
+            AutoTuner::setCacheFile(directory.getChildFile("AutoTuner.xml"));
+           #if COMPRESSOR_PROFILING
+            CompressorAudioProcessor::setProfileFile(directory.getChildFile("Profile.csv"));
+           #endif
+            return true;
+        }();
+        juce::ignoreUnused(isSet);
+    }
+}
+
+const std::vector<Compressor::Tuning>& CompressorAudioProcessor::getPinnedTunings()
+{
+    // Every tile size up to 2048 samples, larger ones only differ on larger blocks
+    static const auto tunings = AutoTuner::getCandidates(4096);
+    return tunings;
+}
+
+#if COMPRESSOR_PROFILING
+juce::File& CompressorAudioProcessor::getProfileFile()
+{
+    static juce::File file;
+    return file;
+}
+
+void CompressorAudioProcessor::setProfileFile(const juce::File& file)
+{
+    getProfileFile() = file;
+}
+#endif
 
 //==============================================================================
 CompressorAudioProcessor::CompressorAudioProcessor()
@@ -24,15 +180,10 @@ CompressorAudioProcessor::CompressorAudioProcessor()
                         ), parameters(*this, nullptr, "PARAMETERS", createParameterLayout())
                     #endif
 {
-    //Add parameter listener
-    parameters.addParameterListener("inputgain", this);
-    parameters.addParameterListener("makeup", this);
-    parameters.addParameterListener("threshold", this);
-    parameters.addParameterListener("ratio", this);
-    parameters.addParameterListener("knee", this);
-    parameters.addParameterListener("attack", this);
-    parameters.addParameterListener("release", this);
-    parameters.addParameterListener("mix", this);
+    // One listener for every parameter instead of a registration per parameter
+    addListener(this);
+
+    setAutoTunerCacheFile();
 
     gainReduction.set(0.0f);
     currentInput.set(-std::numeric_limits<float>::infinity());
@@ -41,6 +192,13 @@ CompressorAudioProcessor::CompressorAudioProcessor()
 
 CompressorAudioProcessor::~CompressorAudioProcessor()
 {
+    removeListener(this);
+    cancelPendingUpdate();
+
+   #if COMPRESSOR_PROFILING
+    if (getProfileFile() != juce::File() && compressor.getProfiler().getStats(ProcessProfiler::block).numBlocks > 0)
+        compressor.getProfiler().writeCsv(getProfileFile());
+   #endif
 }
 
 //==============================================================================
@@ -83,26 +241,51 @@ double CompressorAudioProcessor::getTailLengthSeconds() const
 
 int CompressorAudioProcessor::getNumPrograms()
 {
-    return 1;   // NB: some hosts don't cope very well if you tell them there are 0 programs,
-                // so this should be at least 1, even if you're not really implementing programs.
+    return presets.getNumPresets();
 }
 
 int CompressorAudioProcessor::getCurrentProgram()
 {
-    return 0;
+    return currentProgram;
 }
 
 void CompressorAudioProcessor::setCurrentProgram (int index)
 {
+    if (! juce::isPositiveAndBelow(index, presets.getNumPresets()))
+        return;
+
+    currentProgram = index;
+
+    // Before prepareToPlay there is no built preset, the parameters then set the compressor one by one
+    auto preset = presets.getPreset(index);
+
+    loadingProgram = preset != nullptr;
+    setParametersFromPreset(presets.getSettings(index));
+    loadingProgram = false;
+
+    if (preset != nullptr)
+        compressor.setPreset(std::move(preset), true);
 }
 
 const juce::String CompressorAudioProcessor::getProgramName (int index)
 {
-    return {};
+    return presets.getName(index);
 }
 
 void CompressorAudioProcessor::changeProgramName (int index, const juce::String& newName)
 {
+    presets.setName(index, newName);
+}
+
+void CompressorAudioProcessor::setParametersFromPreset(const CompressorPreset::Settings& settings)
+{
+    const float values[] = { settings.inputGain, settings.threshold, settings.ratio, settings.knee,
+                             settings.attack, settings.release, settings.makeup, settings.mix };
+    static_assert(std::size(values) == std::size(presetParameterIDs), "One value per preset parameter");
+
+    for (size_t i = 0; i < std::size(values); ++i)
+        if (auto* parameter = parameters.getParameter(presetParameterIDs[i]))
+            parameter->setValueNotifyingHost(parameter->convertTo0to1(values[i]));
 }
 
 //==============================================================================
@@ -112,20 +295,35 @@ void CompressorAudioProcessor::prepareToPlay (double sampleRate, int samplesPerB
     spec.maximumBlockSize = samplesPerBlock;
     spec.numChannels = getTotalNumOutputChannels();
     spec.sampleRate = sampleRate;
-    // Prepare dsp classes
+    // Prepare dsp classes. The auto tuner measures even while a tuning is pinned, so going
+    // back to auto needs no new prepare.
+    compressor.setAutoTune(true);
     compressor.prepare(spec);
+    autoTuning = compressor.getTuning();
+    appliedTuning = -1;
+    updateTuning();
+    compressor.setQuality(Compressor::Quality::full);
+    qualityGovernor.prepare(sampleRate);
+    presets.prepare(sampleRate);
     inLevelFollower.prepare(sampleRate);
     outLevelFollower.prepare(sampleRate);
 
     // Set envelope follower for level meter to measure over 300ms time frame
     inLevelFollower.setPeakDecay(0.3f);
     outLevelFollower.setPeakDecay(0.3f);
+
+    asyncProcessor.prepare(static_cast<int>(spec.numChannels), samplesPerBlock);
+
+    updateMidSide();
+    updateLatency();
+    triggerAsyncUpdate();
 }
 
 void CompressorAudioProcessor::releaseResources()
 {
     // When playback stops, you can use this as an opportunity to free up any
     // spare memory, etc.
+    asyncProcessor.release();
 }
 
 #ifndef JucePlugin_PreferredChannelConfigurations
@@ -156,39 +354,67 @@ bool CompressorAudioProcessor::isBusesLayoutSupported (const BusesLayout& layout
 
 void CompressorAudioProcessor::processBlock (juce::AudioBuffer<float>& buffer, juce::MidiBuffer& midiMessages)
 {
+    COMPRESSOR_REALTIME_SCOPE();
+
     juce::ScopedNoDenormals noDenormals;
     auto totalNumInputChannels = getTotalNumInputChannels();
     auto totalNumOutputChannels = getTotalNumOutputChannels();
-    const auto numSamples = buffer.getNumSamples();
 
     for (auto i = totalNumInputChannels; i < totalNumOutputChannels; ++i)
         buffer.clear (i, 0, buffer.getNumSamples());
 
-    //Update input peak metering
-    inLevelFollower.updatePeak(buffer.getArrayOfReadPointers(), totalNumInputChannels, numSamples);
-    currentInput.set(juce::Decibels::gainToDecibels(inLevelFollower.getPeak()));
+    // Either right here or handed to the worker, which returns the previous block.
+    // A bounce waits for a late worker where playback drops the block.
+    asyncProcessor.setWaitsForWorker(isNonRealtime());
+    asyncProcessor.process(buffer);
+}
+
+void CompressorAudioProcessor::processChain(juce::AudioBuffer<float>& buffer)
+{
+    // The whole block counts against its real-time budget
+    const auto startTicks = juce::Time::getHighResolutionTicks();
+
+    juce::ScopedNoDenormals noDenormals;
+    const auto numSamples = buffer.getNumSamples();
+
+    // Between blocks on the processing thread, where the compressor may change its tuning
+    updateTuning();
 
     // Do compressor processing
     compressor.process(buffer);
 
+    // Update peak metering from the peaks the compressor measured on its passes
+    inLevelFollower.updatePeak(compressor.getInputPeak(), numSamples);
+    currentInput.set(juce::Decibels::gainToDecibels(inLevelFollower.getPeak()));
+    outLevelFollower.updatePeak(compressor.getOutputPeak(), numSamples);
+    currentOutput = juce::Decibels::gainToDecibels(outLevelFollower.getPeak());
+
     // Update gain reduction metering
     gainReduction.set(compressor.getMaxGainReduction());
 
-    // Update output peak metering
-    outLevelFollower.updatePeak(buffer.getArrayOfReadPointers(), totalNumInputChannels, numSamples);
-    currentOutput = juce::Decibels::gainToDecibels(outLevelFollower.getPeak());
+    // The quality for the next block; an offline render has all the time it needs
+    const auto seconds = juce::Time::highResolutionTicksToSeconds(juce::Time::getHighResolutionTicks() - startTicks);
+    const auto quality = qualityGovernor.update(seconds, numSamples);
+    compressor.setQuality(isNonRealtime() ? Compressor::Quality::full : quality);
 }
 
 //==============================================================================
 bool CompressorAudioProcessor::hasEditor() const
 {
+   #if COMPRESSOR_HEADLESS
+    return false;
+   #else
     return true; // (change this to false if you choose to not supply an editor)
+   #endif
 }
 
 juce::AudioProcessorEditor* CompressorAudioProcessor::createEditor()
 {
-    return new juce::GenericAudioProcessorEditor (*this);
-    // return new CompressorAudioProcessorEditor (*this);
+   #if COMPRESSOR_HEADLESS
+    return nullptr;
+   #else
+    return new CompressorAudioProcessorEditor (*this);
+   #endif
 }
 
 //==============================================================================
@@ -205,8 +431,20 @@ void CompressorAudioProcessor::setStateInformation (const void* data, int sizeIn
     // whose contents will have been created by the getStateInformation() call.
 }
 
+void CompressorAudioProcessor::audioProcessorParameterChanged(juce::AudioProcessor*, int parameterIndex, float newValue)
+{
+    // Every parameter comes from the layout, so every one is ranged
+    if (auto* parameter = dynamic_cast<juce::RangedAudioParameter*>(getParameters()[parameterIndex]))
+        parameterChanged(parameter->paramID, parameter->convertFrom0to1(newValue));
+}
+
 void CompressorAudioProcessor::parameterChanged(const juce::String& parameterID, float newValue)
 {
+    // The compressor takes a program's own parameters from the preset. Anything else, e.g. from
+    // the host on another thread while the program loads, still goes through.
+    if (loadingProgram && isPresetParameter(parameterID))
+        return;
+
     if (parameterID == "inputgain") compressor.setInput(newValue);
     else if (parameterID == "threshold") compressor.setThreshold(newValue);
     else if (parameterID == "ratio") compressor.setRatio(newValue);
@@ -215,113 +453,105 @@ void CompressorAudioProcessor::parameterChanged(const juce::String& parameterID,
     else if (parameterID == "release") compressor.setRelease(newValue);
     else if (parameterID == "makeup") compressor.setMakeup(newValue);
     else if (parameterID == "mix") compressor.setMix(newValue);
+    else if (parameterID == "midside") updateMidSide();
+    else if (parameterID == "ceiling") compressor.setCeiling(newValue);
+    else if (parameterID == "adaptive") qualityGovernor.setEnabled(newValue > 0.5f);
+    else if (parameterID == "cpulimit") qualityGovernor.setLoadLimit(newValue * 0.01f);
+    else if (parameterID == "link") compressor.setLinkGroup(juce::roundToInt(newValue));
+    else if (parameterID == "tuning") requestedTuning = juce::roundToInt(newValue);
+    else if (parameterID == "truepeak")
+    {
+        compressor.setTruePeak(newValue > 0.5f);
+        updateLatency();
+    }
+    else if (parameterID == "gate" || parameterID == "expthreshold" || parameterID == "expratio"
+             || parameterID == "upthreshold" || parameterID == "upratio" || parameterID == "limit")
+    {
+        updateCurveSections();
+    }
+
+    // Starting the worker and announcing the latency both belong on the message thread
+    if (parameterID == "threshold" || parameterID == "ratio" || parameterID == "knee" || parameterID == "async")
+        triggerAsyncUpdate();
+}
+
+void CompressorAudioProcessor::updateCurveSections()
+{
+    using namespace GlobalParameters;
+
+    const float limit = *parameters.getRawParameterValue("limit");
+
+    compressor.setGate(*parameters.getRawParameterValue("gate"), Parameter::gateRange);
+    compressor.setExpander(*parameters.getRawParameterValue("expthreshold"), *parameters.getRawParameterValue("expratio"));
+    compressor.setUpward(*parameters.getRawParameterValue("upthreshold"), *parameters.getRawParameterValue("upratio"), Parameter::upwardMaxBoost);
+    compressor.setLimiter(limit < Parameter::limitEnd ? limit : std::numeric_limits<float>::infinity());
+}
+
+void CompressorAudioProcessor::handleAsyncUpdate()
+{
+    compressor.setTransferCurve(curveCache->getCurve(*parameters.getRawParameterValue("threshold"),
+                                                     *parameters.getRawParameterValue("ratio"),
+                                                     *parameters.getRawParameterValue("knee")));
+
+    const bool async = *parameters.getRawParameterValue("async") > 0.5f;
+    if (async != asyncProcessor.isEnabled())
+    {
+        asyncProcessor.setEnabled(async);
+        updateLatency();
+    }
+}
+
+void CompressorAudioProcessor::updateMidSide()
+{
+    compressor.setMidSide(*parameters.getRawParameterValue("midside") > 0.5f
+                          && getTotalNumOutputChannels() >= 2);
+}
+
+void CompressorAudioProcessor::updateTuning()
+{
+    const int index = requestedTuning.load();
+    if (index == appliedTuning)
+        return;
+
+    appliedTuning = index;
+    if (index == 0)
+    {
+        compressor.setTuning(autoTuning);
+        compressor.setAutoTune(true);
+    }
+    else
+    {
+        compressor.setTuning(getPinnedTunings()[static_cast<size_t>(index - 1)]);
+    }
+}
+
+void CompressorAudioProcessor::updateLatency()
+{
+    setLatencySamples(compressor.getLatencyInSamples() + asyncProcessor.getLatencyInSamples());
 }
 
 juce::AudioProcessorValueTreeState::ParameterLayout CompressorAudioProcessor::createParameterLayout() {
     using namespace juce;
-    
-    std::vector<std::unique_ptr<RangedAudioParameter>> params;
+    using Kind = ParameterInfo::Kind;
 
-    params.push_back(std::make_unique<AudioParameterBool>("power", "Power", true));
-
-    params.push_back(std::make_unique<AudioParameterFloat>("inputgain", "Input",
-                                                        NormalisableRange<float>(
-                                                            GlobalParameters::Parameter::inputStart,
-                                                            GlobalParameters::Parameter::inputEnd,
-                                                            GlobalParameters::Parameter::inputInterval), 0.0f,
-                                                        String(),
-                                                        AudioProcessorParameter::genericParameter,
-                                                        [](float value, float)
-                                                        {
-                                                            return String(value, 1) + " dB";
-                                                        }));
-
-
-    params.push_back(std::make_unique<AudioParameterFloat>("threshold", "Tresh",
-                                                        NormalisableRange<float>(
-                                                            GlobalParameters::Parameter::thresholdStart,
-                                                            GlobalParameters::Parameter::thresholdEnd,
-                                                            GlobalParameters::Parameter::thresholdInterval), -10.0f,
-                                                        String(), AudioProcessorParameter::genericParameter,
-                                                        [](float value, float maxStrLen)
-                                                        {
-                                                            return String(value, 1) + " dB";
-                                                        }));
-
-    params.push_back(std::make_unique<AudioParameterFloat>("ratio", "Ratio",
-                                                        NormalisableRange<float>(
-                                                            GlobalParameters::Parameter::ratioStart,
-                                                            GlobalParameters::Parameter::ratioEnd,
-                                                            GlobalParameters::Parameter::ratioInterval, 0.5f), 2.0f,
-                                                        String(), AudioProcessorParameter::genericParameter,
-                                                        [](float value, float)
-                                                        {
-                                                            if (value > 23.9f) return String("Infinity") + ":1";
-                                                            return String(value, 1) + ":1";
-                                                        }));
-
-    params.push_back(std::make_unique<AudioParameterFloat>("knee", "Knee",
-                                                           NormalisableRange<float>(
-                                                                   GlobalParameters::Parameter::kneeStart,
-                                                                   GlobalParameters::Parameter::kneeEnd,
-                                                                   GlobalParameters::Parameter::kneeInterval),
-                                                           6.0f, String(), AudioProcessorParameter::genericParameter,
-                                                           [](float value, float)
-                                                           {
-                                                               return String(value, 1) + " dB";
-                                                           }));
-
-    params.push_back(std::make_unique<AudioParameterFloat>("attack", "Attack",
-                                                        NormalisableRange<float>(
-                                                            GlobalParameters::Parameter::attackStart,
-                                                            GlobalParameters::Parameter::attackEnd,
-                                                            GlobalParameters::Parameter::attackInterval, 0.5f), 2.0f,
-                                                        "ms",
-                                                        AudioProcessorParameter::genericParameter,
-                                                        [](float value, float)
-                                                        {
-                                                            if (value == 100.0f) return String(value, 0) + " ms";
-                                                            return String(value, 2) + " ms";
-                                                        }));
-
-    params.push_back(std::make_unique<AudioParameterFloat>("release", "Release",
-                                                        NormalisableRange<float>(
-                                                            GlobalParameters::Parameter::releaseStart,
-                                                            GlobalParameters::Parameter::releaseEnd,
-                                                            GlobalParameters::Parameter::releaseInterval, 0.35f),
-                                                        140.0f,
-                                                        String(),
-                                                        AudioProcessorParameter::genericParameter,
-                                                        [](float value, float)
-                                                        {
-                                                            if (value <= 100) return String(value, 2) + " ms";
-                                                            if (value >= 1000)
-                                                                return String(value * 0.001f, 2) + " s";
-                                                            return String(value, 1) + " ms";
-                                                        }));
-
-    params.push_back(std::make_unique<AudioParameterFloat>("makeup", "Makeup",
-                                                           NormalisableRange<float>(
-                                                                   GlobalParameters::Parameter::makeupStart,
-                                                                   GlobalParameters::Parameter::makeupEnd,
-                                                                   GlobalParameters::Parameter::makeupInterval), 0.0f,
-                                                           String(),
-                                                           AudioProcessorParameter::genericParameter,
-                                                           [](float value, float)
-                                                           {
-                                                               return String(value, 1) + " dB ";
-                                                           }));
-
-    params.push_back(std::make_unique<AudioParameterFloat>("mix", "Mix",
-                                                        NormalisableRange<float>(
-                                                            GlobalParameters::Parameter::mixStart,
-                                                            GlobalParameters::Parameter::mixEnd,
-                                                            GlobalParameters::Parameter::mixInterval),
-                                                        1.0f, "%", AudioProcessorParameter::genericParameter,
-                                                        [](float value, float)
-                                                        {
-                                                            return String(value * 100.0f, 1) + " %";
-                                                        }));
+    std::vector<std::unique_ptr<RangedAudioParameter>> params;
+    params.reserve(getParameterInfos().size());
+
+    for (const auto& info : getParameterInfos())
+    {
+        const auto toText = info.toText;
+
+        if (info.kind == Kind::toggle)
+            params.push_back(std::make_unique<AudioParameterBool>(info.id, info.name, info.defaultValue > 0.5f));
+        else if (info.kind == Kind::integer)
+            params.push_back(std::make_unique<AudioParameterInt>(info.id, info.name, roundToInt(info.range.start), roundToInt(info.range.end),
+                                                                 roundToInt(info.defaultValue), info.label,
+                                                                 [toText](int value, int) { return toText(static_cast<float>(value)); }));
+        else
+            params.push_back(std::make_unique<AudioParameterFloat>(info.id, info.name, info.range, info.defaultValue, info.label,
+                                                                   AudioProcessorParameter::genericParameter,
+                                                                   [toText](float value, int) { return toText(value); }));
+    }
 
     return {params.begin(), params.end()};
 }
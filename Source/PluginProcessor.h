@@ -10,8 +10,19 @@
 
 #include <JuceHeader.h>
 
+#include "AsyncBlockProcessor.h"
+#include "AutoTuner.h"
 #include "Compressor.h"
+#include "CompressorPreset.h"
 #include "LevelEnvelopeFollower.h"
+#include "QualityGovernor.h"
+#include "RealtimeSafety.h"
+#include "TransferCurve.h"
+
+// Builds the processor without its editor, for a console target such as the test runner
+#ifndef COMPRESSOR_HEADLESS
+ #define COMPRESSOR_HEADLESS 0
+#endif
 
 struct Filters
 {
@@ -27,6 +38,9 @@ public:
     std::array<juce::AudioBuffer<float>, 3> filtersBuffers;
 
     void prepare(const juce::dsp::ProcessSpec& spec) {
+        for (auto& buffer : filtersBuffers)
+            buffer.setSize(static_cast<int>(spec.numChannels), static_cast<int>(spec.maximumBlockSize));
+
         AP.prepare(spec);
         LP1.prepare(spec);
         HP1.prepare(spec);
@@ -41,7 +55,9 @@ public:
         AP.process(fb0Ctx);
 
         HP1.process(fb1Ctx);
-        filtersBuffers[2] = filtersBuffers[1];
+        // Copy into the prepared buffer, assignment would reallocate on the audio thread
+        for (int ch = 0; ch < filtersBuffers[1].getNumChannels(); ++ch)
+            filtersBuffers[2].copyFrom(ch, 0, filtersBuffers[1], ch, 0, filtersBuffers[1].getNumSamples());
         LP2.process(fb1Ctx);
 
         HP2.process(fb2Ctx);
@@ -51,7 +67,8 @@ public:
 //==============================================================================
 /**
 */
-class CompressorAudioProcessor  : public juce::AudioProcessor, public juce::AudioProcessorValueTreeState::Listener
+class CompressorAudioProcessor  : public juce::AudioProcessor, private juce::AudioProcessorListener,
+                                  private juce::AsyncUpdater
 {
 public:
     //==============================================================================
@@ -91,21 +108,89 @@ public:
     void getStateInformation (juce::MemoryBlock& destData) override;
     void setStateInformation (const void* data, int sizeInBytes) override;
 
-    void parameterChanged(const juce::String& parameterID, float newValue) override;
     juce::AudioProcessorValueTreeState::ParameterLayout createParameterLayout();
 
+    juce::AudioProcessorValueTreeState& getValueTreeState() { return parameters; }
+
+#if COMPRESSOR_PROFILING
+    // Per-stage timings of the compressor, for diagnostics on the message thread
+    ProcessProfiler& getProfiler() { return compressor.getProfiler(); }
+
+    // Where each instance writes its stage timings as CSV when it is destroyed, next to the
+    // auto tuner's cache by default. An empty file writes nothing.
+    static void setProfileFile(const juce::File&);
+#endif
+
+    // Quality the compressor runs at under the current CPU load, for the editor and diagnostics
+    const QualityGovernor& getQualityGovernor() const { return qualityGovernor; }
+
+    // Tile size and kernel the compressor runs with, picked by the auto tuner at the last
+    // prepare unless the "tuning" parameter pins one, for the editor and diagnostics
+    Compressor::Tuning getCompressorTuning() const { return compressor.getTuning(); }
+
+    // The tunings the "tuning" parameter pins, its value 1 being the first; 0 is auto
+    static const std::vector<Compressor::Tuning>& getPinnedTunings();
+
     //==============================================================================
     juce::Atomic<float> gainReduction;
     juce::Atomic<float> currentInput;
     juce::Atomic<float> currentOutput;
 
 private:
+    // Every parameter's changes, from the host, the editor or a program, come through here
+    void audioProcessorParameterChanged(juce::AudioProcessor*, int parameterIndex, float newValue) override;
+    void audioProcessorChanged(juce::AudioProcessor*, const ChangeDetails&) override {}
+
+    void parameterChanged(const juce::String& parameterID, float newValue);
+
+    // Fetches the shared transfer curve for the current settings on the message thread,
+    // and starts the worker when the async mode was switched on
+    void handleAsyncUpdate() override;
+
+    // Everything processBlock does to a block, on the worker thread in async mode
+    void processChain(juce::AudioBuffer<float>&);
+
+    // Mid/side needs a stereo pair, so a mono layout ignores the parameter
+    void updateMidSide();
+
+    // The true peak limiter's delay plus the async mode's block
+    void updateLatency();
+
+    // Switches the compressor to the tuning the parameter asks for, on the thread that
+    // prepares or processes, never while a block is processed
+    void updateTuning();
+
+    // Gate, expander, upward compressor and limiter depend on more than one parameter each
+    void updateCurveSections();
+
+    // Moves the parameters to a program's settings, which notifies the host and the editor
+    void setParametersFromPreset(const CompressorPreset::Settings&);
+
+#if COMPRESSOR_PROFILING
+    static juce::File& getProfileFile();
+#endif
+
     //==============================================================================
     juce::AudioProcessorValueTreeState parameters;
+    juce::SharedResourcePointer<TransferCurveCache> curveCache;
     Compressor compressor;
+    QualityGovernor qualityGovernor;
+    PresetBank presets;
+    int currentProgram{ 0 };
+
+    // Set while a program is loaded, the compressor gets its settings from the preset
+    std::atomic<bool> loadingProgram{ false };
+
+    // The "tuning" parameter's value, the tuning the compressor has and what auto picked
+    std::atomic<int> requestedTuning{ 0 };
+    int appliedTuning{ -1 };
+    Compressor::Tuning autoTuning;
     LevelEnvelopeFollower inLevelFollower;
     LevelEnvelopeFollower outLevelFollower;
 
+    // Last, so its worker stops before anything processChain uses is destroyed
+    AsyncBlockProcessor asyncProcessor{ [this](juce::AudioBuffer<float>& block) { processChain(block); } };
+
     // Filters filters;
 
     //==============================================================================
@@ -0,0 +1,227 @@
+/*
+  ==============================================================================
+
+    ProcessProfiler.h
+    Created: 19 Oct 2026 11:02:17am
+    Author:  Linus
+
+  ==============================================================================
+*/
+
+#pragma once
+#include <array>
+#include <atomic>
+#include <JuceHeader.h>
+
+// Set to 1 (e.g. in the Projucer preprocessor definitions, as the test runner's
+// Profiling configuration does) to time every stage of Compressor::process and of its
+// offline renders. When 0 the profiler and all timing calls are compiled out.
+#ifndef COMPRESSOR_PROFILING
+ #define COMPRESSOR_PROFILING 0
+#endif
+
+// Per-instance, lock-free timing counters for the stages of Compressor::process.
+// Written once per block by the thread that processes it, readable from any thread.
+class ProcessProfiler
+{
+public:
+    enum Stage
+    {
+        inputGain = 0,
+        sidechain,
+        gainComputer,
+        ballistics,
+        gainConversion,
+        mix,
+        truePeak,
+        preRoll,            // Offline: warming segments' detectors up
+        segments,           // Offline: rendering segments from their detectors
+        block,              // The whole call to process, or to an offline render
+        numStages
+    };
+
+    struct StageStats
+    {
+        double averageNanoseconds;
+        double worstNanoseconds;
+        juce::uint64 numBlocks;
+    };
+
+    ProcessProfiler() = default;
+
+    StageStats getStats(Stage stage) const noexcept
+    {
+        const auto& c = counters[stage];
+        const auto numBlocks = c.numBlocks.load(std::memory_order_relaxed);
+        const auto total = ticksToNanoseconds(c.totalTicks.load(std::memory_order_relaxed));
+        return { numBlocks > 0 ? total / static_cast<double>(numBlocks) : 0.0,
+                 ticksToNanoseconds(c.worstTicks.load(std::memory_order_relaxed)),
+                 numBlocks };
+    }
+
+    // Not synchronised with the audio thread, a block in flight may be half counted
+    void reset() noexcept
+    {
+        for (auto& c : counters)
+        {
+            c.totalTicks.store(0, std::memory_order_relaxed);
+            c.worstTicks.store(0, std::memory_order_relaxed);
+            c.numBlocks.store(0, std::memory_order_relaxed);
+        }
+    }
+
+    static const char* getStageName(Stage stage) noexcept
+    {
+        static const char* const names[] = { "input gain", "sidechain", "gain computer", "ballistics",
+                                             "gain conversion", "mix", "true peak", "pre-roll", "segments", "block" };
+        return names[stage];
+    }
+
+    // Adds another profiler's blocks to these, e.g. to total a pool of instances
+    void merge(const ProcessProfiler& other) noexcept
+    {
+        for (size_t i = 0; i < counters.size(); ++i)
+        {
+            auto& c = counters[i];
+            const auto& o = other.counters[i];
+            c.totalTicks.store(c.totalTicks.load(std::memory_order_relaxed) + o.totalTicks.load(std::memory_order_relaxed), std::memory_order_relaxed);
+            c.numBlocks.store(c.numBlocks.load(std::memory_order_relaxed) + o.numBlocks.load(std::memory_order_relaxed), std::memory_order_relaxed);
+            c.worstTicks.store(juce::jmax(c.worstTicks.load(std::memory_order_relaxed), o.worstTicks.load(std::memory_order_relaxed)), std::memory_order_relaxed);
+        }
+    }
+
+    // One line per stage: name, average ns, worst ns, number of blocks
+    juce::String toCsv() const
+    {
+        juce::String csv("stage,average_ns,worst_ns,blocks\n");
+        for (int i = 0; i < numStages; ++i)
+        {
+            const auto stats = getStats(static_cast<Stage>(i));
+            csv << getStageName(static_cast<Stage>(i)) << "," << stats.averageNanoseconds << ","
+                << stats.worstNanoseconds << "," << static_cast<juce::int64>(stats.numBlocks) << "\n";
+        }
+        return csv;
+    }
+
+    // Saves toCsv to the file, creating its directory; false if it can't be written
+    bool writeCsv(const juce::File& file) const
+    {
+        file.getParentDirectory().createDirectory();
+        return file.replaceWithText(toCsv());
+    }
+
+    class ScopedStage;
+
+    // Times one call to process and collects the time its stages take, which reach the
+    // counters together as the scope ends: every stage the call ran counts one block,
+    // however many tiles, renders or chain stages ran it. A nested block of the same
+    // profiler joins the outer one. Stages count only inside a block on their own
+    // thread, so those of a thread pool's workers are not timed one by one.
+    class ScopedBlock
+    {
+    public:
+        explicit ScopedBlock(ProcessProfiler& p) noexcept
+            : profiler(p), previous(current), start(juce::Time::getHighResolutionTicks())
+        {
+            if (! joinsPrevious())
+                current = this;
+        }
+
+        ~ScopedBlock() noexcept
+        {
+            if (joinsPrevious())
+                return;
+
+            add(block, juce::Time::getHighResolutionTicks() - start);
+            profiler.commit(ticks, timed);
+            current = previous;
+        }
+
+    private:
+        friend class ScopedStage;
+
+        bool joinsPrevious() const noexcept { return previous != nullptr && &previous->profiler == &profiler; }
+
+        void add(Stage stage, juce::int64 stageTicks) noexcept
+        {
+            ticks[stage] += static_cast<juce::uint64>(stageTicks);
+            timed[stage] = true;
+        }
+
+        // The block in progress on this thread
+        static inline thread_local ScopedBlock* current = nullptr;
+
+        ProcessProfiler& profiler;
+        ScopedBlock* const previous;
+        const juce::int64 start;
+        std::array<juce::uint64, numStages> ticks{};
+        std::array<bool, numStages> timed{};
+
+        JUCE_DECLARE_NON_COPYABLE(ScopedBlock)
+    };
+
+    // Times the enclosing scope as the given stage of the block in progress
+    class ScopedStage
+    {
+    public:
+        ScopedStage(ProcessProfiler& p, Stage s) noexcept
+            : profiler(p), stage(s), start(juce::Time::getHighResolutionTicks()) {}
+
+        ~ScopedStage() noexcept
+        {
+            auto* block = ScopedBlock::current;
+            if (block != nullptr && &block->profiler == &profiler)
+                block->add(stage, juce::Time::getHighResolutionTicks() - start);
+        }
+
+    private:
+        ProcessProfiler& profiler;
+        const Stage stage;
+        const juce::int64 start;
+
+        JUCE_DECLARE_NON_COPYABLE(ScopedStage)
+    };
+
+private:
+    // One block's time in each stage it ran
+    void commit(const std::array<juce::uint64, numStages>& ticks, const std::array<bool, numStages>& timed) noexcept
+    {
+        for (size_t i = 0; i < counters.size(); ++i)
+        {
+            if (! timed[i])
+                continue;
+
+            auto& c = counters[i];
+            c.totalTicks.store(c.totalTicks.load(std::memory_order_relaxed) + ticks[i], std::memory_order_relaxed);
+            c.numBlocks.store(c.numBlocks.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+            if (ticks[i] > c.worstTicks.load(std::memory_order_relaxed))
+                c.worstTicks.store(ticks[i], std::memory_order_relaxed);
+        }
+    }
+
+    static double ticksToNanoseconds(juce::uint64 ticks) noexcept
+    {
+        return juce::Time::highResolutionTicksToSeconds(static_cast<juce::int64>(ticks)) * 1.0e9;
+    }
+
+    struct Counters
+    {
+        std::atomic<juce::uint64> totalTicks{ 0 };
+        std::atomic<juce::uint64> worstTicks{ 0 };
+        std::atomic<juce::uint64> numBlocks{ 0 };
+    };
+
+    std::array<Counters, numStages> counters;
+
+    JUCE_DECLARE_NON_COPYABLE(ProcessProfiler)
+};
+
+#if COMPRESSOR_PROFILING
+ #define COMPRESSOR_PROFILE_BLOCK(profiler) \
+    const ProcessProfiler::ScopedBlock JUCE_JOIN_MACRO(profiledBlock, __LINE__)(profiler)
+ #define COMPRESSOR_PROFILE_STAGE(profiler, stage) \
+    const ProcessProfiler::ScopedStage JUCE_JOIN_MACRO(profiledStage, __LINE__)(profiler, ProcessProfiler::stage)
+#else
+ #define COMPRESSOR_PROFILE_BLOCK(profiler)
+ #define COMPRESSOR_PROFILE_STAGE(profiler, stage)
+#endif
@@ -0,0 +1,149 @@
+/*
+  ==============================================================================
+
+    QualityGovernor.cpp
+    Created: 23 Oct 2026 3:44:02pm
+    Author:  Linus
+
+  ==============================================================================
+*/
+
+#include "QualityGovernor.h"
+#include <cmath>
+
+void QualityGovernor::prepare(double newSampleRate)
+{
+    sampleRate = newSampleRate;
+    smoothedLoad = 0.0;
+    sinceChange = settleTime;
+    sinceStepUp = maxHoldTime;
+    belowFor = 0.0;
+    holdTime = initialHoldTime;
+    level = 0;
+
+    currentQuality = 0;
+    load = 0.0f;
+    peakLoad = 0.0f;
+    for (int i = 0; i < Compressor::numQualities; ++i)
+    {
+        numBlocks[static_cast<size_t>(i)] = 0;
+        numEntered[static_cast<size_t>(i)] = 0;
+    }
+}
+
+void QualityGovernor::setLoadLimit(float limit)
+{
+    loadLimit = limit;
+}
+
+void QualityGovernor::setEnabled(bool shouldBeEnabled)
+{
+    enabled = shouldBeEnabled;
+}
+
+QualityGovernor::Quality QualityGovernor::update(double seconds, int numSamples)
+{
+    if (numSamples <= 0 || sampleRate <= 0.0)
+        return static_cast<Quality>(level);
+
+    const double duration = static_cast<double>(numSamples) / sampleRate;
+    const double blockLoad = seconds / duration;
+
+    // One-pole in audio time, so the response doesn't depend on the block size
+    smoothedLoad += (blockLoad - smoothedLoad) * (1.0 - std::exp(-duration / smoothingTime));
+    sinceChange += duration;
+    sinceStepUp += duration;
+
+    numBlocks[static_cast<size_t>(level)].fetch_add(1, std::memory_order_relaxed);
+
+    const double limit = loadLimit.load(std::memory_order_relaxed);
+    const bool overloaded = smoothedLoad > limit || blockLoad > 1.0;
+
+    if (! enabled.load(std::memory_order_relaxed))
+    {
+        level = 0;
+        belowFor = 0.0;
+    }
+    else if (overloaded && level < Compressor::numQualities - 1)
+    {
+        // Give the smoothed load time to show what the last step did
+        if (sinceChange >= settleTime)
+        {
+            if (sinceStepUp < 2.0 * holdTime)
+                holdTime = juce::jmin(2.0 * holdTime, maxHoldTime);
+
+            ++level;
+            numEntered[static_cast<size_t>(level)].fetch_add(1, std::memory_order_relaxed);
+            sinceChange = 0.0;
+            belowFor = 0.0;
+        }
+    }
+    else if (smoothedLoad < 0.5 * limit && level > 0)
+    {
+        belowFor += duration;
+        if (belowFor >= holdTime)
+        {
+            --level;
+            sinceChange = 0.0;
+            sinceStepUp = 0.0;
+            belowFor = 0.0;
+        }
+    }
+    else
+    {
+        belowFor = 0.0;
+    }
+
+    currentQuality.store(level, std::memory_order_relaxed);
+    load.store(static_cast<float>(smoothedLoad), std::memory_order_relaxed);
+    if (blockLoad > peakLoad.load(std::memory_order_relaxed))
+        peakLoad.store(static_cast<float>(blockLoad), std::memory_order_relaxed);
+
+    return static_cast<Quality>(level);
+}
+
+QualityGovernor::Quality QualityGovernor::getQuality() const
+{
+    return static_cast<Quality>(currentQuality.load(std::memory_order_relaxed));
+}
+
+float QualityGovernor::getLoad() const
+{
+    return load.load(std::memory_order_relaxed);
+}
+
+float QualityGovernor::getPeakLoad() const
+{
+    return peakLoad.load(std::memory_order_relaxed);
+}
+
+int QualityGovernor::getNumStepDowns() const
+{
+    juce::uint64 total = 0;
+    for (const auto& entered : numEntered)
+        total += entered.load(std::memory_order_relaxed);
+    return static_cast<int>(total);
+}
+
+juce::uint64 QualityGovernor::getNumBlocks(Quality quality) const
+{
+    return numBlocks[static_cast<size_t>(quality)].load(std::memory_order_relaxed);
+}
+
+const char* QualityGovernor::getQualityName(Quality quality)
+{
+    static const char* const names[] = { "full", "approximate", "decimated" };
+    return names[static_cast<int>(quality)];
+}
+
+juce::String QualityGovernor::toCsv() const
+{
+    juce::String csv("quality,blocks,stepped_down_to\n");
+    for (int i = 0; i < Compressor::numQualities; ++i)
+    {
+        const auto quality = static_cast<Quality>(i);
+        csv << getQualityName(quality) << "," << static_cast<juce::int64>(getNumBlocks(quality)) << ","
+            << static_cast<juce::int64>(numEntered[static_cast<size_t>(i)].load(std::memory_order_relaxed)) << "\n";
+    }
+    return csv;
+}
@@ -0,0 +1,82 @@
+/*
+  ==============================================================================
+
+    QualityGovernor.h
+    Created: 23 Oct 2026 3:41:19pm
+    Author:  Linus
+
+  ==============================================================================
+*/
+
+#pragma once
+#include <array>
+#include <atomic>
+#include <JuceHeader.h>
+#include "Compressor.h"
+
+// Steps the compressor down through its cheaper qualities when processBlock runs
+// short of its real-time budget, and back up once there is headroom again.
+// The load of a block is the time it took over its own duration. The governor steps
+// down a level when the smoothed load goes over the limit or a block misses its
+// deadline, and up after holding under half the limit for a while. Every step down
+// soon after a step up doubles that hold time, so a borderline load doesn't flap.
+// update runs on the audio thread, everything else is safe from any thread.
+class QualityGovernor
+{
+public:
+    using Quality = Compressor::Quality;
+
+    QualityGovernor() = default;
+
+    // Back to full quality with the initial hold time. Not from the audio thread.
+    void prepare(double sampleRate);
+
+    // Fraction of the block duration processing may take, e.g. 0.7
+    void setLoadLimit(float);
+
+    // Disabled, update always answers full quality
+    void setEnabled(bool);
+
+    // Records the time one block of numSamples took and returns the quality for the next
+    Quality update(double seconds, int numSamples);
+
+    Quality getQuality() const;
+
+    // Smoothed and worst load since prepare, 1 is the whole budget
+    float getLoad() const;
+    float getPeakLoad() const;
+
+    int getNumStepDowns() const;
+
+    // Blocks rendered at a quality since prepare
+    juce::uint64 getNumBlocks(Quality) const;
+
+    static const char* getQualityName(Quality);
+
+    // One line per quality: name, blocks rendered at it, times it was stepped down to
+    juce::String toCsv() const;
+
+    // Timing constants, in seconds of audio
+    static constexpr double smoothingTime = 0.1;
+    static constexpr double settleTime = 0.25;          // No step after a change for this long
+    static constexpr double initialHoldTime = 2.0;
+    static constexpr double maxHoldTime = 32.0;
+
+private:
+    // Audio thread state
+    double sampleRate{ 44100.0 };
+    double smoothedLoad{ 0.0 };
+    double sinceChange{ 0.0 }, sinceStepUp{ 0.0 }, belowFor{ 0.0 };
+    double holdTime{ initialHoldTime };
+    int level{ 0 };
+
+    std::atomic<float> loadLimit{ 0.7f };
+    std::atomic<bool> enabled{ true };
+
+    // Published for the editor and the stats
+    std::atomic<int> currentQuality{ 0 };
+    std::atomic<float> load{ 0.0f }, peakLoad{ 0.0f };
+    std::array<std::atomic<juce::uint64>, Compressor::numQualities> numBlocks{}, numEntered{};
+
+    JUCE_DECLARE_NON_COPYABLE(QualityGovernor)
+};
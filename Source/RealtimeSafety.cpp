@@ -0,0 +1,291 @@
+/*
+  ==============================================================================
+
+    RealtimeSafety.cpp
+    Created: 21 Oct 2026 2:19:31pm
+    Author:  Linus
+
+  ==============================================================================
+*/
+
+#include "RealtimeSafety.h"
+#include <cstdio>
+#include <cstdlib>
+#include <new>
+
+#if COMPRESSOR_REALTIME_CHECKS && defined (__GLIBC__)
+ #include <cerrno>
+ #include <dlfcn.h>
+ #include <pthread.h>
+#endif
+
+namespace
+{
+    struct ThreadState
+    {
+        int audioDepth{ 0 };
+        int suspendDepth{ 0 };
+    };
+
+    // Read from inside malloc, so it must never allocate itself: initial-exec TLS
+    // is part of the static TLS block, even when built into a shared library
+   #if defined (__GNUC__) && ! defined (__APPLE__)
+    __attribute__((tls_model("initial-exec")))
+   #endif
+    thread_local ThreadState threadState;
+}
+
+std::atomic<RealtimeSafety::FailureMode> RealtimeSafety::failureMode{ RealtimeSafety::FailureMode::abortWithBacktrace };
+std::atomic<int> RealtimeSafety::numViolations{ 0 };
+
+void RealtimeSafety::setFailureMode(FailureMode mode)
+{
+    failureMode = mode;
+}
+
+int RealtimeSafety::getNumViolations()
+{
+    return numViolations.load();
+}
+
+void RealtimeSafety::resetViolations()
+{
+    numViolations = 0;
+}
+
+bool RealtimeSafety::isAudioThread()
+{
+    return threadState.audioDepth > 0;
+}
+
+void RealtimeSafety::reportViolation(const char* what)
+{
+    auto& state = threadState;
+    if (state.audioDepth == 0 || state.suspendDepth > 0)
+        return;
+
+    // Reporting allocates, which must not report again
+    const ScopedSuspend suspend;
+    ++numViolations;
+
+    if (failureMode.load() == FailureMode::count)
+        return;
+
+    std::fprintf(stderr, "Real-time safety violation: %s on the audio thread\n%s\n",
+                 what, juce::SystemStats::getStackBacktrace().toRawUTF8());
+    std::fflush(stderr);
+    std::abort();
+}
+
+RealtimeSafety::ScopedAudioThread::ScopedAudioThread()
+{
+    ++threadState.audioDepth;
+}
+
+RealtimeSafety::ScopedAudioThread::~ScopedAudioThread()
+{
+    --threadState.audioDepth;
+}
+
+RealtimeSafety::ScopedSuspend::ScopedSuspend()
+{
+    ++threadState.suspendDepth;
+}
+
+RealtimeSafety::ScopedSuspend::~ScopedSuspend()
+{
+    --threadState.suspendDepth;
+}
+
+#if COMPRESSOR_REALTIME_CHECKS
+ #if defined (__GLIBC__)
+
+//==============================================================================
+// glibc: interpose the C allocator, which operator new, juce::HeapBlock and
+// AudioBuffer all end up in, and the pthread mutex entry points behind
+// std::mutex and juce::CriticalSection.
+extern "C"
+{
+    void* __libc_malloc(size_t);
+    void* __libc_calloc(size_t, size_t);
+    void* __libc_realloc(void*, size_t);
+    void* __libc_memalign(size_t, size_t);
+    void __libc_free(void*);
+
+    void* malloc(size_t size) noexcept
+    {
+        RealtimeSafety::reportViolation("malloc");
+        return __libc_malloc(size);
+    }
+
+    void* calloc(size_t count, size_t size) noexcept
+    {
+        RealtimeSafety::reportViolation("calloc");
+        return __libc_calloc(count, size);
+    }
+
+    void* realloc(void* ptr, size_t size) noexcept
+    {
+        RealtimeSafety::reportViolation("realloc");
+        return __libc_realloc(ptr, size);
+    }
+
+    void* memalign(size_t alignment, size_t size) noexcept
+    {
+        RealtimeSafety::reportViolation("memalign");
+        return __libc_memalign(alignment, size);
+    }
+
+    void* aligned_alloc(size_t alignment, size_t size) noexcept
+    {
+        RealtimeSafety::reportViolation("aligned_alloc");
+        return __libc_memalign(alignment, size);
+    }
+
+    int posix_memalign(void** result, size_t alignment, size_t size) noexcept
+    {
+        RealtimeSafety::reportViolation("posix_memalign");
+        *result = __libc_memalign(alignment, size);
+        return *result != nullptr ? 0 : ENOMEM;
+    }
+
+    void free(void* ptr) noexcept
+    {
+        if (ptr != nullptr)
+            RealtimeSafety::reportViolation("free");
+        __libc_free(ptr);
+    }
+}
+
+namespace
+{
+    using MutexFunction = int (*)(pthread_mutex_t*);
+
+    // Constant-initialised, so they are null rather than unset when another translation
+    // unit's static constructors lock first
+    std::atomic<MutexFunction> realMutexLock{ nullptr };
+    std::atomic<MutexFunction> realMutexTryLock{ nullptr };
+
+    // Looks the real function up on first use. A lookup on the audio thread may allocate,
+    // which is the checker's own doing and not reported; without a real function there is
+    // nothing safe to lock with, so that ends the process with a message.
+    MutexFunction getReal(std::atomic<MutexFunction>& real, const char* name)
+    {
+        auto function = real.load(std::memory_order_acquire);
+        if (function == nullptr)
+        {
+            const RealtimeSafety::ScopedSuspend suspend;
+            function = reinterpret_cast<MutexFunction>(dlsym(RTLD_NEXT, name));
+            if (function == nullptr)
+            {
+                std::fprintf(stderr, "Real-time safety checks: %s could not be resolved\n", name);
+                std::abort();
+            }
+            real.store(function, std::memory_order_release);
+        }
+        return function;
+    }
+}
+
+extern "C"
+{
+    int pthread_mutex_lock(pthread_mutex_t* mutex) noexcept
+    {
+        RealtimeSafety::reportViolation("pthread_mutex_lock");
+        return getReal(realMutexLock, "pthread_mutex_lock")(mutex);
+    }
+
+    // A try-lock never blocks, but finding it on the audio thread usually means a lock nearby does
+    int pthread_mutex_trylock(pthread_mutex_t* mutex) noexcept
+    {
+        RealtimeSafety::reportViolation("pthread_mutex_trylock");
+        return getReal(realMutexTryLock, "pthread_mutex_trylock")(mutex);
+    }
+}
+
+ #else
+
+//==============================================================================
+// Elsewhere only the C++ allocation functions can be replaced portably
+namespace
+{
+    void* allocate(std::size_t size, const char* what)
+    {
+        RealtimeSafety::reportViolation(what);
+        return std::malloc(size == 0 ? 1 : size);
+    }
+
+    void* allocateAligned(std::size_t size, std::align_val_t alignment, const char* what)
+    {
+        RealtimeSafety::reportViolation(what);
+        const auto align = static_cast<std::size_t>(alignment);
+       #if JUCE_WINDOWS
+        return _aligned_malloc(size == 0 ? 1 : size, align);
+       #else
+        return std::aligned_alloc(align, (size + align - 1) / align * align);
+       #endif
+    }
+
+    void deallocate(void* ptr)
+    {
+        if (ptr != nullptr)
+            RealtimeSafety::reportViolation("operator delete");
+        std::free(ptr);
+    }
+
+    void deallocateAligned(void* ptr)
+    {
+        if (ptr != nullptr)
+            RealtimeSafety::reportViolation("operator delete");
+       #if JUCE_WINDOWS
+        _aligned_free(ptr);
+       #else
+        std::free(ptr);
+       #endif
+    }
+}
+
+void* operator new(std::size_t size)
+{
+    if (auto* ptr = allocate(size, "operator new"))
+        return ptr;
+    throw std::bad_alloc();
+}
+
+void* operator new[](std::size_t size)
+{
+    if (auto* ptr = allocate(size, "operator new[]"))
+        return ptr;
+    throw std::bad_alloc();
+}
+
+void* operator new(std::size_t size, const std::nothrow_t&) noexcept      { return allocate(size, "operator new"); }
+void* operator new[](std::size_t size, const std::nothrow_t&) noexcept    { return allocate(size, "operator new[]"); }
+
+void* operator new(std::size_t size, std::align_val_t alignment)
+{
+    if (auto* ptr = allocateAligned(size, alignment, "operator new"))
+        return ptr;
+    throw std::bad_alloc();
+}
+
+void* operator new[](std::size_t size, std::align_val_t alignment)
+{
+    if (auto* ptr = allocateAligned(size, alignment, "operator new[]"))
+        return ptr;
+    throw std::bad_alloc();
+}
+
+void operator delete(void* ptr) noexcept                                   { deallocate(ptr); }
+void operator delete[](void* ptr) noexcept                                 { deallocate(ptr); }
+void operator delete(void* ptr, std::size_t) noexcept                      { deallocate(ptr); }
+void operator delete[](void* ptr, std::size_t) noexcept                    { deallocate(ptr); }
+void operator delete(void* ptr, const std::nothrow_t&) noexcept            { deallocate(ptr); }
+void operator delete[](void* ptr, const std::nothrow_t&) noexcept          { deallocate(ptr); }
+void operator delete(void* ptr, std::align_val_t) noexcept                 { deallocateAligned(ptr); }
+void operator delete[](void* ptr, std::align_val_t) noexcept               { deallocateAligned(ptr); }
+void operator delete(void* ptr, std::size_t, std::align_val_t) noexcept    { deallocateAligned(ptr); }
+void operator delete[](void* ptr, std::size_t, std::align_val_t) noexcept  { deallocateAligned(ptr); }
+
+ #endif
+#endif
@@ -0,0 +1,75 @@
+/*
+  ==============================================================================
+
+    RealtimeSafety.h
+    Created: 21 Oct 2026 2:18:55pm
+    Author:  Linus
+
+  ==============================================================================
+*/
+
+#pragma once
+#include <atomic>
+#include <JuceHeader.h>
+
+// Set to 1 (e.g. in the Projucer preprocessor definitions of a Debug build) to fail
+// on heap allocations and mutex locks while the audio callback is on the stack.
+// When 0 the checker and all scopes are compiled out.
+#ifndef COMPRESSOR_REALTIME_CHECKS
+ #define COMPRESSOR_REALTIME_CHECKS 0
+#endif
+
+// Debug checker for real-time safety. While a ScopedAudioThread is alive on a thread,
+// malloc/calloc/realloc/free and their aligned variants, and pthread mutex locks, are
+// reported as violations. Interception of the C allocator and of mutexes needs glibc;
+// elsewhere only operator new and delete are checked.
+class RealtimeSafety
+{
+public:
+    enum class FailureMode
+    {
+        abortWithBacktrace,     // Print what happened and where, then abort
+        count                   // Only count, for tests that provoke violations on purpose
+    };
+
+    static void setFailureMode(FailureMode);
+
+    static int getNumViolations();
+    static void resetViolations();
+
+    // Called by the interceptors, does nothing unless this thread is in an audio scope
+    static void reportViolation(const char* what);
+
+    static bool isAudioThread();
+
+    // Marks the current thread as running the audio callback. Scopes nest.
+    class ScopedAudioThread
+    {
+    public:
+        ScopedAudioThread();
+        ~ScopedAudioThread();
+
+        JUCE_DECLARE_NON_COPYABLE(ScopedAudioThread)
+    };
+
+    // Temporarily allows everything, e.g. for a deliberate allocation in a debug path
+    class ScopedSuspend
+    {
+    public:
+        ScopedSuspend();
+        ~ScopedSuspend();
+
+        JUCE_DECLARE_NON_COPYABLE(ScopedSuspend)
+    };
+
+private:
+    static std::atomic<FailureMode> failureMode;
+    static std::atomic<int> numViolations;
+};
+
+#if COMPRESSOR_REALTIME_CHECKS
+ #define COMPRESSOR_REALTIME_SCOPE() \
+    const RealtimeSafety::ScopedAudioThread JUCE_JOIN_MACRO(realtimeScope, __LINE__)
+#else
+ #define COMPRESSOR_REALTIME_SCOPE()
+#endif
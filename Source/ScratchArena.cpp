@@ -0,0 +1,159 @@
+/*
+  ==============================================================================
+
+    ScratchArena.cpp
+    Created: 20 Oct 2026 10:05:33am
+    Author:  Linus
+
+  ==============================================================================
+*/
+
+#include "ScratchArena.h"
+#include <new>
+#include <thread>
+
+thread_local ScratchArena::Scope::State* ScratchArena::Scope::activeStates = nullptr;
+
+ScratchArena::ScratchArena(int requestedSlots)
+{
+    // Slabs are held per block, so only threads processing at the same time compete
+    numSlots = requestedSlots > 0 ? requestedSlots
+                                  : juce::jmax(16, 2 * static_cast<int>(std::thread::hardware_concurrency()));
+    slots.reset(new Slot[static_cast<size_t>(numSlots)]);
+}
+
+ScratchArena::~ScratchArena() = default;
+
+ScratchArena::Slab::Slab(size_t numFloats)
+    : data(static_cast<float*>(::operator new[](numFloats * sizeof(float), std::align_val_t(alignment)))),
+      capacity(numFloats)
+{
+}
+
+ScratchArena::Slab::~Slab()
+{
+    ::operator delete[](data, std::align_val_t(alignment));
+}
+
+size_t ScratchArena::getAlignedSize(size_t numFloats)
+{
+    constexpr size_t floatsPerLine = alignment / sizeof(float);
+    return (numFloats + floatsPerLine - 1) / floatsPerLine * floatsPerLine;
+}
+
+void ScratchArena::reserve(size_t numFloats)
+{
+    const juce::ScopedLock sl(reserveLock);
+
+    freeRetiredSlabs();
+
+    if (numFloats <= capacity)
+        return;
+
+    capacity = numFloats;
+    slabs.resize(static_cast<size_t>(numSlots));
+
+    for (int i = 0; i < numSlots; ++i)
+    {
+        auto& slot = slots[i];
+        auto slab = std::make_unique<Slab>(capacity);
+        slot.slab.store(slab.get(), std::memory_order_release);
+        std::swap(slab, slabs[static_cast<size_t>(i)]);
+
+        // A thread inside a block may still be writing to the slab it borrowed
+        if (slab != nullptr)
+            retiredSlabs.push_back({ std::move(slab), &slot });
+    }
+
+    freeRetiredSlabs();
+}
+
+int ScratchArena::getNumRetiredSlabs() const
+{
+    const juce::ScopedLock sl(reserveLock);
+    return static_cast<int>(retiredSlabs.size());
+}
+
+void ScratchArena::freeRetiredSlabs()
+{
+    for (auto it = retiredSlabs.begin(); it != retiredSlabs.end();)
+    {
+        auto& slot = *it->slot;
+        if (slot.inUse.exchange(true, std::memory_order_acquire))
+        {
+            ++it;
+            continue;
+        }
+
+        it = retiredSlabs.erase(it);
+        slot.inUse.store(false, std::memory_order_release);
+    }
+}
+
+ScratchArena::Slot* ScratchArena::claimSlot()
+{
+    for (int i = 0; i < numSlots; ++i)
+        if (! slots[i].inUse.load(std::memory_order_relaxed)
+            && ! slots[i].inUse.exchange(true, std::memory_order_acquire))
+            return &slots[i];
+
+    return nullptr;
+}
+
+ScratchArena::Scope::Scope(ScratchArena& arena)
+{
+    state = activeStates;
+    while (state != nullptr && state->arena != &arena)
+        state = state->next;
+
+    if (state == nullptr)
+    {
+        state = &outermost;
+        state->arena = &arena;
+        state->slot = arena.claimSlot();
+
+        // With more threads than slots inside a block at once, this one neither waits
+        // for a slot nor allocates on the audio thread: it gets no memory, and its
+        // allocations return nullptr
+        if (state->slot != nullptr)
+        {
+            const auto* slab = state->slot->slab.load(std::memory_order_acquire);
+            jassert(slab != nullptr); // reserve was never called
+            state->data = slab != nullptr ? slab->data : nullptr;
+            state->capacity = slab != nullptr ? slab->capacity : 0;
+        }
+
+        state->next = activeStates;
+        activeStates = state;
+    }
+
+    previousOffset = state->offset;
+}
+
+ScratchArena::Scope::~Scope()
+{
+    state->offset = previousOffset;
+
+    if (state == &outermost)
+    {
+        // Scopes end in the reverse order they began, so this one is innermost
+        jassert(activeStates == state);
+        activeStates = state->next;
+
+        if (state->slot != nullptr)
+            state->slot->inUse.store(false, std::memory_order_release);
+    }
+}
+
+float* ScratchArena::Scope::allocate(size_t numFloats)
+{
+    const auto size = getAlignedSize(numFloats);
+
+    // More than prepare reserved for: nothing, rather than memory past the slab
+    if (state->data == nullptr || state->offset + size > state->capacity)
+        return nullptr;
+
+    float* memory = state->data + state->offset;
+    state->offset += size;
+    return memory;
+}
@@ -0,0 +1,123 @@
+/*
+  ==============================================================================
+
+    ScratchArena.h
+    Created: 20 Oct 2026 10:04:51am
+    Author:  Linus
+
+  ==============================================================================
+*/
+
+#pragma once
+#include <atomic>
+#include <memory>
+#include <vector>
+#include <JuceHeader.h>
+
+// Per-block scratch memory shared by every Compressor in the process through
+// juce::SharedResourcePointer. Instead of each instance owning its block buffers,
+// a thread borrows one of a few 64-byte aligned slabs for the duration of a block,
+// so the memory in use scales with the number of audio threads, not instances.
+class ScratchArena
+{
+public:
+    static constexpr size_t alignment = 64;
+
+    // numSlots 0 takes the default, enough for every hardware thread twice over
+    explicit ScratchArena(int requestedSlots = 0);
+    ~ScratchArena();
+
+    // Makes sure every slab can hold numFloats floats of aligned allocations, and frees
+    // the slabs earlier calls replaced once no thread can still be using them.
+    // Call from prepare, never from the audio thread.
+    void reserve(size_t numFloats);
+
+    // Rounds a request up so consecutive allocations stay aligned
+    static size_t getAlignedSize(size_t numFloats);
+
+    // Slabs reserve replaced that a thread's block still held, for diagnostics
+    int getNumRetiredSlabs() const;
+
+private:
+    struct Slab
+    {
+        explicit Slab(size_t numFloats);
+        ~Slab();
+
+        float* data;
+        size_t capacity;
+
+        JUCE_DECLARE_NON_COPYABLE(Slab)
+    };
+
+    struct Slot
+    {
+        std::atomic<bool> inUse{ false };
+        std::atomic<Slab*> slab{ nullptr };
+    };
+
+public:
+    // Borrows a slab for the current thread until it goes out of scope, without
+    // allocating or waiting: if every slot is taken the scope has no memory to give.
+    // Scopes on the same arena nest on the same thread and share the slab; scopes
+    // on different arenas keep to their own.
+    class Scope
+    {
+    public:
+        explicit Scope(ScratchArena&);
+        ~Scope();
+
+        // Returns numFloats of uninitialised, 64-byte aligned memory, or nullptr once
+        // the slab is out of room, which the caller takes as a reason to skip its work
+        float* allocate(size_t numFloats);
+
+    private:
+        // The slab this thread borrowed from one arena and how much of it is handed
+        // out, kept by the outermost scope on that arena
+        struct State
+        {
+            const ScratchArena* arena{ nullptr };
+            Slot* slot{ nullptr };
+            float* data{ nullptr };
+            size_t capacity{ 0 };
+            size_t offset{ 0 };
+            State* next{ nullptr };
+        };
+
+        // The states of this thread's outermost scopes, innermost first
+        static thread_local State* activeStates;
+
+        State outermost;
+        State* state;
+        size_t previousOffset;
+
+        JUCE_DECLARE_NON_COPYABLE(Scope)
+    };
+
+private:
+    // A free slot, nullptr if every one is taken
+    Slot* claimSlot();
+
+    // Frees the retired slabs whose slot can be claimed: a thread that borrowed one
+    // holds its slot until the end of its block, later ones get the new slab
+    void freeRetiredSlabs();
+
+    std::unique_ptr<Slot[]> slots;
+    int numSlots;
+
+    // The slab each slot hands out, by slot index
+    std::vector<std::unique_ptr<Slab>> slabs;
+
+    // Slabs reserve replaced while their slot was in use, with that slot
+    struct RetiredSlab
+    {
+        std::unique_ptr<Slab> slab;
+        Slot* slot;
+    };
+    std::vector<RetiredSlab> retiredSlabs;
+
+    size_t capacity{ 0 };
+    juce::CriticalSection reserveLock;
+
+    JUCE_DECLARE_NON_COPYABLE(ScratchArena)
+};
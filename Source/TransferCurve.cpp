@@ -0,0 +1,68 @@
+/*
+  ==============================================================================
+
+    TransferCurve.cpp
+    Created: 19 Oct 2026 9:13:05am
+    Author:  Linus
+
+  ==============================================================================
+*/
+
+#include "TransferCurve.h"
+#include "GainComputer.h"
+#include <algorithm>
+
+TransferCurve::TransferCurve(const GainComputer& settings)
+    : threshold(settings.getThreshold()), ratio(settings.getRatio()), knee(settings.getKnee())
+{
+    for (int i = 0; i < tableSize; ++i)
+        table[i] = settings.applyCompressorSection(minLevel + static_cast<float>(i) * resolution);
+}
+
+bool TransferCurve::matches(float threshold, float ratio, float knee) const
+{
+    return this->threshold == threshold && this->ratio == ratio && this->knee == knee;
+}
+
+float TransferCurve::lookup(float levelInDecibels) const
+{
+    // Below the table the curve is always the identity (threshold - knee > minLevel)
+    if (levelInDecibels <= minLevel)
+        return levelInDecibels;
+
+    // Above the table the curve is always in full compression, so extrapolate linearly
+    if (levelInDecibels >= maxLevel)
+        return table[tableSize - 1] + (levelInDecibels - maxLevel) / ratio;
+
+    const float position = (levelInDecibels - minLevel) * (1.0f / resolution);
+    const int index = std::min(static_cast<int>(position), tableSize - 2);
+    const float fraction = position - static_cast<float>(index);
+    return table[index] + fraction * (table[index + 1] - table[index]);
+}
+
+TransferCurve::Ptr TransferCurveCache::getCurve(float threshold, float ratio, float knee)
+{
+    // Let the gain computer normalise the settings (e.g. limiter ratio) so keys match
+    GainComputer settings;
+    settings.setThreshold(threshold);
+    settings.setRatio(ratio);
+    settings.setKnee(knee);
+
+    const juce::ScopedLock sl(lock);
+
+    for (auto& curve : curves)
+        if (curve->matches(settings.getThreshold(), settings.getRatio(), settings.getKnee()))
+            return curve;
+
+    removeUnusedCurves();
+    curves.push_back(new TransferCurve(settings));
+    return curves.back();
+}
+
+void TransferCurveCache::removeUnusedCurves()
+{
+    // A reference count of one means only the cache holds on to it
+    curves.erase(std::remove_if(curves.begin(), curves.end(),
+                                [](const TransferCurve::Ptr& curve) { return curve->getReferenceCount() == 1; }),
+                 curves.end());
+}
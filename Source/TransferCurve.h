@@ -0,0 +1,61 @@
+/*
+  ==============================================================================
+
+    TransferCurve.h
+    Created: 19 Oct 2026 9:12:40am
+    Author:  Linus
+
+  ==============================================================================
+*/
+
+#pragma once
+#include <array>
+#include <vector>
+#include <JuceHeader.h>
+
+class GainComputer;
+
+// Immutable, precomputed static transfer curve of a GainComputer.
+// Sampled over the level range the side-chain can reach and linearly interpolated.
+class TransferCurve : public juce::ReferenceCountedObject
+{
+public:
+    using Ptr = juce::ReferenceCountedObjectPtr<TransferCurve>;
+
+    explicit TransferCurve(const GainComputer& settings);
+
+    // True if this curve was built from the given (already normalised) settings
+    bool matches(float threshold, float ratio, float knee) const;
+
+    // Returns the output level in dB for the given input level in dB
+    float lookup(float levelInDecibels) const;
+
+    static constexpr float minLevel = -120.0f;
+    static constexpr float maxLevel = 48.0f;
+    static constexpr float resolution = 0.25f;
+    static constexpr int tableSize = static_cast<int>((maxLevel - minLevel) / resolution) + 1;
+
+private:
+    float threshold, ratio, knee;
+    std::array<float, tableSize> table;
+};
+
+// Process-wide cache of transfer curves, shared between all instances through
+// juce::SharedResourcePointer. Curves are keyed by (threshold, ratio, knee) and
+// are only built and released here, never on the audio thread.
+class TransferCurveCache
+{
+public:
+    TransferCurveCache() = default;
+
+    // Returns the shared curve for the given parameter values, building it if needed.
+    // Call from the message thread.
+    TransferCurve::Ptr getCurve(float threshold, float ratio, float knee);
+
+private:
+    // Drops curves no instance refers to anymore
+    void removeUnusedCurves();
+
+    juce::CriticalSection lock;
+    std::vector<TransferCurve::Ptr> curves;
+};
@@ -0,0 +1,120 @@
+/*
+  ==============================================================================
+
+    TransferCurveDisplay.cpp
+    Created: 21 Oct 2026 9:31:48am
+    Author:  Linus
+
+  ==============================================================================
+*/
+
+#include "TransferCurveDisplay.h"
+#include "GainComputer.h"
+#include "GlobalParameters.h"
+
+namespace
+{
+    const char* const curveParameterIDs[] = { "threshold", "ratio", "knee", "gate", "expthreshold", "expratio",
+                                              "upthreshold", "upratio", "limit" };
+}
+
+TransferCurveDisplay::TransferCurveDisplay(juce::AudioProcessorValueTreeState& apvts)
+    : parameters(apvts)
+{
+    setOpaque(true);
+    for (auto* id : curveParameterIDs)
+        parameters.addParameterListener(id, this);
+}
+
+TransferCurveDisplay::~TransferCurveDisplay()
+{
+    for (auto* id : curveParameterIDs)
+        parameters.removeParameterListener(id, this);
+}
+
+void TransferCurveDisplay::refresh()
+{
+    if (curveDirty.exchange(false))
+    {
+        renderCurve();
+        repaint();
+    }
+}
+
+void TransferCurveDisplay::paint(juce::Graphics& g)
+{
+    if (curveImage.isValid())
+        g.drawImage(curveImage, getLocalBounds().toFloat());
+    else
+        g.fillAll(juce::Colour(GlobalParameters::Colors::bg_DarkGrey));
+}
+
+void TransferCurveDisplay::resized()
+{
+    curveDirty = true;
+}
+
+void TransferCurveDisplay::parameterChanged(const juce::String&, float)
+{
+    curveDirty = true;
+}
+
+void TransferCurveDisplay::renderCurve()
+{
+    using namespace GlobalParameters;
+
+    if (getWidth() <= 0 || getHeight() <= 0)
+        return;
+
+    // Render at the display's pixel density so the cached image stays sharp
+    const float scale = juce::Component::getApproximateScaleFactorForComponent(this);
+    curveImage = juce::Image(juce::Image::RGB, juce::roundToInt(getWidth() * scale),
+                             juce::roundToInt(getHeight() * scale), false);
+
+    juce::Graphics g(curveImage);
+    g.addTransform(juce::AffineTransform::scale(scale));
+    g.fillAll(juce::Colour(Colors::bg_DarkGrey));
+
+    const auto bounds = getLocalBounds().toFloat().reduced(Margins::big);
+    const auto toX = [&](float level) { return juce::jmap(level, minLevel, maxLevel, bounds.getX(), bounds.getRight()); };
+    const auto toY = [&](float level) { return juce::jmap(level, minLevel, maxLevel, bounds.getBottom(), bounds.getY()); };
+
+    // Grid every 12 dB and the unity line
+    g.setColour(juce::Colour(Colors::bg_MidGrey));
+    for (float level = minLevel; level <= maxLevel; level += 12.0f)
+    {
+        g.drawHorizontalLine(juce::roundToInt(toY(level)), bounds.getX(), bounds.getRight());
+        g.drawVerticalLine(juce::roundToInt(toX(level)), bounds.getY(), bounds.getBottom());
+    }
+    g.drawLine(toX(minLevel), toY(minLevel), toX(maxLevel), toY(maxLevel), 1.0f);
+
+    GainComputer gainComputer;
+    gainComputer.setThreshold(*parameters.getRawParameterValue("threshold"));
+    gainComputer.setRatio(*parameters.getRawParameterValue("ratio"));
+    gainComputer.setKnee(*parameters.getRawParameterValue("knee"));
+
+    const float limit = *parameters.getRawParameterValue("limit");
+    gainComputer.setGate(*parameters.getRawParameterValue("gate"), Parameter::gateRange);
+    gainComputer.setExpander(*parameters.getRawParameterValue("expthreshold"), *parameters.getRawParameterValue("expratio"));
+    gainComputer.setUpward(*parameters.getRawParameterValue("upthreshold"), *parameters.getRawParameterValue("upratio"), Parameter::upwardMaxBoost);
+    gainComputer.setLimiter(limit < Parameter::limitEnd ? limit : std::numeric_limits<float>::infinity());
+
+    // One point per pixel column
+    juce::Path curve;
+    const int numPoints = juce::jmax(2, juce::roundToInt(bounds.getWidth()));
+    for (int i = 0; i < numPoints; ++i)
+    {
+        const float input = juce::jmap(static_cast<float>(i), 0.0f, static_cast<float>(numPoints - 1), minLevel, maxLevel);
+        const float output = juce::jlimit(minLevel, maxLevel, gainComputer.applyCompression(input));
+        if (i == 0)
+            curve.startNewSubPath(toX(input), toY(output));
+        else
+            curve.lineTo(toX(input), toY(output));
+    }
+
+    g.setColour(juce::Colour(Colors::statusOutline));
+    g.strokePath(curve, juce::PathStrokeType(2.0f));
+
+    g.setColour(juce::Colour(Colors::bg_LightGrey));
+    g.drawRect(bounds, 1.0f);
+}
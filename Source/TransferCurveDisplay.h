@@ -0,0 +1,44 @@
+/*
+  ==============================================================================
+
+    TransferCurveDisplay.h
+    Created: 21 Oct 2026 9:30:12am
+    Author:  Linus
+
+  ==============================================================================
+*/
+
+#pragma once
+#include <atomic>
+#include <JuceHeader.h>
+
+// Draws the static curve of the GainComputer for the current threshold, ratio,
+// knee and gate/expander/upward/limiter sections. The curve is rendered into a
+// cached image that is only redrawn when one of those parameters (or the size) changes.
+class TransferCurveDisplay : public juce::Component, private juce::AudioProcessorValueTreeState::Listener
+{
+public:
+    explicit TransferCurveDisplay(juce::AudioProcessorValueTreeState&);
+    ~TransferCurveDisplay() override;
+
+    // Re-renders the cached image if needed, call from the editor's refresh tick
+    void refresh();
+
+    void paint(juce::Graphics&) override;
+    void resized() override;
+
+private:
+    // May be called on the audio thread, so only flags the image as stale
+    void parameterChanged(const juce::String& parameterID, float newValue) override;
+
+    void renderCurve();
+
+    static constexpr float minLevel = -60.0f;
+    static constexpr float maxLevel = 0.0f;
+
+    juce::AudioProcessorValueTreeState& parameters;
+    juce::Image curveImage;
+    std::atomic<bool> curveDirty{ true };
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(TransferCurveDisplay)
+};
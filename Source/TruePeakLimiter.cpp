@@ -0,0 +1,214 @@
+/*
+  ==============================================================================
+
+    TruePeakLimiter.cpp
+    Created: 22 Oct 2026 9:49:02am
+    Author:  Linus
+
+  ==============================================================================
+*/
+
+#include "TruePeakLimiter.h"
+#include <cmath>
+
+namespace
+{
+    // Zeroth order modified Bessel function of the first kind, for the Kaiser window
+    double besselI0(double x)
+    {
+        double sum = 1.0, term = 1.0;
+        for (int k = 1; k < 32; ++k)
+        {
+            term *= juce::square(x / (2.0 * k));
+            sum += term;
+        }
+        return sum;
+    }
+}
+
+const TruePeakLimiter::Phases& TruePeakLimiter::getPhases()
+{
+    static const Phases phases = []
+    {
+        // Kaiser windowed sinc, cut at the input Nyquist frequency and centred on
+        // tapsPerPhase / 2 input samples. Phase 0 of it is a pure delay.
+        using namespace juce;
+        constexpr int length = oversampling * tapsPerPhase;
+        constexpr double beta = 5.0;
+
+        Phases designed{};
+        for (int p = 1; p < oversampling; ++p)
+        {
+            auto& phase = designed[static_cast<size_t>(p - 1)];
+            float sum = 0.0f;
+
+            for (int k = 0; k < tapsPerPhase; ++k)
+            {
+                const int m = oversampling * k + p;
+                const double x = static_cast<double>(m - length / 2) / oversampling;
+                const double sinc = std::sin(MathConstants<double>::pi * x) / (MathConstants<double>::pi * x);
+                const double r = 2.0 * m / length - 1.0;
+                const double window = besselI0(beta * std::sqrt(1.0 - r * r)) / besselI0(beta);
+                phase[static_cast<size_t>(k)] = static_cast<float>(sinc * window);
+                sum += phase[static_cast<size_t>(k)];
+            }
+
+            // Unity gain at DC for every phase
+            for (auto& tap : phase)
+                tap /= sum;
+        }
+
+        return designed;
+    }();
+
+    return phases;
+}
+
+void TruePeakLimiter::prepare(const juce::dsp::ProcessSpec& spec)
+{
+    // The first call designs the interpolator, which must not be on the audio thread
+    getPhases();
+
+    lookahead = juce::jmax(8, static_cast<int>(std::ceil(lookaheadSeconds * spec.sampleRate)));
+    releaseCoefficient = static_cast<float>(std::exp(-1.0 / (releaseSeconds * spec.sampleRate)));
+    historySize = juce::jmax(tapsPerPhase - 1, getLatencyInSamples());
+
+    history.setSize(static_cast<int>(juce::jmax(2u, spec.numChannels)), historySize);
+    minimumValues.resize(static_cast<size_t>(lookahead + 1));
+    minimumTimes.resize(static_cast<size_t>(lookahead + 1));
+    boxValues.resize(static_cast<size_t>(lookahead));
+
+    reset();
+}
+
+void TruePeakLimiter::reset()
+{
+    history.clear();
+    minimumHead = 0;
+    minimumSize = 0;
+    time = 0;
+    std::fill(boxValues.begin(), boxValues.end(), 1.0f);
+    boxIndex = 0;
+    boxSum = static_cast<double>(lookahead);
+    releasedGain = 1.0f;
+}
+
+void TruePeakLimiter::setCeiling(float ceilingInDecibels)
+{
+    ceiling = juce::Decibels::decibelsToGain(ceilingInDecibels);
+}
+
+int TruePeakLimiter::getLatencyInSamples() const
+{
+    return lookahead - 1 + interpolatorDelay;
+}
+
+size_t TruePeakLimiter::getScratchSize(int numSamples) const
+{
+    const auto n = static_cast<size_t>(numSamples);
+    return ScratchArena::getAlignedSize(static_cast<size_t>(historySize) + n) + 2 * ScratchArena::getAlignedSize(n);
+}
+
+void TruePeakLimiter::process(juce::AudioBuffer<float>& buffer, ScratchArena::Scope& scratch)
+{
+    using namespace juce;
+
+    const int numSamples = buffer.getNumSamples();
+    const int numChannels = buffer.getNumChannels();
+
+    // Every channel is delayed by the same history or none is, prepare sets the channel count
+    jassert(numChannels <= history.getNumChannels());
+    if (numChannels > history.getNumChannels())
+        return;
+
+    float* extended = scratch.allocate(static_cast<size_t>(historySize + numSamples));
+    float* interpolated = scratch.allocate(static_cast<size_t>(numSamples));
+    float* gain = scratch.allocate(static_cast<size_t>(numSamples));
+
+    // Without room in the scratch arena the block goes through unlimited
+    if (extended == nullptr || interpolated == nullptr || gain == nullptr)
+        return;
+
+    // Peak over all channels and all four phases, one block-wide pass per tap
+    FloatVectorOperations::clear(gain, numSamples);
+    for (int ch = 0; ch < numChannels; ++ch)
+    {
+        fillExtended(buffer, ch, extended);
+        const float* input = extended + historySize;
+
+        FloatVectorOperations::abs(interpolated, input - interpolatorDelay, numSamples);
+        FloatVectorOperations::max(gain, gain, interpolated, numSamples);
+
+        for (const auto& phase : getPhases())
+        {
+            FloatVectorOperations::clear(interpolated, numSamples);
+            for (int k = 0; k < tapsPerPhase; ++k)
+                FloatVectorOperations::addWithMultiply(interpolated, input - k, phase[static_cast<size_t>(k)], numSamples);
+
+            FloatVectorOperations::abs(interpolated, interpolated, numSamples);
+            FloatVectorOperations::max(gain, gain, interpolated, numSamples);
+        }
+    }
+
+    computeGain(gain, numSamples);
+
+    // Apply the gain to the delayed signal and keep the tail as history
+    const int delay = getLatencyInSamples();
+    for (int ch = 0; ch < numChannels; ++ch)
+    {
+        fillExtended(buffer, ch, extended);
+        FloatVectorOperations::multiply(buffer.getWritePointer(ch), extended + historySize - delay, gain, numSamples);
+        history.copyFrom(ch, 0, extended + numSamples, historySize);
+    }
+}
+
+void TruePeakLimiter::fillExtended(const juce::AudioBuffer<float>& buffer, int channel, float* extended) const
+{
+    juce::FloatVectorOperations::copy(extended, history.getReadPointer(channel), historySize);
+    juce::FloatVectorOperations::copy(extended + historySize, buffer.getReadPointer(channel), buffer.getNumSamples());
+}
+
+void TruePeakLimiter::computeGain(float* peaksToGain, int numSamples)
+{
+    const int capacity = lookahead + 1;
+
+    for (int i = 0; i < numSamples; ++i)
+    {
+        const float peak = peaksToGain[i];
+        const float required = peak > ceiling ? ceiling / peak : 1.0f;
+        ++time;
+
+        // Minimum of the required gain over the last lookahead + 1 samples. Together
+        // with the moving average below, the gain reaches each target before the
+        // delayed peak (and its neighbouring sample) leaves the stage. The entry that
+        // left the window goes first, so a rising gain never fills more than the ring.
+        if (minimumSize > 0 && time - minimumTimes[static_cast<size_t>(minimumHead)] > static_cast<juce::uint32>(lookahead))
+        {
+            minimumHead = (minimumHead + 1) % capacity;
+            --minimumSize;
+        }
+
+        while (minimumSize > 0 && minimumValues[static_cast<size_t>((minimumHead + minimumSize - 1) % capacity)] >= required)
+            --minimumSize;
+
+        jassert(minimumSize < capacity);
+        const auto back = static_cast<size_t>((minimumHead + minimumSize) % capacity);
+        minimumValues[back] = required;
+        minimumTimes[back] = time;
+        ++minimumSize;
+
+        const float minimum = minimumValues[static_cast<size_t>(minimumHead)];
+
+        // Instant attack, smooth release, never above the minimum
+        if (minimum < releasedGain)
+            releasedGain = minimum;
+        else
+            releasedGain += (1.0f - releaseCoefficient) * (minimum - releasedGain);
+
+        boxSum += releasedGain - boxValues[static_cast<size_t>(boxIndex)];
+        boxValues[static_cast<size_t>(boxIndex)] = releasedGain;
+        boxIndex = (boxIndex + 1) % lookahead;
+
+        peaksToGain[i] = static_cast<float>(boxSum / lookahead);
+    }
+}
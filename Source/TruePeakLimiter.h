@@ -0,0 +1,82 @@
+/*
+  ==============================================================================
+
+    TruePeakLimiter.h
+    Created: 22 Oct 2026 9:48:15am
+    Author:  Linus
+
+  ==============================================================================
+*/
+
+#pragma once
+#include <array>
+#include <vector>
+#include "ScratchArena.h"
+#include <JuceHeader.h>
+
+// Output ceiling in dBTP. Inter-sample peaks are estimated with a 4x polyphase
+// interpolator and held down by a short lookahead gain clamp, so the stage adds
+// getLatencyInSamples() of delay while it is enabled. Like any 4x meter it can
+// read a few tenths of a dB low for content close to the Nyquist frequency.
+class TruePeakLimiter
+{
+public:
+    TruePeakLimiter() = default;
+
+    void prepare(const juce::dsp::ProcessSpec& spec);
+
+    // Clears the lookahead and interpolator history
+    void reset();
+
+    void setCeiling(float ceilingInDecibels);
+
+    int getLatencyInSamples() const;
+
+    // Floats of scratch memory process borrows for a block of numSamples
+    size_t getScratchSize(int numSamples) const;
+
+    // A block with more channels than prepare's spec, or without room in the scratch
+    // arena, goes through unlimited and without the delay
+    void process(juce::AudioBuffer<float>& buffer, ScratchArena::Scope& scratch);
+
+private:
+    // Lays out history followed by the block of the given channel
+    void fillExtended(const juce::AudioBuffer<float>& buffer, int channel, float* extended) const;
+
+    // Turns the peak estimates into a smooth gain that reaches its target in time
+    void computeGain(float* peaksToGain, int numSamples);
+
+    static constexpr int oversampling = 4;
+    static constexpr int tapsPerPhase = 16;
+    // Interpolated phase 0 is the input delayed by this many samples
+    static constexpr int interpolatorDelay = tapsPerPhase / 2;
+
+    static constexpr double lookaheadSeconds = 0.001;
+    static constexpr double releaseSeconds = 0.05;
+
+    // Phases 1..3 of the interpolator, phase 0 is a plain delay. The taps are the same
+    // for every instance, so they are designed once per process.
+    using Phases = std::array<std::array<float, tapsPerPhase>, oversampling - 1>;
+    static const Phases& getPhases();
+
+    float ceiling{ 1.0f };
+    float releaseCoefficient{ 0.0f };
+    int lookahead{ 0 };
+    int historySize{ 0 };
+
+    // Last historySize input samples per channel, shared by interpolator and delay line
+    juce::AudioBuffer<float> history;
+
+    // Sliding minimum over lookahead + 1 samples, kept as a monotonic queue
+    std::vector<float> minimumValues;
+    std::vector<juce::uint32> minimumTimes;
+    int minimumHead{ 0 }, minimumSize{ 0 };
+    juce::uint32 time{ 0 };
+
+    // Moving average over lookahead samples
+    std::vector<float> boxValues;
+    int boxIndex{ 0 };
+    double boxSum{ 0.0 };
+
+    float releasedGain{ 1.0f };
+};
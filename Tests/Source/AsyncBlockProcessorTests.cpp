@@ -0,0 +1,229 @@
+/*
+  ==============================================================================
+
+    AsyncBlockProcessorTests.cpp
+    Created: 25 Oct 2026 11:05:27am
+    Author:  Linus
+
+  ==============================================================================
+*/
+
+#include <JuceHeader.h>
+#include <atomic>
+#include <thread>
+#include "../../Source/AsyncBlockProcessor.h"
+#include "../../Source/Compressor.h"
+#include "GoldenRenders.h"
+#include "TestSignals.h"
+
+class AsyncBlockProcessorTests : public juce::UnitTest
+{
+public:
+    AsyncBlockProcessorTests() : juce::UnitTest("AsyncBlockProcessor", "DSP") {}
+
+    void runTest() override
+    {
+        beginTest("Disabled, blocks are processed on the calling thread without latency");
+        {
+            std::atomic<bool> onCaller{ true };
+            const auto caller = std::this_thread::get_id();
+            AsyncBlockProcessor async([&](juce::AudioBuffer<float>& block)
+            {
+                onCaller = onCaller && std::this_thread::get_id() == caller;
+                block.applyGain(2.0f);
+            });
+            async.prepare(2, TestSignals::blockSize);
+
+            auto buffer = TestSignals::makeBursts(TestSignals::blockSize);
+            const juce::AudioBuffer<float> source(buffer);
+            async.process(buffer);
+
+            expect(onCaller.load());
+            expectEquals(async.getLatencyInSamples(), 0);
+            for (int i = 0; i < buffer.getNumSamples(); ++i)
+                expectEquals(buffer.getSample(1, i), 2.0f * source.getSample(1, i));
+        }
+
+        beginTest("Enabled, the output is delayed by the maximum block size at any block size");
+        {
+            std::atomic<bool> onWorker{ true };
+            const auto caller = std::this_thread::get_id();
+            AsyncBlockProcessor async([&](juce::AudioBuffer<float>& block)
+            {
+                onWorker = onWorker && std::this_thread::get_id() != caller;
+                block.applyGain(2.0f);
+            });
+            async.prepare(2, TestSignals::blockSize);
+            async.setEnabled(true);
+            async.setWaitsForWorker(true);
+            expectEquals(async.getLatencyInSamples(), TestSignals::blockSize);
+
+            const auto source = TestSignals::makeBursts(TestSignals::renderLength);
+            juce::AudioBuffer<float> rendered(source);
+            renderInVaryingBlocks(async, rendered);
+
+            expect(onWorker.load());
+            const int latency = async.getLatencyInSamples();
+            for (int ch = 0; ch < 2; ++ch)
+            {
+                for (int i = 0; i < latency; ++i)
+                    expectEquals(rendered.getSample(ch, i), 0.0f);
+                for (int i = latency; i < rendered.getNumSamples(); ++i)
+                    expectEquals(rendered.getSample(ch, i), 2.0f * source.getSample(ch, i - latency));
+            }
+        }
+
+        beginTest("The compressor on the worker renders what it renders on the audio thread");
+        {
+            Compressor asyncCompressor, reference;
+            TestSignals::configure(asyncCompressor, GoldenRenders::compressorSettings);
+            TestSignals::configure(reference, GoldenRenders::compressorSettings);
+
+            AsyncBlockProcessor async([&](juce::AudioBuffer<float>& block) { asyncCompressor.process(block); });
+            async.prepare(2, TestSignals::blockSize);
+            async.setEnabled(true);
+            async.setWaitsForWorker(true);
+
+            const auto source = TestSignals::makeBursts(TestSignals::renderLength);
+            juce::AudioBuffer<float> rendered(source), expected(source);
+            TestSignals::render(async, rendered);
+            TestSignals::render(reference, expected);
+
+            const int latency = async.getLatencyInSamples();
+            for (int ch = 0; ch < 2; ++ch)
+                for (int i = latency; i < rendered.getNumSamples(); ++i)
+                    expectEquals(rendered.getSample(ch, i), expected.getSample(ch, i - latency));
+        }
+
+        beginTest("Switching the worker off returns to processing in place");
+        {
+            AsyncBlockProcessor async([](juce::AudioBuffer<float>& block) { block.applyGain(0.5f); });
+            async.prepare(2, TestSignals::blockSize);
+            async.setEnabled(true);
+            async.setWaitsForWorker(true);
+
+            juce::AudioBuffer<float> buffer(2, TestSignals::blockSize);
+            for (int block = 0; block < 4; ++block)
+            {
+                TestSignals::fill(buffer, 1.0f);
+                async.process(buffer);
+            }
+
+            async.setEnabled(false);
+            expectEquals(async.getLatencyInSamples(), 0);
+            TestSignals::fill(buffer, 1.0f);
+            async.process(buffer);
+            expectEquals(buffer.getSample(0, 0), 0.5f);
+            expectEquals(buffer.getSample(1, TestSignals::blockSize - 1), 0.5f);
+
+            // The worker stopped with it and comes back, one block late again
+            async.setEnabled(true);
+            expectEquals(async.getLatencyInSamples(), TestSignals::blockSize);
+            for (const float expected : { 0.0f, 0.5f })
+            {
+                TestSignals::fill(buffer, 1.0f);
+                async.process(buffer);
+                expectEquals(buffer.getSample(0, 0), expected);
+            }
+        }
+
+        beginTest("Rendering offline, a slow worker makes the audio thread wait, it never runs the block itself");
+        {
+            std::atomic<int> running{ 0 }, maxRunning{ 0 };
+            AsyncBlockProcessor async([&](juce::AudioBuffer<float>& block)
+            {
+                maxRunning = juce::jmax(maxRunning.load(), ++running);
+                std::this_thread::sleep_for(std::chrono::milliseconds(2));
+                block.applyGain(2.0f);
+                --running;
+            });
+            async.prepare(2, TestSignals::blockSize);
+            async.setEnabled(true);
+            async.setWaitsForWorker(true);
+
+            const auto source = TestSignals::makeBursts(TestSignals::renderLength);
+            juce::AudioBuffer<float> rendered(source);
+            TestSignals::render(async, rendered);
+
+            expectEquals(maxRunning.load(), 1);
+            expectGreaterThan(async.getNumLateBlocks(), 0);
+            for (int i = TestSignals::blockSize; i < rendered.getNumSamples(); ++i)
+                expectEquals(rendered.getSample(0, i), 2.0f * source.getSample(0, i - TestSignals::blockSize));
+        }
+
+        beginTest("In real time a slow worker's blocks are dropped without waiting, the output stays aligned");
+        {
+            std::atomic<int> running{ 0 }, maxRunning{ 0 };
+            AsyncBlockProcessor async([&](juce::AudioBuffer<float>& block)
+            {
+                maxRunning = juce::jmax(maxRunning.load(), ++running);
+                std::this_thread::sleep_for(std::chrono::milliseconds(2));
+                block.applyGain(2.0f);
+                --running;
+            });
+            async.prepare(2, TestSignals::blockSize);
+            async.setEnabled(true);
+
+            // A constant input, so every sample that isn't dropped shows where it came from
+            auto source = TestSignals::makeBursts(TestSignals::renderLength);
+            for (int ch = 0; ch < 2; ++ch)
+                for (int i = 0; i < source.getNumSamples(); ++i)
+                    source.setSample(ch, i, static_cast<float>(i + 1));
+
+            juce::AudioBuffer<float> rendered(source);
+            double slowestSeconds = 0.0;
+            const int sizes[] = { TestSignals::blockSize, 100, 300, 64 };
+            for (int block = 0, start = 0; start < rendered.getNumSamples(); ++block)
+            {
+                const int numSamples = juce::jmin(sizes[block % 4], rendered.getNumSamples() - start);
+                juce::AudioBuffer<float> view(rendered.getArrayOfWritePointers(), 2, start, numSamples);
+
+                const auto startTicks = juce::Time::getHighResolutionTicks();
+                async.process(view);
+                slowestSeconds = juce::jmax(slowestSeconds, juce::Time::highResolutionTicksToSeconds(juce::Time::getHighResolutionTicks() - startTicks));
+                start += numSamples;
+
+                // A host calling twice as often as the worker keeps up with
+                std::this_thread::sleep_for(std::chrono::milliseconds(1));
+            }
+
+            expectEquals(maxRunning.load(), 1);
+            expectGreaterThan(async.getNumLateBlocks(), 0);
+            logMessage("Slowest block on the audio thread: " + juce::String(slowestSeconds * 1.0e3, 3) + " ms");
+
+            // Every sample is either dropped or the one from a block size earlier, and
+            // some of both made it
+            int numDropped = 0;
+            for (int ch = 0; ch < 2; ++ch)
+            {
+                for (int i = TestSignals::blockSize; i < rendered.getNumSamples(); ++i)
+                {
+                    const float sample = rendered.getSample(ch, i);
+                    if (sample == 0.0f)
+                        ++numDropped;
+                    else
+                        expectEquals(sample, 2.0f * source.getSample(ch, i - TestSignals::blockSize));
+                }
+            }
+            expectGreaterThan(numDropped, 0);
+            expectLessThan(numDropped, 2 * (rendered.getNumSamples() - TestSignals::blockSize));
+        }
+    }
+
+private:
+    // Host blocks of 512, 100, 300 and 64 samples over and over
+    static void renderInVaryingBlocks(AsyncBlockProcessor& async, juce::AudioBuffer<float>& buffer)
+    {
+        const int sizes[] = { TestSignals::blockSize, 100, 300, 64 };
+        int start = 0;
+        for (int block = 0; start < buffer.getNumSamples(); ++block)
+        {
+            const int numSamples = juce::jmin(sizes[block % 4], buffer.getNumSamples() - start);
+            juce::AudioBuffer<float> view(buffer.getArrayOfWritePointers(), buffer.getNumChannels(), start, numSamples);
+            async.process(view);
+            start += numSamples;
+        }
+    }
+};
+
+static AsyncBlockProcessorTests asyncBlockProcessorTests;
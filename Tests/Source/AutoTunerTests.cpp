@@ -0,0 +1,217 @@
+/*
+  ==============================================================================
+
+    AutoTunerTests.cpp
+    Created: 27 Oct 2026 11:36:18am
+    Author:  Linus
+
+  ==============================================================================
+*/
+
+#include <JuceHeader.h>
+#include <algorithm>
+#include "../../Source/AutoTuner.h"
+#include "../../Source/Compressor.h"
+#include "GoldenRenders.h"
+#include "TestSignals.h"
+
+namespace
+{
+    using Kernel = Compressor::Kernel;
+    using Tuning = Compressor::Tuning;
+
+    // A compressor that keeps the deepest gain reduction of the blocks it was given
+    struct MeteredCompressor
+    {
+        Compressor& compressor;
+        float deepest{ 0.0f };
+
+        void process(juce::AudioBuffer<float>& block)
+        {
+            compressor.process(block);
+            deepest = juce::jmin(deepest, compressor.getMaxGainReduction());
+        }
+    };
+
+    void setUp(Compressor& compressor, const GoldenRenders::Settings& settings, const juce::dsp::ProcessSpec& spec, bool withCurve)
+    {
+        TestSignals::configure(compressor, settings, spec);
+        if (withCurve)
+            compressor.setTransferCurve(juce::SharedResourcePointer<TransferCurveCache>()->getCurve(settings.threshold, settings.ratio, settings.knee));
+    }
+}
+
+class AutoTunerTests : public juce::UnitTest
+{
+public:
+    AutoTunerTests() : juce::UnitTest("AutoTuner", "DSP") {}
+
+    void runTest() override
+    {
+        beginTest("Every candidate renders exactly what the default renders");
+        {
+            // 480 leaves a short last tile for all but the whole block
+            constexpr int blockSize = 480;
+            const int numSamples = 4 * blockSize + 100;
+
+            for (const auto quality : { Compressor::Quality::full, Compressor::Quality::approximate })
+            for (const int numChannels : { 1, 2, 3 })
+            for (const bool withCurve : { false, true })
+            for (const auto& settings : { GoldenRenders::compressorSettings, GoldenRenders::limiterSettings })
+            {
+                const juce::dsp::ProcessSpec spec{ TestSignals::sampleRate, static_cast<juce::uint32>(blockSize),
+                                                   static_cast<juce::uint32>(numChannels) };
+                const auto source = TestSignals::makeBursts(numChannels, numSamples);
+
+                Compressor reference;
+                setUp(reference, settings, spec, withCurve);
+                reference.setQuality(quality);
+                juce::AudioBuffer<float> expected(source);
+                MeteredCompressor meteredReference{ reference };
+                TestSignals::render(meteredReference, expected, blockSize);
+
+                for (const auto& tuning : AutoTuner::getCandidates(blockSize))
+                {
+                    Compressor compressor;
+                    setUp(compressor, settings, spec, withCurve);
+                    compressor.setQuality(quality);
+                    compressor.setTuning(tuning);
+
+                    juce::AudioBuffer<float> rendered(source);
+                    MeteredCompressor metered{ compressor };
+                    TestSignals::render(metered, rendered, blockSize);
+
+                    int numDifferent = 0;
+                    for (int ch = 0; ch < numChannels; ++ch)
+                        for (int i = 0; i < numSamples; ++i)
+                            numDifferent += rendered.getSample(ch, i) != expected.getSample(ch, i) ? 1 : 0;
+
+                    expectEquals(numDifferent, 0, AutoTuner::describe(tuning) + ", " + juce::String(numChannels) + " channels");
+                    expectEquals(metered.deepest, meteredReference.deepest);
+                }
+            }
+        }
+
+        beginTest("Candidates are the whole block and tiles up to half of it, with both kernels");
+        {
+            const auto candidates = AutoTuner::getCandidates(512);
+            expectEquals(static_cast<int>(candidates.size()), 8);
+            expect(candidates.front() == Tuning());
+            expect(std::find(candidates.begin(), candidates.end(), Tuning{ 256, Kernel::fused }) != candidates.end());
+            expect(std::find(candidates.begin(), candidates.end(), Tuning{ 512, Kernel::fused }) == candidates.end());
+
+            expectEquals(static_cast<int>(AutoTuner::getCandidates(100).size()), 2);
+        }
+
+        beginTest("The default stays unless another tuning is clearly faster");
+        {
+            const Tuning fusedTiles{ 128, Kernel::fused };
+            expect(AutoTuner::pick({ { fusedTiles, 9.8 }, { Tuning(), 10.0 } }) == Tuning());
+            expect(AutoTuner::pick({ { fusedTiles, 8.0 }, { Tuning(), 10.0 } }) == fusedTiles);
+            expect(AutoTuner::pick({ { Tuning(), 10.0 }, { fusedTiles, 12.0 } }) == Tuning());
+        }
+
+        beginTest("A measured tuning is cached and saved to the cache file");
+        {
+            const auto file = juce::File::createTempFile(".xml");
+            AutoTuner::setCacheFile(file);
+
+            const juce::dsp::ProcessSpec spec{ TestSignals::sampleRate, 384, 2 };
+            const auto tuning = AutoTuner::getTuning(spec);
+            expect(AutoTuner::getTuning(spec) == tuning);
+
+            const auto candidates = AutoTuner::getCandidates(384);
+            expect(std::find(candidates.begin(), candidates.end(), tuning) != candidates.end());
+
+            const auto xml = juce::parseXML(file);
+            expect(xml != nullptr);
+            if (xml != nullptr)
+            {
+                int numEntries = 0;
+                for (auto* entry : xml->getChildWithTagNameIterator("TUNING"))
+                {
+                    expectEquals(entry->getStringAttribute("cpu"), AutoTuner::getCpuModel());
+                    expectEquals(entry->getIntAttribute("blockSize"), 384);
+                    expectEquals(entry->getIntAttribute("tileSize"), tuning.tileSize);
+                    ++numEntries;
+                }
+                expectEquals(numEntries, 1);
+            }
+
+            AutoTuner::setCacheFile(juce::File());
+            file.deleteFile();
+        }
+
+        beginTest("Tunings in the cache file for this CPU are taken as they are, other CPUs' are not");
+        {
+            const auto file = juce::File::createTempFile(".xml");
+            juce::XmlElement xml("AUTOTUNER");
+            const auto addEntry = [&xml](const juce::String& cpu, int blockSize, int tileSize)
+            {
+                auto* entry = xml.createNewChildElement("TUNING");
+                entry->setAttribute("cpu", cpu);
+                entry->setAttribute("blockSize", blockSize);
+                entry->setAttribute("channels", 2);
+                entry->setAttribute("tileSize", tileSize);
+                entry->setAttribute("kernel", "fused");
+            };
+            addEntry(AutoTuner::getCpuModel(), 123, 64);
+            addEntry("Another CPU", 124, 4096);
+            xml.writeTo(file);
+            AutoTuner::setCacheFile(file);
+
+            expect(AutoTuner::getTuning({ TestSignals::sampleRate, 123, 2 }) == Tuning{ 64, Kernel::fused });
+            expect(AutoTuner::getTuning({ TestSignals::sampleRate, 124, 2 }).tileSize != 4096);
+
+            // Through the compressor, until a tuning is fixed
+            Compressor compressor;
+            compressor.setAutoTune(true);
+            compressor.prepare({ TestSignals::sampleRate, 123, 2 });
+            expect(compressor.getTuning() == Tuning{ 64, Kernel::fused });
+
+            compressor.setTuning({});
+            expect(! compressor.isAutoTuned());
+            compressor.prepare({ TestSignals::sampleRate, 123, 2 });
+            expect(compressor.getTuning() == Tuning());
+
+            AutoTuner::setCacheFile(juce::File());
+            file.deleteFile();
+        }
+    }
+};
+
+static AutoTunerTests autoTunerTests;
+
+//==============================================================================
+class AutoTunerPerformanceTests : public juce::UnitTest
+{
+public:
+    AutoTunerPerformanceTests() : juce::UnitTest("AutoTuner performance", "Performance") {}
+
+    void runTest() override
+    {
+        beginTest("Every candidate at the usual and a large host block, and what a measurement costs");
+
+        for (const int blockSize : { TestSignals::blockSize, 4096 })
+        {
+            const juce::dsp::ProcessSpec spec{ TestSignals::sampleRate, static_cast<juce::uint32>(blockSize), 2 };
+
+            const auto start = juce::Time::getHighResolutionTicks();
+            const auto measurements = AutoTuner::measure(spec);
+            const double milliseconds = 1000.0 * juce::Time::highResolutionTicksToSeconds(juce::Time::getHighResolutionTicks() - start);
+
+            logMessage(juce::String(blockSize) + " sample blocks, measured in " + juce::String(milliseconds, 1) + " ms, picked "
+                       + AutoTuner::describe(AutoTuner::pick(measurements)));
+            for (const auto& measurement : measurements)
+                logMessage("  " + AutoTuner::describe(measurement.tuning) + ": "
+                           + juce::String(measurement.nanosecondsPerFrame, 2) + " ns/frame");
+
+            // It runs in prepare, once per block size and channel count
+           #if ! JUCE_DEBUG
+            expectLessThan(milliseconds, 50.0);
+           #endif
+        }
+    }
+};
+
+static AutoTunerPerformanceTests autoTunerPerformanceTests;
@@ -0,0 +1,250 @@
+/*
+  ==============================================================================
+
+    BatchDaemonTests.cpp
+    Created: 26 Oct 2026 4:10:52pm
+    Author:  Linus
+
+  ==============================================================================
+*/
+
+#include <JuceHeader.h>
+
+#if JUCE_LINUX
+
+#include <atomic>
+#include <fcntl.h>
+#include <limits>
+#include <sys/mman.h>
+#include <thread>
+#include <unistd.h>
+#include <vector>
+#include "../../Daemon/Source/BatchClient.h"
+#include "../../Daemon/Source/BatchServer.h"
+#include "../../Daemon/Source/SharedAudioRegion.h"
+#include "../../Source/Compressor.h"
+#include "TestSignals.h"
+
+class BatchDaemonTests : public juce::UnitTest
+{
+public:
+    BatchDaemonTests() : juce::UnitTest("BatchDaemon", "DSP") {}
+
+    void runTest() override
+    {
+        using BatchProtocol::Status;
+
+        const juce::String socketPath = "/tmp/compressord-tests-" + juce::String(static_cast<int>(getpid())) + ".sock";
+        BatchServer server(2);
+        std::atomic<int> numFinished{ 0 };
+        server.onJobFinished = [&](const BatchServer::JobStats&) { ++numFinished; };
+        expect(server.start(socketPath));
+
+        BatchClient client(socketPath);
+
+        beginTest("A job renders what Compressor::processInterleaved renders, through a ring smaller than the job");
+        {
+            const auto settings = makeSettings(-30.0f);
+            auto rendered = TestSignals::makeBursts(TestSignals::renderLength);
+            const auto expected = renderReference(rendered, settings);
+
+            // 1500 frames doesn't divide the 1024 frame blocks, so the ring wraps mid-block
+            const auto result = client.process(rendered, TestSignals::sampleRate, settings, 1500);
+
+            expect(result.status == Status::ok);
+            expectEquals(static_cast<int>(result.numFrames), TestSignals::renderLength);
+            expectEquals(result.latencyFrames, 0);
+            expect(result.processSeconds > 0.0 && result.processSeconds <= result.wallSeconds);
+            expectMatches(rendered, expected);
+        }
+
+        beginTest("Concurrent jobs each run on their own instance with their own settings");
+        {
+            constexpr int numJobs = 6;
+            std::vector<juce::AudioBuffer<float>> rendered, expected;
+            std::vector<BatchProtocol::Settings> settings;
+            for (int job = 0; job < numJobs; ++job)
+            {
+                settings.push_back(makeSettings(-10.0f - 5.0f * static_cast<float>(job)));
+                rendered.push_back(TestSignals::makeBursts(TestSignals::renderLength));
+                expected.push_back(renderReference(rendered.back(), settings.back()));
+            }
+
+            std::vector<BatchProtocol::JobResult> results(numJobs);
+            std::vector<std::thread> clients;
+            for (int job = 0; job < numJobs; ++job)
+                clients.emplace_back([&, job]
+                {
+                    BatchClient jobClient(socketPath);
+                    results[static_cast<size_t>(job)] = jobClient.process(rendered[static_cast<size_t>(job)], TestSignals::sampleRate,
+                                                                          settings[static_cast<size_t>(job)]);
+                });
+            for (auto& thread : clients)
+                thread.join();
+
+            for (int job = 0; job < numJobs; ++job)
+            {
+                expect(results[static_cast<size_t>(job)].status == Status::ok);
+                expectMatches(rendered[static_cast<size_t>(job)], expected[static_cast<size_t>(job)]);
+            }
+        }
+
+        beginTest("A bad request is refused and the daemon keeps serving");
+        {
+            auto settings = makeSettings(-20.0f);
+            settings.midSide = 1;
+            juce::AudioBuffer<float> mono(1, TestSignals::blockSize);
+            mono.clear();
+            expect(client.process(mono, TestSignals::sampleRate, settings).status == Status::badRequest);
+
+            settings.midSide = 0;
+            expect(client.process(mono, 0.0, settings).status == Status::badRequest);
+            expect(client.process(mono, TestSignals::sampleRate, settings).status == Status::ok);
+        }
+
+        beginTest("Settings outside the parameters' ranges are refused");
+        {
+            juce::AudioBuffer<float> stereo(2, TestSignals::blockSize);
+            stereo.clear();
+
+            auto settings = makeSettings(-20.0f);
+            settings.ratio = 0.5f;
+            expect(client.process(stereo, TestSignals::sampleRate, settings).status == Status::badRequest);
+
+            settings = makeSettings(-20.0f);
+            settings.release = 0.0f;
+            expect(client.process(stereo, TestSignals::sampleRate, settings).status == Status::badRequest);
+
+            settings = makeSettings(-20.0f);
+            settings.mix = 1.5f;
+            expect(client.process(stereo, TestSignals::sampleRate, settings).status == Status::badRequest);
+
+            settings = makeSettings(-20.0f);
+            settings.ceiling = std::numeric_limits<float>::quiet_NaN();
+            expect(client.process(stereo, TestSignals::sampleRate, settings).status == Status::badRequest);
+        }
+
+        beginTest("With true peak on, the lookahead is flushed and the buffer comes back aligned");
+        {
+            auto settings = makeSettings(-30.0f);
+            settings.truePeak = 1;
+            settings.ceiling = -1.0f;
+            auto rendered = TestSignals::makeBursts(TestSignals::renderLength);
+            const auto expected = renderReference(rendered, settings);
+
+            const auto result = client.process(rendered, TestSignals::sampleRate, settings, 1500);
+
+            expect(result.status == Status::ok);
+            expectEquals(static_cast<int>(result.numFrames), TestSignals::renderLength);
+            expectGreaterThan(result.latencyFrames, 0);
+            expectMatches(rendered, expected);
+        }
+
+        beginTest("An opened region keeps the layout it checked, whatever the client writes to the header later");
+        {
+            const juce::String name = "/compressord-tests-region-" + juce::String(static_cast<int>(getpid()));
+            const auto created = SharedAudioRegion::create(name, 2, BatchProtocol::blockFrames);
+            const auto opened = SharedAudioRegion::open(name);
+            expect(created != nullptr && opened != nullptr);
+
+            const int fd = shm_open(name.toRawUTF8(), O_RDWR, 0);
+            void* memory = mmap(nullptr, BatchProtocol::headerSize, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+            close(fd);
+            expect(memory != MAP_FAILED);
+
+            auto* header = static_cast<BatchProtocol::RegionHeader*>(memory);
+            header->numChannels = BatchProtocol::maxChannels;
+            header->capacityFrames = 1 << 30;
+
+            expectEquals(opened->getNumChannels(), 2);
+            expectEquals(opened->getCapacityFrames(), BatchProtocol::blockFrames);
+            expectEquals(opened->getContiguousFrames(BatchProtocol::blockFrames - 1, 16), 1);
+            expect(opened->getOutputFrames(BatchProtocol::blockFrames) == opened->getOutputFrames(0));
+            munmap(memory, BatchProtocol::headerSize);
+        }
+
+        beginTest("Without a daemon the client fails instead of hanging");
+        {
+            BatchClient nowhere(socketPath + ".missing");
+            auto buffer = TestSignals::makeBursts(TestSignals::blockSize);
+            expect(nowhere.process(buffer, TestSignals::sampleRate, makeSettings(-20.0f)).status != Status::ok);
+        }
+
+        beginTest("Finished jobs are counted and timed");
+        {
+            expectEquals(server.getNumJobs(), 9);
+            expectEquals(numFinished.load(), 9);
+            expect(server.getRealtimeFactor() > 0.0);
+
+           #if COMPRESSOR_PROFILING
+            juce::TemporaryFile profile(".csv");
+            expect(server.writeProfile(profile.getFile()));
+            expect(profile.getFile().loadFileAsString().contains("block,"));
+           #endif
+        }
+
+        server.stop();
+        expect(! juce::File(socketPath).exists());
+    }
+
+private:
+    static BatchProtocol::Settings makeSettings(float threshold)
+    {
+        BatchProtocol::Settings settings;
+        settings.threshold = threshold;
+        settings.ratio = 6.0f;
+        settings.attack = 1.0f;
+        settings.release = 80.0f;
+        settings.makeup = 2.0f;
+        settings.mix = 0.75f;
+        return settings;
+    }
+
+    static juce::AudioBuffer<float> renderReference(const juce::AudioBuffer<float>& source, const BatchProtocol::Settings& settings)
+    {
+        Compressor compressor;
+        compressor.prepare(TestSignals::makeSpec());
+        compressor.setInput(settings.inputGain);
+        compressor.setThreshold(settings.threshold);
+        compressor.setRatio(settings.ratio);
+        compressor.setKnee(settings.knee);
+        compressor.setAttack(settings.attack);
+        compressor.setRelease(settings.release);
+        compressor.setMakeup(settings.makeup);
+        compressor.setMix(settings.mix);
+        compressor.setTruePeak(settings.truePeak != 0);
+        compressor.setCeiling(settings.ceiling);
+
+        // The daemon takes the interleaved path, in whatever block sizes the rings allow,
+        // and runs silence through the lookahead after the input
+        const int numChannels = source.getNumChannels();
+        const int latency = compressor.getLatencyInSamples();
+        const int numFrames = source.getNumSamples() + latency;
+        std::vector<float> frames(static_cast<size_t>(numChannels * numFrames));
+        for (int i = 0; i < source.getNumSamples(); ++i)
+            for (int ch = 0; ch < numChannels; ++ch)
+                frames[static_cast<size_t>(i * numChannels + ch)] = source.getSample(ch, i);
+
+        for (int start = 0; start < numFrames; start += TestSignals::blockSize)
+            compressor.processInterleaved(frames.data() + start * numChannels, numChannels,
+                                          juce::jmin(TestSignals::blockSize, numFrames - start));
+
+        // The client takes the delay out
+        juce::AudioBuffer<float> rendered(numChannels, source.getNumSamples());
+        for (int i = 0; i < source.getNumSamples(); ++i)
+            for (int ch = 0; ch < numChannels; ++ch)
+                rendered.setSample(ch, i, frames[static_cast<size_t>((i + latency) * numChannels + ch)]);
+        return rendered;
+    }
+
+    void expectMatches(const juce::AudioBuffer<float>& rendered, const juce::AudioBuffer<float>& expected)
+    {
+        for (int ch = 0; ch < expected.getNumChannels(); ++ch)
+            for (int i = 0; i < expected.getNumSamples(); ++i)
+                expectWithinAbsoluteError(rendered.getSample(ch, i), expected.getSample(ch, i), 1.0e-6f);
+    }
+};
+
+static BatchDaemonTests batchDaemonTests;
+
+#endif
@@ -0,0 +1,221 @@
+/*
+  ==============================================================================
+
+    CompressorBankTests.cpp
+    Created: 21 Oct 2026 10:40:18am
+    Author:  Linus
+
+  ==============================================================================
+*/
+
+#include <JuceHeader.h>
+#include <cmath>
+#include "../../Source/CompressorBank.h"
+#include "TestSignals.h"
+
+namespace
+{
+    // Deliberately not a multiple of any register width, so the last group is padded
+    constexpr int numBankChannels = 11;
+
+    float thresholdFor(int channel) { return -30.0f + 2.0f * static_cast<float>(channel); }
+    float ratioFor(int channel)     { return channel == 0 ? 30.0f : 1.5f + static_cast<float>(channel); }
+    float kneeFor(int channel)      { return static_cast<float>(channel % 3) * 4.0f; }
+    float attackFor(int channel)    { return 1.0f + static_cast<float>(channel); }
+    float releaseFor(int channel)   { return 20.0f + 10.0f * static_cast<float>(channel); }
+
+    juce::dsp::ProcessSpec makeBankSpec(int numChannels)
+    {
+        return { TestSignals::sampleRate, static_cast<juce::uint32>(TestSignals::blockSize), static_cast<juce::uint32>(numChannels) };
+    }
+
+    // Alternating bursts as in TestSignals, with a different tone and phase on every channel
+    juce::AudioBuffer<float> makeBankBursts(int numChannels, int numSamples)
+    {
+        juce::AudioBuffer<float> buffer(numChannels, numSamples);
+        for (int ch = 0; ch < numChannels; ++ch)
+            for (int i = 0; i < numSamples; ++i)
+            {
+                const double envelope = ((i + 128 * ch) / 1024) % 2 == 0 ? 0.05 : 0.8;
+                const double t = static_cast<double>(i) / TestSignals::sampleRate;
+                buffer.setSample(ch, i, static_cast<float>(envelope * std::sin(juce::MathConstants<double>::twoPi * (220.0 + 55.0 * ch) * t)));
+            }
+        return buffer;
+    }
+
+    void renderBank(CompressorBank& bank, juce::AudioBuffer<float>& buffer)
+    {
+        for (int start = 0; start + TestSignals::blockSize <= buffer.getNumSamples(); start += TestSignals::blockSize)
+        {
+            juce::AudioBuffer<float> block(buffer.getArrayOfWritePointers(), buffer.getNumChannels(), start, TestSignals::blockSize);
+            bank.process(block);
+        }
+    }
+}
+
+class CompressorBankTests : public juce::UnitTest
+{
+public:
+    CompressorBankTests() : juce::UnitTest("CompressorBank", "DSP") {}
+
+    void runTest() override
+    {
+        beginTest("Every channel matches a Compressor with the same settings");
+        {
+            CompressorBank bank;
+            bank.prepare(makeBankSpec(numBankChannels));
+            for (int ch = 0; ch < numBankChannels; ++ch)
+            {
+                bank.setThreshold(ch, thresholdFor(ch));
+                bank.setRatio(ch, ratioFor(ch));
+                bank.setKnee(ch, kneeFor(ch));
+                bank.setAttack(ch, attackFor(ch));
+                bank.setRelease(ch, releaseFor(ch));
+                bank.setMakeup(ch, static_cast<float>(ch % 4));
+            }
+
+            const auto input = makeBankBursts(numBankChannels, TestSignals::renderLength);
+            juce::AudioBuffer<float> buffer(input);
+            renderBank(bank, buffer);
+
+            for (int ch = 0; ch < numBankChannels; ++ch)
+            {
+                Compressor compressor;
+                TestSignals::configure(compressor, { 0.0f, thresholdFor(ch), ratioFor(ch), kneeFor(ch), attackFor(ch),
+                                                     releaseFor(ch), static_cast<float>(ch % 4), 1.0f });
+
+                // Dual mono through the linked compressor is the bank's mono channel
+                juce::AudioBuffer<float> expected(2, input.getNumSamples());
+                expected.copyFrom(0, 0, input, ch, 0, input.getNumSamples());
+                expected.copyFrom(1, 0, input, ch, 0, input.getNumSamples());
+                TestSignals::render(compressor, expected);
+
+                // The bank keeps its detector state in float, the scalar detector in double
+                for (int i = 0; i < buffer.getNumSamples(); ++i)
+                {
+                    const float reference = expected.getSample(0, i);
+                    expectWithinAbsoluteError(buffer.getSample(ch, i), reference, 2.0e-4f * std::abs(reference) + 1.0e-7f);
+                }
+
+                expectWithinAbsoluteError(bank.getGainReduction(ch), compressor.getMaxGainReduction(), 1.0e-3f);
+            }
+        }
+
+        beginTest("Channels do not affect each other");
+        {
+            CompressorBank bank;
+            bank.prepare(makeBankSpec(numBankChannels));
+            for (int ch = 0; ch < numBankChannels; ++ch)
+                bank.setThreshold(ch, -40.0f);
+
+            // Only channel 3 carries signal, every other meter stays at zero
+            juce::AudioBuffer<float> buffer(numBankChannels, TestSignals::renderLength);
+            buffer.clear();
+            for (int i = 0; i < buffer.getNumSamples(); ++i)
+                buffer.setSample(3, i, 0.5f);
+
+            renderBank(bank, buffer);
+
+            for (int ch = 0; ch < numBankChannels; ++ch)
+            {
+                if (ch == 3)
+                    expectLessThan(bank.getGainReduction(ch), -10.0f);
+                else
+                    expectEquals(bank.getGainReduction(ch), 0.0f);
+            }
+        }
+
+        beginTest("Parameters survive a re-prepare with more channels");
+        {
+            CompressorBank bank;
+            bank.prepare(makeBankSpec(2));
+            bank.setThreshold(1, -6.0f);
+            bank.prepare(makeBankSpec(numBankChannels));
+
+            // A steady 0 dBFS tone at channel 1 only sees 6 dB of overshoot
+            juce::AudioBuffer<float> buffer(numBankChannels, TestSignals::renderLength);
+            buffer.clear();
+            for (int i = 0; i < buffer.getNumSamples(); ++i)
+            {
+                buffer.setSample(1, i, 1.0f);
+                buffer.setSample(numBankChannels - 1, i, 1.0f);
+            }
+
+            renderBank(bank, buffer);
+            expectGreaterThan(bank.getGainReduction(1), bank.getGainReduction(numBankChannels - 1));
+        }
+    }
+};
+
+static CompressorBankTests compressorBankTests;
+
+//==============================================================================
+class CompressorBankPerformanceTests : public juce::UnitTest
+{
+public:
+    CompressorBankPerformanceTests() : juce::UnitTest("CompressorBank performance", "Performance") {}
+
+    void runTest() override
+    {
+        constexpr int numChannels = 64;
+        constexpr int numBlocks = 200;
+        constexpr int numRuns = 5;
+
+        beginTest("64 channels, bank against one Compressor per channel pair");
+
+        CompressorBank bank;
+        bank.prepare(makeBankSpec(numChannels));
+
+        std::vector<std::unique_ptr<Compressor>> compressors;
+        for (int i = 0; i < numChannels / 2; ++i)
+        {
+            compressors.push_back(std::make_unique<Compressor>());
+            compressors.back()->prepare(TestSignals::makeSpec());
+        }
+
+        const auto source = makeBankBursts(numChannels, TestSignals::blockSize * 8);
+        juce::AudioBuffer<float> block(numChannels, TestSignals::blockSize);
+
+        const auto time = [&](auto&& processBlock)
+        {
+            // Best of several runs to keep scheduler noise out of the number
+            double bestSeconds = std::numeric_limits<double>::max();
+            for (int run = 0; run < numRuns; ++run)
+            {
+                const auto start = juce::Time::getHighResolutionTicks();
+                for (int i = 0; i < numBlocks; ++i)
+                {
+                    for (int ch = 0; ch < numChannels; ++ch)
+                        block.copyFrom(ch, 0, source, ch, (i % 8) * TestSignals::blockSize, TestSignals::blockSize);
+                    processBlock();
+                }
+                bestSeconds = juce::jmin(bestSeconds, juce::Time::highResolutionTicksToSeconds(juce::Time::getHighResolutionTicks() - start));
+            }
+            return bestSeconds * 1.0e9 / (static_cast<double>(numBlocks) * TestSignals::blockSize * numChannels);
+        };
+
+        const double bankNanoseconds = time([&] { bank.process(block); });
+        const double compressorNanoseconds = time([&]
+        {
+            for (size_t i = 0; i < compressors.size(); ++i)
+            {
+                juce::AudioBuffer<float> pair(block.getArrayOfWritePointers() + 2 * i, 2, TestSignals::blockSize);
+                compressors[i]->process(pair);
+            }
+        });
+
+        logMessage("CompressorBank: " + juce::String(bankNanoseconds, 2) + " ns/channel-sample, "
+                   + juce::String(bank.laneWidth) + " channels per register");
+        logMessage("Linked Compressor per channel pair: " + juce::String(compressorNanoseconds, 2) + " ns/channel-sample");
+
+        // 64 channels still have to run comfortably in real time
+        const double realtimeFactor = 1.0e9 / (bankNanoseconds * numChannels * TestSignals::sampleRate);
+       #if ! JUCE_DEBUG
+        expectGreaterThan(realtimeFactor, 10.0);
+       #else
+        juce::ignoreUnused(realtimeFactor);
+       #endif
+    }
+};
+
+static CompressorBankPerformanceTests compressorBankPerformanceTests;
@@ -0,0 +1,948 @@
+/*
+  ==============================================================================
+
+    CompressorTests.cpp
+    Created: 19 Oct 2026 3:21:47pm
+    Author:  Linus
+
+  ==============================================================================
+*/
+
+#include <JuceHeader.h>
+#include <cmath>
+#include <memory>
+#include <vector>
+#include "../../Source/AsyncBlockProcessor.h"
+#include "../../Source/Compressor.h"
+#include "../../Source/LevelEnvelopeFollower.h"
+#include "../../Source/QualityGovernor.h"
+#include "GoldenRenders.h"
+#include "TestSignals.h"
+
+namespace
+{
+    CompressorPreset::Ptr makePreset(const GoldenRenders::Settings& settings, TransferCurve::Ptr curve = nullptr)
+    {
+        return new CompressorPreset({ settings.input, settings.threshold, settings.ratio, settings.knee,
+                                      settings.attack, settings.release, settings.makeup, settings.mix },
+                                    TestSignals::sampleRate, std::move(curve));
+    }
+}
+
+class CompressorTests : public juce::UnitTest
+{
+public:
+    CompressorTests() : juce::UnitTest("Compressor", "DSP") {}
+
+    void runTest() override
+    {
+        beginTest("Steady state gain matches the static curve");
+        {
+            Compressor compressor;
+            TestSignals::configure(compressor, { 0.0f, -20.0f, 4.0f, 0.0f, 1.0f, 10.0f, 0.0f, 1.0f });
+
+            // A constant level roughly 14 dB over the threshold is attenuated by 3/4 of that at 4:1
+            juce::AudioBuffer<float> buffer(2, 16 * TestSignals::blockSize);
+            for (int ch = 0; ch < 2; ++ch)
+                juce::FloatVectorOperations::fill(buffer.getWritePointer(ch), 0.5f, buffer.getNumSamples());
+
+            const float inputInDecibels = juce::Decibels::gainToDecibels(0.5f);
+            const float attenuation = -0.75f * (inputInDecibels + 20.0f);
+
+            TestSignals::render(compressor, buffer);
+            const float outputInDecibels = juce::Decibels::gainToDecibels(buffer.getSample(0, buffer.getNumSamples() - 1));
+            expectWithinAbsoluteError(outputInDecibels, inputInDecibels + attenuation, 1.0e-3f);
+            expectWithinAbsoluteError(compressor.getMaxGainReduction(), attenuation, 1.0e-3f);
+        }
+
+        beginTest("Signals below the threshold pass unchanged");
+        {
+            Compressor compressor;
+            TestSignals::configure(compressor, { 0.0f, -20.0f, 4.0f, 6.0f, 5.0f, 50.0f, 0.0f, 1.0f });
+
+            auto buffer = TestSignals::makeBursts(TestSignals::renderLength);
+            buffer.applyGain(0.05f);
+            const auto input = TestSignals::makeBursts(TestSignals::renderLength);
+            TestSignals::render(compressor, buffer);
+
+            for (int i = 0; i < buffer.getNumSamples(); ++i)
+                expectWithinAbsoluteError(buffer.getSample(0, i), input.getSample(0, i) * 0.05f, 1.0e-6f);
+        }
+
+        beginTest("True peak ceiling holds inter-sample peaks");
+        {
+            Compressor compressor;
+            TestSignals::configure(compressor, { 0.0f, 0.0f, 1.0f, 0.0f, 1.0f, 10.0f, 0.0f, 1.0f });
+            compressor.setTruePeak(true);
+            compressor.setCeiling(-1.0f);
+
+            // A quarter of the sample rate at 45 degrees: samples sit at 0.707, the waveform peaks at 1.0
+            juce::AudioBuffer<float> buffer(2, 16 * TestSignals::blockSize);
+            for (int i = 0; i < buffer.getNumSamples(); ++i)
+                for (int ch = 0; ch < 2; ++ch)
+                    buffer.setSample(ch, i, static_cast<float>(std::sin(juce::MathConstants<double>::halfPi * i + juce::MathConstants<double>::pi / 4.0)));
+
+            TestSignals::render(compressor, buffer);
+
+            // Once settled the whole waveform, not just the samples, sits at the ceiling
+            const float ceiling = juce::Decibels::decibelsToGain(-1.0f);
+            const float samplePeak = buffer.getMagnitude(0, buffer.getNumSamples() - TestSignals::blockSize, TestSignals::blockSize);
+            expectLessOrEqual(samplePeak, ceiling * std::sqrt(0.5f) * 1.01f);
+            expectGreaterThan(samplePeak, ceiling * std::sqrt(0.5f) * 0.97f);
+            expectGreaterThan(compressor.getLatencyInSamples(), 0);
+        }
+
+        beginTest("True peak ceiling holds a decaying train of inter-sample peaks");
+        {
+            Compressor compressor;
+            TestSignals::configure(compressor, { 0.0f, 0.0f, 1.0f, 0.0f, 1.0f, 10.0f, 0.0f, 1.0f });
+            compressor.setTruePeak(true);
+            compressor.setCeiling(-1.0f);
+
+            // Strikes of different heights every 4096 samples, each decaying fast enough that
+            // the gain the ceiling needs keeps rising for longer than the lookahead. Left is
+            // the quarter-rate waveform whose peaks fall between the samples, right the envelope.
+            juce::AudioBuffer<float> buffer(2, 64 * TestSignals::blockSize);
+            for (int i = 0; i < buffer.getNumSamples(); ++i)
+            {
+                const double amplitude = 8.0 * (1.0 + 0.5 * std::sin(1.7 * (i / 4096))) * std::exp(-(i % 4096) / 20.0);
+                buffer.setSample(0, i, static_cast<float>(amplitude * std::sin(juce::MathConstants<double>::halfPi * i
+                                                                                + juce::MathConstants<double>::pi / 4.0)));
+                buffer.setSample(1, i, static_cast<float>(amplitude));
+            }
+
+            TestSignals::render(compressor, buffer);
+
+            const float ceiling = juce::Decibels::decibelsToGain(-1.0f);
+            expectLessOrEqual(buffer.getMagnitude(0, 0, buffer.getNumSamples()), ceiling * std::sqrt(0.5f) * 1.01f);
+            expectLessOrEqual(buffer.getMagnitude(1, 0, buffer.getNumSamples()), ceiling * 1.01f);
+        }
+
+        beginTest("Mid/side matches linked stereo for mono material");
+        {
+            Compressor linked, midSide;
+            TestSignals::configure(linked, GoldenRenders::compressorSettings);
+            TestSignals::configure(midSide, GoldenRenders::compressorSettings);
+            midSide.setMidSide(true);
+
+            // With L == R the side is silent and the mid detector sees exactly max(|L|, |R|)
+            auto expected = TestSignals::makeBursts(TestSignals::renderLength);
+            expected.copyFrom(1, 0, expected, 0, 0, expected.getNumSamples());
+            juce::AudioBuffer<float> buffer(expected);
+
+            TestSignals::render(linked, expected);
+            TestSignals::render(midSide, buffer);
+
+            for (int ch = 0; ch < 2; ++ch)
+                for (int i = 0; i < buffer.getNumSamples(); ++i)
+                    expectWithinAbsoluteError(buffer.getSample(ch, i), expected.getSample(ch, i), 1.0e-6f);
+        }
+
+        beginTest("Mid/side leaves a quiet side untouched under a loud mid");
+        {
+            Compressor compressor;
+            TestSignals::configure(compressor, { 0.0f, -20.0f, 4.0f, 0.0f, 1.0f, 10.0f, 0.0f, 1.0f });
+            compressor.setMidSide(true);
+
+            juce::AudioBuffer<float> buffer(2, 16 * TestSignals::blockSize);
+            for (int i = 0; i < buffer.getNumSamples(); ++i)
+            {
+                const float side = 0.01f * static_cast<float>(std::sin(0.05 * i));
+                buffer.setSample(0, i, 0.5f + side);
+                buffer.setSample(1, i, 0.5f - side);
+            }
+            const juce::AudioBuffer<float> input(buffer);
+
+            TestSignals::render(compressor, buffer);
+
+            // Mid is held down at 4:1, side comes back out exactly as it went in
+            for (int i = 0; i < buffer.getNumSamples(); ++i)
+            {
+                const float sideIn = 0.5f * (input.getSample(0, i) - input.getSample(1, i));
+                const float sideOut = 0.5f * (buffer.getSample(0, i) - buffer.getSample(1, i));
+                expectWithinAbsoluteError(sideOut, sideIn, 1.0e-6f);
+            }
+
+            const float midOut = 0.5f * (buffer.getSample(0, buffer.getNumSamples() - 1) + buffer.getSample(1, buffer.getNumSamples() - 1));
+            expectLessThan(midOut, 0.25f);
+        }
+
+        beginTest("Mono blocks are compressed linked with mid/side on");
+        {
+            const auto source = TestSignals::makeBursts(1, TestSignals::renderLength);
+
+            const auto renderMono = [&](bool midSide, int route)
+            {
+                Compressor compressor;
+                TestSignals::configure(compressor, GoldenRenders::compressorSettings, TestSignals::makeSpec(1));
+                compressor.setMidSide(midSide);
+
+                juce::AudioBuffer<float> buffer(source);
+                juce::ThreadPool pool(2);
+                if (route == 0)
+                    TestSignals::render(compressor, buffer);
+                else if (route == 1)
+                    for (int start = 0; start < TestSignals::renderLength; start += TestSignals::blockSize)
+                        compressor.processInterleaved(buffer.getWritePointer(0, start), 1,
+                                                      juce::jmin(TestSignals::blockSize, TestSignals::renderLength - start));
+                else if (route == 2)
+                    compressor.processOffline(buffer, pool);
+                else
+                    compressor.processParallel(buffer, pool);
+                return buffer;
+            };
+
+            // process, processInterleaved, processOffline and processParallel
+            for (int route = 0; route < 4; ++route)
+            {
+                const auto linked = renderMono(false, route);
+                const auto midSide = renderMono(true, route);
+                for (int i = 0; i < TestSignals::renderLength; ++i)
+                    expectEquals(midSide.getSample(0, i), linked.getSample(0, i));
+            }
+        }
+
+        beginTest("Offline mode leads transients instead of lagging them");
+        {
+            Compressor realtime, offline;
+            TestSignals::configure(realtime, { 0.0f, -30.0f, 4.0f, 0.0f, 10.0f, 100.0f, 0.0f, 1.0f });
+            TestSignals::configure(offline, { 0.0f, -30.0f, 4.0f, 0.0f, 10.0f, 100.0f, 0.0f, 1.0f });
+
+            // Quiet, then a loud step halfway through
+            constexpr int stepAt = TestSignals::renderLength / 2;
+            juce::AudioBuffer<float> expected(2, TestSignals::renderLength);
+            for (int ch = 0; ch < 2; ++ch)
+                for (int i = 0; i < expected.getNumSamples(); ++i)
+                    expected.setSample(ch, i, i < stepAt ? 0.01f : 0.5f);
+            juce::AudioBuffer<float> buffer(expected);
+
+            juce::ThreadPool pool(2);
+            TestSignals::render(realtime, expected);
+            offline.processOffline(buffer, pool);
+
+            // The causal detector only starts after the step, the offline one before it
+            expectEquals(expected.getSample(0, stepAt - 10), 0.01f);
+            expectLessThan(buffer.getSample(0, stepAt - 10), 0.01f * 0.99f);
+
+            // And is further down right after the step
+            expectLessThan(buffer.getSample(0, stepAt + 10), expected.getSample(0, stepAt + 10));
+
+            // Settled, both sit on the static curve
+            expectWithinAbsoluteError(buffer.getSample(0, expected.getNumSamples() - 1),
+                                      expected.getSample(0, expected.getNumSamples() - 1), 1.0e-3f);
+        }
+
+        beginTest("Offline mode does not depend on the number of threads");
+        {
+            const auto source = TestSignals::makeBursts(3 * ParallelSegments::defaultSegmentSize + 1000);
+
+            for (const bool midSide : { false, true })
+            {
+                juce::AudioBuffer<float> results[2] = { source, source };
+                const int numThreads[2] = { 1, 4 };
+
+                for (int run = 0; run < 2; ++run)
+                {
+                    Compressor compressor;
+                    TestSignals::configure(compressor, GoldenRenders::compressorSettings);
+                    compressor.setMidSide(midSide);
+
+                    juce::ThreadPool pool(numThreads[run]);
+                    compressor.processOffline(results[run], pool);
+                }
+
+                for (int ch = 0; ch < 2; ++ch)
+                    for (int i = 0; i < source.getNumSamples(); i += 7)
+                        expectEquals(results[0].getSample(ch, i), results[1].getSample(ch, i));
+            }
+        }
+
+        beginTest("Parallel rendering matches process within its tolerance");
+        {
+            constexpr GoldenRenders::Settings settings{ 0.0f, -30.0f, 4.0f, 6.0f, 2.0f, 20.0f, 2.0f, 1.0f };
+
+            for (const bool midSide : { false, true })
+            {
+                Compressor serial, parallel;
+                TestSignals::configure(serial, settings);
+                TestSignals::configure(parallel, settings);
+                serial.setMidSide(midSide);
+                parallel.setMidSide(midSide);
+
+                // Long enough for a few segments, with detectors that really need their pre-roll
+                const int preRoll = parallel.getParallelPreRoll(0.0f);
+                expectGreaterThan(preRoll, 0);
+                const int segmentSize = juce::jmax(ParallelSegments::defaultSegmentSize, 8 * preRoll);
+                const int numSamples = (3 * segmentSize / TestSignals::blockSize + 1) * TestSignals::blockSize;
+
+                auto expected = TestSignals::makeBursts(numSamples);
+                juce::AudioBuffer<float> buffer(expected);
+
+                TestSignals::render(serial, expected);
+                juce::ThreadPool pool(4);
+                parallel.processParallel(buffer, pool);
+
+                // parallelTolerance dB of gain, plus rounding
+                const float relativeError = juce::Decibels::decibelsToGain(Compressor::parallelTolerance) - 1.0f + 1.0e-6f;
+                for (int ch = 0; ch < 2; ++ch)
+                    for (int i = 0; i < numSamples; ++i)
+                    {
+                        const float reference = expected.getSample(ch, i);
+                        expectWithinAbsoluteError(buffer.getSample(ch, i), reference, relativeError * std::abs(reference) + 1.0e-8f);
+                    }
+
+                // The first segment has no pre-roll and is exact
+                for (int i = 0; i < segmentSize; i += 13)
+                    expectEquals(buffer.getSample(0, i), expected.getSample(0, i));
+            }
+        }
+
+        beginTest("A preset renders exactly like the same settings set one by one");
+        {
+            Compressor expected, switched;
+            TestSignals::configure(expected, GoldenRenders::compressorSettings);
+            TestSignals::configure(switched, GoldenRenders::limiterSettings);
+            switched.setPreset(makePreset(GoldenRenders::compressorSettings), false);
+
+            auto expectedBuffer = TestSignals::makeBursts(TestSignals::renderLength);
+            auto buffer = TestSignals::makeBursts(TestSignals::renderLength);
+            TestSignals::render(expected, expectedBuffer);
+            TestSignals::render(switched, buffer);
+
+            for (int ch = 0; ch < 2; ++ch)
+                for (int i = 0; i < buffer.getNumSamples(); ++i)
+                    expectEquals(buffer.getSample(ch, i), expectedBuffer.getSample(ch, i));
+        }
+
+        beginTest("A crossfaded switch fades from the old to the new settings over one block");
+        {
+            constexpr int switchBlock = 4;
+            const auto preset = makePreset(GoldenRenders::limiterSettings);
+            const auto source = TestSignals::makeBursts(TestSignals::renderLength);
+
+            // Renders the bursts, switching to the preset before switchBlock
+            const auto renderSwitching = [&](bool doSwitch, bool crossfade)
+            {
+                Compressor compressor;
+                TestSignals::configure(compressor, GoldenRenders::compressorSettings);
+
+                juce::AudioBuffer<float> buffer(source);
+                for (int block = 0; block < TestSignals::renderLength / TestSignals::blockSize; ++block)
+                {
+                    if (doSwitch && block == switchBlock)
+                        compressor.setPreset(preset, crossfade);
+
+                    juce::AudioBuffer<float> view(buffer.getArrayOfWritePointers(), 2, block * TestSignals::blockSize, TestSignals::blockSize);
+                    compressor.process(view);
+                }
+                return buffer;
+            };
+
+            const auto unchanged = renderSwitching(false, false);
+            const auto instant = renderSwitching(true, false);
+            const auto faded = renderSwitching(true, true);
+
+            constexpr int first = switchBlock * TestSignals::blockSize;
+            constexpr int last = first + TestSignals::blockSize - 1;
+            for (int ch = 0; ch < 2; ++ch)
+            {
+                // Starts one step away from the old rendering and ends on the new one
+                const float step = std::abs(instant.getSample(ch, first) - unchanged.getSample(ch, first)) / TestSignals::blockSize;
+                expectWithinAbsoluteError(faded.getSample(ch, first), unchanged.getSample(ch, first), step + 1.0e-6f);
+                expectWithinAbsoluteError(faded.getSample(ch, last), instant.getSample(ch, last), 1.0e-6f);
+
+                // Both halves ran from the same detector state, so afterwards nothing is left of the fade
+                for (int i = last + 1; i < faded.getNumSamples(); ++i)
+                    expectEquals(faded.getSample(ch, i), instant.getSample(ch, i));
+            }
+        }
+
+        beginTest("Blocks wider than the copies a crossfade needs switch presets at once");
+        {
+            constexpr int numChannels = Compressor::maxCopiedChannels + 4;
+            const auto preset = makePreset(GoldenRenders::limiterSettings);
+
+            const auto renderSwitching = [&](bool crossfade)
+            {
+                Compressor compressor;
+                TestSignals::configure(compressor, GoldenRenders::compressorSettings);
+                compressor.prepare(TestSignals::makeSpec(numChannels));
+                compressor.setPreset(preset, crossfade);
+
+                auto buffer = TestSignals::makeBursts(numChannels, TestSignals::renderLength);
+                TestSignals::render(compressor, buffer);
+                return buffer;
+            };
+
+            const auto instant = renderSwitching(false);
+            const auto faded = renderSwitching(true);
+
+            int numDifferent = 0;
+            for (int ch = 0; ch < numChannels; ++ch)
+                for (int i = 0; i < TestSignals::renderLength; ++i)
+                    numDifferent += faded.getSample(ch, i) != instant.getSample(ch, i) ? 1 : 0;
+            expectEquals(numDifferent, 0);
+        }
+
+        beginTest("Interleaved blocks wider than the planar copies are compressed linked");
+        {
+            constexpr int numChannels = Compressor::maxCopiedChannels + 4;
+            const auto source = TestSignals::makeBursts(numChannels, TestSignals::renderLength);
+
+            const auto renderInterleaved = [&](bool truePeak)
+            {
+                Compressor compressor;
+                TestSignals::configure(compressor, GoldenRenders::compressorSettings);
+                compressor.prepare(TestSignals::makeSpec(numChannels));
+                compressor.setTruePeak(truePeak);
+
+                std::vector<float> interleaved(static_cast<size_t>(numChannels * TestSignals::renderLength));
+                for (int i = 0; i < TestSignals::renderLength; ++i)
+                    for (int ch = 0; ch < numChannels; ++ch)
+                        interleaved[static_cast<size_t>(i * numChannels + ch)] = source.getSample(ch, i);
+
+                for (int start = 0; start < TestSignals::renderLength; start += TestSignals::blockSize)
+                    compressor.processInterleaved(interleaved.data() + start * numChannels, numChannels, TestSignals::blockSize);
+                return interleaved;
+            };
+
+            expect(renderInterleaved(true) == renderInterleaved(false));
+        }
+
+        beginTest("Blocks longer than prepare's maximum are processed in parts of that size");
+        {
+            constexpr int longBlock = 3 * TestSignals::blockSize + 17;
+            const auto source = TestSignals::makeBursts(4 * longBlock);
+
+            for (const bool interleave : { false, true })
+            {
+                for (const bool truePeak : { false, true })
+                {
+                    Compressor whole, parts;
+                    for (auto* compressor : { &whole, &parts })
+                    {
+                        TestSignals::configure(*compressor, GoldenRenders::compressorSettings);
+                        compressor->setTruePeak(truePeak);
+                    }
+
+                    const auto render = [&](Compressor& compressor, juce::AudioBuffer<float>& block)
+                    {
+                        if (! interleave)
+                        {
+                            compressor.process(block);
+                            return;
+                        }
+
+                        std::vector<float> interleaved(static_cast<size_t>(2 * block.getNumSamples()));
+                        for (int i = 0; i < block.getNumSamples(); ++i)
+                            for (int ch = 0; ch < 2; ++ch)
+                                interleaved[static_cast<size_t>(2 * i + ch)] = block.getSample(ch, i);
+                        compressor.processInterleaved(interleaved.data(), 2, block.getNumSamples());
+                        for (int i = 0; i < block.getNumSamples(); ++i)
+                            for (int ch = 0; ch < 2; ++ch)
+                                block.setSample(ch, i, interleaved[static_cast<size_t>(2 * i + ch)]);
+                    };
+
+                    juce::AudioBuffer<float> expected(source), rendered(source);
+                    for (int start = 0; start < source.getNumSamples(); start += longBlock)
+                    {
+                        float inputPeak = 0.0f, outputPeak = 0.0f;
+                        for (int part = start; part < start + longBlock; part += TestSignals::blockSize)
+                        {
+                            juce::AudioBuffer<float> block(expected.getArrayOfWritePointers(), 2, part,
+                                                           juce::jmin(TestSignals::blockSize, start + longBlock - part));
+                            render(parts, block);
+                            inputPeak = juce::jmax(inputPeak, parts.getInputPeak());
+                            outputPeak = juce::jmax(outputPeak, parts.getOutputPeak());
+                        }
+
+                        juce::AudioBuffer<float> block(rendered.getArrayOfWritePointers(), 2, start, longBlock);
+                        render(whole, block);
+                        expectEquals(whole.getInputPeak(), inputPeak);
+                        expectEquals(whole.getOutputPeak(), outputPeak);
+                    }
+
+                    for (int ch = 0; ch < 2; ++ch)
+                        for (int i = 0; i < source.getNumSamples(); ++i)
+                            expectEquals(rendered.getSample(ch, i), expected.getSample(ch, i));
+                }
+            }
+        }
+
+        beginTest("Reduced qualities stay close to full quality");
+        {
+            const auto renderAt = [](Compressor::Quality quality, const GoldenRenders::Settings& settings, bool midSide)
+            {
+                Compressor compressor;
+                TestSignals::configure(compressor, settings);
+                compressor.setMidSide(midSide);
+                compressor.setQuality(quality);
+
+                auto buffer = TestSignals::makeBursts(TestSignals::renderLength);
+                TestSignals::render(compressor, buffer);
+                return buffer;
+            };
+
+            // Interpolating a quarter-rate gain mostly smears the attack of each burst
+            const std::pair<Compressor::Quality, float> qualities[] = { { Compressor::Quality::approximate, 0.01f },
+                                                                        { Compressor::Quality::decimated, 0.5f } };
+
+            for (const auto* settings : { &GoldenRenders::compressorSettings, &GoldenRenders::limiterSettings })
+                for (const bool midSide : { false, true })
+                {
+                    const auto full = renderAt(Compressor::Quality::full, *settings, midSide);
+
+                    for (const auto& [quality, toleranceInDecibels] : qualities)
+                    {
+                        const auto reduced = renderAt(quality, *settings, midSide);
+                        const float relativeError = juce::Decibels::decibelsToGain(toleranceInDecibels) - 1.0f;
+
+                        // Relative to the larger channel: with mid/side a gain error in mid or side
+                        // is relative to |mid| + |side|, which is max(|L|, |R|)
+                        for (int i = 0; i < full.getNumSamples(); ++i)
+                        {
+                            const float magnitude = juce::jmax(std::abs(full.getSample(0, i)), std::abs(full.getSample(1, i)));
+                            for (int ch = 0; ch < 2; ++ch)
+                                expectWithinAbsoluteError(reduced.getSample(ch, i), full.getSample(ch, i), relativeError * magnitude + 1.0e-6f);
+                        }
+                    }
+                }
+        }
+
+        beginTest("Switching quality between blocks doesn't step the gain");
+        {
+            Compressor compressor;
+            TestSignals::configure(compressor, GoldenRenders::compressorSettings);
+
+            // A steady tone, so any jump at a block boundary comes from the switch
+            constexpr int numBlocks = 12;
+            juce::AudioBuffer<float> buffer(2, numBlocks * TestSignals::blockSize);
+            for (int i = 0; i < buffer.getNumSamples(); ++i)
+                for (int ch = 0; ch < 2; ++ch)
+                    buffer.setSample(ch, i, 0.5f);
+
+            const Compressor::Quality sequence[] = { Compressor::Quality::full, Compressor::Quality::decimated,
+                                                     Compressor::Quality::approximate, Compressor::Quality::decimated };
+            for (int block = 0; block < numBlocks; ++block)
+            {
+                compressor.setQuality(sequence[block % 4]);
+                juce::AudioBuffer<float> view(buffer.getArrayOfWritePointers(), 2, block * TestSignals::blockSize, TestSignals::blockSize);
+                compressor.process(view);
+            }
+
+            // Settled after a few blocks, the gain then moves by far less than 0.01 dB a sample
+            for (int i = 4 * TestSignals::blockSize; i < buffer.getNumSamples(); ++i)
+                expectWithinAbsoluteError(buffer.getSample(0, i), buffer.getSample(0, i - 1), 0.5f * 1.2e-3f);
+        }
+
+        beginTest("A chain renders what its stages render as compressors in series");
+        {
+            for (const bool midSide : { false, true })
+            {
+                Compressor chain, peak, leveller;
+                TestSignals::configure(chain, GoldenRenders::compressorSettings);
+                TestSignals::configure(peak, GoldenRenders::compressorSettings);
+                TestSignals::configure(leveller, levellerSettings);
+                chain.setNumStages(2);
+                chain.setStage(1, levellerStage);
+                for (auto* compressor : { &chain, &peak, &leveller })
+                    compressor->setMidSide(midSide);
+
+                auto expected = TestSignals::makeBursts(TestSignals::renderLength);
+                juce::AudioBuffer<float> buffer(expected);
+                TestSignals::render(peak, expected);
+                TestSignals::render(leveller, expected);
+                TestSignals::render(chain, buffer);
+
+                // The leveller's side-chain in series is the peak stage's output, whose level in
+                // dB the chain works out by adding, so only rounding separates the two
+                for (int ch = 0; ch < 2; ++ch)
+                    for (int i = 0; i < buffer.getNumSamples(); ++i)
+                        expectWithinAbsoluteError(buffer.getSample(ch, i), expected.getSample(ch, i),
+                                                  1.0e-5f * std::abs(expected.getSample(ch, i)) + 1.0e-7f);
+
+                expectLessThan(chain.getMaxGainReduction(), peak.getMaxGainReduction());
+            }
+        }
+
+        beginTest("A chain of one stage is the compressor alone, whatever the other stages are set to");
+        {
+            Compressor plain, chain;
+            TestSignals::configure(plain, GoldenRenders::compressorSettings);
+            TestSignals::configure(chain, GoldenRenders::compressorSettings);
+            chain.setStage(1, levellerStage);
+            chain.setNumStages(3);
+            chain.setNumStages(1);
+            expectEquals(chain.getNumStages(), 1);
+
+            auto expected = TestSignals::makeBursts(TestSignals::renderLength);
+            juce::AudioBuffer<float> buffer(expected);
+            TestSignals::render(plain, expected);
+            TestSignals::render(chain, buffer);
+
+            for (int ch = 0; ch < 2; ++ch)
+                for (int i = 0; i < buffer.getNumSamples(); ++i)
+                    expectEquals(buffer.getSample(ch, i), expected.getSample(ch, i));
+        }
+
+        beginTest("A stage at 1:1 adds nothing but its makeup, at every quality");
+        {
+            const float stageMakeup = 4.0f;
+            const float makeupGain = juce::Decibels::decibelsToGain(stageMakeup);
+
+            for (const auto quality : { Compressor::Quality::full, Compressor::Quality::approximate, Compressor::Quality::decimated })
+            {
+                Compressor plain, chain;
+                TestSignals::configure(plain, GoldenRenders::compressorSettings);
+                TestSignals::configure(chain, GoldenRenders::compressorSettings);
+                plain.setQuality(quality);
+                chain.setQuality(quality);
+                chain.setNumStages(2);
+                chain.setStage(1, { -40.0f, 1.0f, 0.0f, 1.0f, 10.0f, stageMakeup });
+
+                auto expected = TestSignals::makeBursts(TestSignals::renderLength);
+                juce::AudioBuffer<float> buffer(expected);
+                TestSignals::render(plain, expected);
+                TestSignals::render(chain, buffer);
+
+                // Relative to 0.01 dB at reduced quality, FastDecibels' error on the larger gain
+                const float tolerance = quality == Compressor::Quality::full ? 1.0e-5f : 1.2e-3f;
+                for (int ch = 0; ch < 2; ++ch)
+                    for (int i = 0; i < buffer.getNumSamples(); ++i)
+                        expectWithinAbsoluteError(buffer.getSample(ch, i), expected.getSample(ch, i) * makeupGain,
+                                                  tolerance * std::abs(buffer.getSample(ch, i)) + 1.0e-7f);
+            }
+        }
+
+        beginTest("The metered peaks are the block's max |x| over the channels, before the input gain and as it leaves");
+        {
+            const auto blockPeak = [](const juce::AudioBuffer<float>& buffer)
+            {
+                float peak = 0.0f;
+                for (int ch = 0; ch < buffer.getNumChannels(); ++ch)
+                    for (int i = 0; i < buffer.getNumSamples(); ++i)
+                        peak = juce::jmax(peak, std::abs(buffer.getSample(ch, i)));
+                return peak;
+            };
+
+            const auto source = TestSignals::makeBursts(4 * TestSignals::blockSize);
+            // linked, mid/side, true peak, interleaved, bypassed, fused tiles, multi-pass tiles,
+            // decimated and crossfading presets
+            for (const int mode : { 0, 1, 2, 3, 4, 5, 6, 7, 8 })
+            {
+                Compressor compressor;
+                TestSignals::configure(compressor, GoldenRenders::limiterSettings);   // 6 dB of input gain
+                compressor.setMidSide(mode == 1);
+                compressor.setTruePeak(mode == 2);
+                if (mode == 4)
+                    compressor.setPower();
+                if (mode == 5 || mode == 6)
+                    compressor.setTuning({ 64, mode == 5 ? Compressor::Kernel::fused : Compressor::Kernel::multiPass });
+                if (mode == 7)
+                    compressor.setQuality(Compressor::Quality::decimated);
+
+                for (int start = 0; start < source.getNumSamples(); start += TestSignals::blockSize)
+                {
+                    if (mode == 8)
+                        compressor.setPreset(makePreset(start % (2 * TestSignals::blockSize) == 0 ? GoldenRenders::compressorSettings
+                                                                                                  : GoldenRenders::limiterSettings), true);
+
+                    juce::AudioBuffer<float> block(2, TestSignals::blockSize);
+                    for (int ch = 0; ch < 2; ++ch)
+                        block.copyFrom(ch, 0, source, ch, start, TestSignals::blockSize);
+                    const float inputPeak = blockPeak(block);
+
+                    if (mode == 3)
+                    {
+                        std::vector<float> interleaved(2 * TestSignals::blockSize);
+                        for (int i = 0; i < TestSignals::blockSize; ++i)
+                            for (int ch = 0; ch < 2; ++ch)
+                                interleaved[static_cast<size_t>(2 * i + ch)] = block.getSample(ch, i);
+                        compressor.processInterleaved(interleaved.data(), 2, TestSignals::blockSize);
+                        for (int i = 0; i < TestSignals::blockSize; ++i)
+                            for (int ch = 0; ch < 2; ++ch)
+                                block.setSample(ch, i, interleaved[static_cast<size_t>(2 * i + ch)]);
+                    }
+                    else
+                    {
+                        compressor.process(block);
+                    }
+
+                    expectEquals(compressor.getInputPeak(), inputPeak);
+                    expectEquals(compressor.getOutputPeak(), blockPeak(block));
+                }
+            }
+        }
+
+        beginTest("Preset banks at one sample rate share their presets, names stay per bank");
+        {
+            PresetBank first, second, otherRate;
+            first.prepare(TestSignals::sampleRate);
+            second.prepare(TestSignals::sampleRate);
+            otherRate.prepare(2.0 * TestSignals::sampleRate);
+
+            for (int i = 0; i < first.getNumPresets(); ++i)
+            {
+                expect(first.getPreset(i) != nullptr);
+                expect(first.getPreset(i) == second.getPreset(i));
+                expect(first.getPreset(i) != otherRate.getPreset(i));
+                expectEquals(first.getPreset(i)->settings.threshold, first.getSettings(i).threshold);
+            }
+
+            first.setName(1, "Renamed");
+            expectEquals(first.getName(1), juce::String("Renamed"));
+            expectEquals(second.getName(1), juce::String("Gentle Glue"));
+        }
+
+        beginTest("Golden render: soft knee compressor");
+        expectMatchesGolden(GoldenRenders::compressorSettings, GoldenRenders::compressor);
+
+        beginTest("Golden render: limiter with parallel mix");
+        expectMatchesGolden(GoldenRenders::limiterSettings, GoldenRenders::limiter);
+    }
+
+private:
+    // A slow levelling stage behind the golden compressor, as a stage and as a compressor of its own
+    static constexpr Compressor::StageSettings levellerStage{ -30.0f, 2.0f, 6.0f, 30.0f, 400.0f, 2.0f };
+    static constexpr GoldenRenders::Settings levellerSettings{ 0.0f, -30.0f, 2.0f, 6.0f, 30.0f, 400.0f, 2.0f, 1.0f };
+
+    // 0.001 dB of relative error, plus an absolute floor for samples near zero crossings
+    static constexpr float relativeTolerance = 1.2e-4f;
+    static constexpr float absoluteTolerance = 1.0e-7f;
+
+    void expectMatchesGolden(const GoldenRenders::Settings& settings,
+                             const float (&golden)[2][GoldenRenders::numPoints])
+    {
+        Compressor compressor;
+        TestSignals::configure(compressor, settings);
+
+        auto buffer = TestSignals::makeBursts(TestSignals::renderLength);
+        TestSignals::render(compressor, buffer);
+
+        for (int ch = 0; ch < 2; ++ch)
+        {
+            for (int point = 0; point < GoldenRenders::numPoints; ++point)
+            {
+                const float expected = golden[ch][point];
+                const float actual = buffer.getSample(ch, point * GoldenRenders::stride);
+                expectWithinAbsoluteError(actual, expected, std::abs(expected) * relativeTolerance + absoluteTolerance,
+                                          "channel " + juce::String(ch) + ", sample " + juce::String(point * GoldenRenders::stride));
+            }
+        }
+    }
+};
+
+static CompressorTests compressorTests;
+
+// Throughput guard for optimisations, run on its own with the "Performance" argument.
+// Thresholds are real-time factors so they hold across reasonably recent machines.
+class CompressorPerformanceTests : public juce::UnitTest
+{
+public:
+    CompressorPerformanceTests() : juce::UnitTest("Compressor performance", "Performance") {}
+
+    void runTest() override
+    {
+        beginTest("Compressor::process real-time factor");
+        {
+            Compressor compressor;
+            TestSignals::configure(compressor, GoldenRenders::compressorSettings);
+            measure(compressor, "Compressor::process");
+        }
+
+        beginTest("Compressor::process with true peak ceiling real-time factor");
+        {
+            Compressor compressor;
+            TestSignals::configure(compressor, GoldenRenders::compressorSettings);
+            compressor.setTruePeak(true);
+            measure(compressor, "Compressor::process with true peak");
+        }
+
+        beginTest("Compressor::process in mid/side mode real-time factor");
+        {
+            Compressor compressor;
+            TestSignals::configure(compressor, GoldenRenders::compressorSettings);
+            compressor.setMidSide(true);
+            measure(compressor, "Compressor::process mid/side");
+        }
+
+        beginTest("Compressor::process with a two-stage chain against two instances in series");
+        {
+            Compressor chain, peak, leveller;
+            TestSignals::configure(chain, GoldenRenders::compressorSettings);
+            TestSignals::configure(peak, GoldenRenders::compressorSettings);
+            TestSignals::configure(leveller, { 0.0f, -30.0f, 2.0f, 6.0f, 30.0f, 400.0f, 2.0f, 1.0f });
+            chain.setNumStages(2);
+            chain.setStage(1, { -30.0f, 2.0f, 6.0f, 30.0f, 400.0f, 2.0f });
+
+            const double chainSeconds = measure(chain, "Compressor::process two-stage chain");
+
+            struct Series
+            {
+                Compressor& first;
+                Compressor& second;
+                void process(juce::AudioBuffer<float>& block) { first.process(block); second.process(block); }
+            } series{ peak, leveller };
+
+            const double seriesSeconds = measure(series, "Two Compressor::process in series", 2);
+            logMessage("Two-stage chain: " + juce::String(seriesSeconds / chainSeconds, 2) + "x as fast as two instances");
+        }
+
+        beginTest("Compressor::processParallel speed-up on one long file");
+        {
+            Compressor serial, parallel;
+            TestSignals::configure(serial, GoldenRenders::compressorSettings);
+            TestSignals::configure(parallel, GoldenRenders::compressorSettings);
+
+            // Five minutes at 48 kHz
+            constexpr int numSamples = 5 * 60 * 48000 / TestSignals::blockSize * TestSignals::blockSize;
+            auto serialBuffer = TestSignals::makeBursts(numSamples);
+            juce::AudioBuffer<float> parallelBuffer(serialBuffer);
+
+            auto start = juce::Time::getHighResolutionTicks();
+            TestSignals::render(serial, serialBuffer);
+            const double serialSeconds = juce::Time::highResolutionTicksToSeconds(juce::Time::getHighResolutionTicks() - start);
+
+            juce::ThreadPool pool;
+            start = juce::Time::getHighResolutionTicks();
+            parallel.processParallel(parallelBuffer, pool);
+            const double parallelSeconds = juce::Time::highResolutionTicksToSeconds(juce::Time::getHighResolutionTicks() - start);
+
+            logMessage("Compressor::processParallel: " + juce::String(serialSeconds / parallelSeconds, 1) + "x faster than process on "
+                       + juce::String(pool.getNumThreads()) + " threads, pre-roll " + juce::String(parallel.getParallelPreRoll(0.0f)) + " samples");
+        }
+
+        beginTest("DSP session load: create, prepare and run a first block through the DSP objects of many instances");
+        {
+            // What a plugin instance owns besides its parameters and editor; instances are
+            // kept alive as a session would. The whole processor is measured in
+            // PluginProcessorTests, the difference is what the parameters cost.
+            struct Instance
+            {
+                Compressor compressor;
+                PresetBank presets;
+                QualityGovernor qualityGovernor;
+                LevelEnvelopeFollower inLevelFollower, outLevelFollower;
+                AsyncBlockProcessor asyncProcessor{ [this](juce::AudioBuffer<float>& block) { compressor.process(block); } };
+            };
+
+            constexpr int numInstances = 500;
+            const auto spec = TestSignals::makeSpec();
+            const auto source = TestSignals::makeBursts(TestSignals::blockSize);
+            juce::AudioBuffer<float> block(2, TestSignals::blockSize);
+
+            double bestSeconds = std::numeric_limits<double>::max();
+            for (int run = 0; run < 3; ++run)
+            {
+                std::vector<std::unique_ptr<Instance>> session;
+                session.reserve(numInstances);
+
+                const auto start = juce::Time::getHighResolutionTicks();
+                for (int i = 0; i < numInstances; ++i)
+                {
+                    auto& instance = *session.emplace_back(std::make_unique<Instance>());
+                    instance.compressor.prepare(spec);
+                    instance.presets.prepare(spec.sampleRate);
+                    instance.qualityGovernor.prepare(spec.sampleRate);
+                    instance.inLevelFollower.prepare(spec.sampleRate);
+                    instance.outLevelFollower.prepare(spec.sampleRate);
+                    instance.asyncProcessor.prepare(static_cast<int>(spec.numChannels), TestSignals::blockSize);
+
+                    for (int ch = 0; ch < 2; ++ch)
+                        block.copyFrom(ch, 0, source, ch, 0, TestSignals::blockSize);
+                    instance.asyncProcessor.process(block);
+                }
+                bestSeconds = juce::jmin(bestSeconds, juce::Time::highResolutionTicksToSeconds(juce::Time::getHighResolutionTicks() - start));
+            }
+
+            const double microsecondsPerInstance = bestSeconds * 1.0e6 / numInstances;
+            logMessage("DSP session load: " + juce::String(microsecondsPerInstance, 1) + " us per instance, "
+                       + juce::String(bestSeconds * 1.0e3, 1) + " ms for " + juce::String(numInstances));
+
+           #if ! JUCE_DEBUG
+            expectLessThan(microsecondsPerInstance, maximumMicrosecondsPerInstance);
+           #endif
+        }
+
+        beginTest("GainEnvelope::apply against compressing every stem");
+        {
+            constexpr int numStems = 8;
+            constexpr int numSamples = 60 * 48000 / TestSignals::blockSize * TestSignals::blockSize;
+            const auto source = TestSignals::makeBursts(numSamples);
+
+            // One analysis of the mix, then a multiply per stem
+            auto start = juce::Time::getHighResolutionTicks();
+            GainEnvelope envelope(TestSignals::sampleRate, false, numSamples);
+            {
+                Compressor compressor;
+                TestSignals::configure(compressor, GoldenRenders::compressorSettings);
+                compressor.setGainEnvelope(&envelope);
+                juce::AudioBuffer<float> mix(source);
+                TestSignals::render(compressor, mix);
+            }
+            for (int stem = 0; stem < numStems; ++stem)
+            {
+                juce::AudioBuffer<float> buffer(source);
+                envelope.apply(buffer);
+            }
+            const double envelopeSeconds = juce::Time::highResolutionTicksToSeconds(juce::Time::getHighResolutionTicks() - start);
+
+            start = juce::Time::getHighResolutionTicks();
+            for (int stem = 0; stem < numStems; ++stem)
+            {
+                Compressor compressor;
+                TestSignals::configure(compressor, GoldenRenders::compressorSettings);
+                juce::AudioBuffer<float> buffer(source);
+                TestSignals::render(compressor, buffer);
+            }
+            const double compressorSeconds = juce::Time::highResolutionTicksToSeconds(juce::Time::getHighResolutionTicks() - start);
+
+            logMessage("GainEnvelope: " + juce::String(numStems) + " stems " + juce::String(compressorSeconds / envelopeSeconds, 1)
+                       + "x faster than a Compressor per stem");
+        }
+    }
+
+private:
+    static constexpr double minimumRealtimeFactor = 200.0;
+
+    // Budget for the DSP objects of one instance in a large session, the processor and its parameters excluded
+    static constexpr double maximumMicrosecondsPerInstance = 100.0;
+
+    // Anything with process, run like that many compressors; returns the best run's seconds
+    template <typename Processor>
+    double measure(Processor& compressor, const juce::String& name, int numCompressors = 1)
+    {
+        constexpr int numBlocks = 1000;
+        constexpr int numRuns = 5;
+
+        const auto source = TestSignals::makeBursts(TestSignals::blockSize * 8);
+        juce::AudioBuffer<float> block(2, TestSignals::blockSize);
+
+        // Best of several runs to keep scheduler noise out of the number
+        double bestSeconds = std::numeric_limits<double>::max();
+        for (int run = 0; run < numRuns; ++run)
+        {
+            const auto start = juce::Time::getHighResolutionTicks();
+            for (int i = 0; i < numBlocks; ++i)
+            {
+                for (int ch = 0; ch < 2; ++ch)
+                    block.copyFrom(ch, 0, source, ch, (i % 8) * TestSignals::blockSize, TestSignals::blockSize);
+                compressor.process(block);
+            }
+            bestSeconds = juce::jmin(bestSeconds, juce::Time::highResolutionTicksToSeconds(juce::Time::getHighResolutionTicks() - start));
+        }
+
+        const double numSamples = static_cast<double>(numBlocks) * TestSignals::blockSize;
+        const double realtimeFactor = numSamples / TestSignals::sampleRate / bestSeconds;
+        logMessage(name + ": " + juce::String(bestSeconds * 1.0e9 / numSamples, 2) + " ns/sample, "
+                   + juce::String(realtimeFactor, 0) + "x real time");
+
+       #if ! JUCE_DEBUG
+        expectGreaterThan(realtimeFactor, minimumRealtimeFactor / numCompressors);
+       #endif
+
+        return bestSeconds;
+    }
+};
+
+static CompressorPerformanceTests compressorPerformanceTests;
@@ -0,0 +1,235 @@
+/*
+  ==============================================================================
+
+    DetectorBusTests.cpp
+    Created: 24 Oct 2026 3:22:48pm
+    Author:  Linus
+
+  ==============================================================================
+*/
+
+#include <JuceHeader.h>
+#include <vector>
+#include "../../Source/Compressor.h"
+#include "../../Source/DetectorBus.h"
+#include "TestSignals.h"
+
+class DetectorBusTests : public juce::UnitTest
+{
+public:
+    DetectorBusTests() : juce::UnitTest("DetectorBus", "DSP") {}
+
+    void runTest() override
+    {
+        beginTest("Members take the free slots, the lowest one leads");
+        {
+            DetectorBus bus;
+            const int first = bus.join(3);
+            const int second = bus.join(3);
+            expectEquals(first, 0);
+            expectEquals(second, 1);
+            expectEquals(bus.getNumMembers(3), 2);
+            expectEquals(bus.getNumMembers(4), 0);
+            expect(bus.isLeader(3, first));
+            expect(! bus.isLeader(3, second));
+
+            bus.leave(3, first);
+            expect(bus.isLeader(3, second));
+            expectEquals(bus.join(3), first);
+
+            expectEquals(bus.join(0), -1);
+            expectEquals(bus.join(DetectorBus::numGroups + 1), -1);
+        }
+
+        beginTest("A full group turns further members away");
+        {
+            DetectorBus bus;
+            for (int i = 0; i < DetectorBus::maxMembers; ++i)
+                expectEquals(bus.join(1), i);
+            expectEquals(bus.join(1), -1);
+        }
+
+        beginTest("Envelopes combine point by point until the leader's next block and go stale");
+        {
+            DetectorBus bus;
+            const int leader = bus.join(2);
+            const int follower = bus.join(2);
+
+            // A peak in the first and in the last sixteenth of two blocks
+            std::vector<float> early(TestSignals::blockSize, 0.0f), late(TestSignals::blockSize, 0.0f);
+            early[3] = 0.5f;
+            late[TestSignals::blockSize - 1] = 0.25f;
+            bus.publishEnvelope(2, follower, early.data(), TestSignals::blockSize);
+            bus.publishEnvelope(2, follower, late.data(), TestSignals::blockSize);
+
+            DetectorBus::Envelope envelope;
+            expectEquals(bus.getEnvelopeOfOthers(2, leader, envelope), 0.5f);
+            expectEquals(envelope.front(), 0.5f);
+            expectEquals(envelope.back(), 0.25f);
+            expectEquals(envelope[DetectorBus::numEnvelopePoints / 2], 0.0f);
+            expectEquals(bus.getEnvelopeOfOthers(2, follower, envelope), 0.0f);
+
+            // After the leader's block a new envelope replaces the old one
+            bus.publishAttenuation(2, -3.0f);
+            bus.publishEnvelope(2, follower, late.data(), TestSignals::blockSize);
+            expectEquals(bus.getEnvelopeOfOthers(2, leader, envelope), 0.25f);
+            expectEquals(envelope.front(), 0.0f);
+            expectEquals(bus.getAttenuation(2), -3.0f);
+
+            for (juce::uint32 i = 0; i <= DetectorBus::maxStaleBlocks; ++i)
+                bus.publishAttenuation(2, -3.0f);
+            expectEquals(bus.getEnvelopeOfOthers(2, leader, envelope), 0.0f);
+        }
+
+        beginTest("Every sample of a block falls in exactly one envelope point, short blocks too");
+        {
+            for (const int numSamples : { 1, 7, 16, 100, TestSignals::blockSize })
+            {
+                expectEquals(DetectorBus::getPointStart(0, numSamples), 0);
+                expectEquals(DetectorBus::getPointStart(DetectorBus::numEnvelopePoints, numSamples), numSamples);
+                for (int point = 0; point < DetectorBus::numEnvelopePoints; ++point)
+                    expectLessOrEqual(DetectorBus::getPointStart(point, numSamples), DetectorBus::getPointStart(point + 1, numSamples));
+            }
+        }
+
+        beginTest("Followers apply the leader's compression");
+        {
+            // A loud leader and a follower below the threshold
+            Compressor leader, follower;
+            prepareLinked(leader, 5);
+            prepareLinked(follower, 5);
+
+            juce::AudioBuffer<float> loud(2, TestSignals::blockSize), quiet(2, TestSignals::blockSize);
+            for (int block = 0; block < 40; ++block)
+            {
+                TestSignals::fill(loud, 0.8f);
+                TestSignals::fill(quiet, 0.05f);
+                leader.process(loud);
+                follower.process(quiet);
+
+                // The follower ends each block on the leader's gain
+                const int last = TestSignals::blockSize - 1;
+                expectWithinAbsoluteError(quiet.getSample(0, last) / 0.05f, loud.getSample(0, last) / 0.8f, 1.0e-4f);
+            }
+
+            expectEquals(leader.getLinkGroup(), 5);
+            expect(leader.isLinkLeader());
+            expect(! follower.isLinkLeader());
+            expectLessThan(follower.getMaxGainReduction(), -3.0f);
+        }
+
+        beginTest("The leader compresses on the followers' peaks");
+        {
+            Compressor leader, follower, alone;
+            prepareLinked(leader, 6);
+            prepareLinked(follower, 6);
+            prepareLinked(alone, 0);
+
+            juce::AudioBuffer<float> quiet(2, TestSignals::blockSize), loud(2, TestSignals::blockSize), reference(2, TestSignals::blockSize);
+            for (int block = 0; block < 40; ++block)
+            {
+                TestSignals::fill(quiet, 0.05f);
+                TestSignals::fill(loud, 0.8f);
+                TestSignals::fill(reference, 0.05f);
+                leader.process(quiet);
+                follower.process(loud);
+                alone.process(reference);
+            }
+
+            // Unlinked the quiet signal would pass untouched
+            expectEquals(alone.getMaxGainReduction(), 0.0f);
+            expectLessThan(leader.getMaxGainReduction(), -3.0f);
+        }
+
+        beginTest("The leader tracks a side-chain summed over the group to within an envelope point");
+        {
+            // A quiet leader and a follower with one short burst per block, the follower
+            // processed first as a host does for tracks ahead of the group leader. The
+            // reference detects on all four channels of both at once. The leader takes
+            // its slot in the first block, after which the detectors settle.
+            Compressor leader, follower, reference;
+            prepareLinked(leader, 8);
+            prepareLinked(follower, 8);
+            TestSignals::configure(reference, { 0.0f, -20.0f, 4.0f, 0.0f, 1.0f, 50.0f, 0.0f, 1.0f }, TestSignals::makeSpec(4));
+
+            constexpr int pointLength = TestSignals::blockSize / DetectorBus::numEnvelopePoints;
+            const int burstStart = 5 * pointLength + pointLength / 2, burstLength = 3 * pointLength;
+
+            juce::AudioBuffer<float> quiet(2, TestSignals::blockSize), bursts(2, TestSignals::blockSize), summed(4, TestSignals::blockSize);
+            float worstError = 0.0f;
+            for (int block = 0; block < 30; ++block)
+            {
+                TestSignals::fill(quiet, 0.05f);
+                TestSignals::fill(bursts, 0.01f);
+                for (int ch = 0; ch < 2; ++ch)
+                    for (int i = burstStart; i < burstStart + burstLength; ++i)
+                        bursts.setSample(ch, i, 0.8f);
+                for (int ch = 0; ch < 2; ++ch)
+                {
+                    summed.copyFrom(ch, 0, quiet, ch, 0, TestSignals::blockSize);
+                    summed.copyFrom(ch + 2, 0, bursts, ch, 0, TestSignals::blockSize);
+                }
+
+                if (block == 0)
+                    leader.process(quiet);
+                follower.process(bursts);
+                if (block > 0)
+                    leader.process(quiet);
+                reference.process(summed);
+
+                if (block < 10)
+                    continue;
+
+                for (int i = 0; i < TestSignals::blockSize; ++i)
+                {
+                    const float gain = juce::Decibels::gainToDecibels(quiet.getSample(0, i) / 0.05f);
+                    const float expected = juce::Decibels::gainToDecibels(summed.getSample(0, i) / 0.05f);
+
+                    // Never less compression than the summed side-chain; more where the
+                    // burst's first point holds its peak ahead of it, and a little more
+                    // where its last one holds it after it
+                    expectLessOrEqual(gain, expected + 1.0e-4f);
+                    if (i < burstStart - pointLength / 2 || i >= burstStart + pointLength)
+                        worstError = juce::jmax(worstError, expected - gain);
+                }
+            }
+
+            logMessage("Worst gain error outside the burst's first envelope point: " + juce::String(worstError, 3) + " dB");
+            expectLessThan(worstError, 1.0f);
+        }
+
+        beginTest("Unlinking returns to an independent detector");
+        {
+            Compressor leader, follower;
+            prepareLinked(leader, 7);
+            prepareLinked(follower, 7);
+
+            juce::AudioBuffer<float> loud(2, TestSignals::blockSize), quiet(2, TestSignals::blockSize);
+            TestSignals::fill(loud, 0.8f);
+            TestSignals::fill(quiet, 0.05f);
+            leader.process(loud);
+            follower.process(quiet);
+
+            follower.setLinkGroup(0);
+            for (int block = 0; block < 200; ++block)
+            {
+                TestSignals::fill(loud, 0.8f);
+                TestSignals::fill(quiet, 0.05f);
+                leader.process(loud);
+                follower.process(quiet);
+            }
+
+            expectEquals(follower.getLinkGroup(), 0);
+            expectWithinAbsoluteError(follower.getMaxGainReduction(), 0.0f, 1.0e-3f);
+        }
+    }
+
+private:
+    static void prepareLinked(Compressor& compressor, int group)
+    {
+        TestSignals::configure(compressor, { 0.0f, -20.0f, 4.0f, 0.0f, 1.0f, 50.0f, 0.0f, 1.0f });
+        compressor.setLinkGroup(group);
+    }
+};
+
+static DetectorBusTests detectorBusTests;
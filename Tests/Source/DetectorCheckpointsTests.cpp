@@ -0,0 +1,166 @@
+/*
+  ==============================================================================
+
+    DetectorCheckpointsTests.cpp
+    Created: 28 Oct 2026 3:26:58pm
+    Author:  Linus
+
+  ==============================================================================
+*/
+
+#include <JuceHeader.h>
+#include <cmath>
+#include "../../Source/Compressor.h"
+#include "../../Source/DetectorCheckpoints.h"
+#include "GoldenRenders.h"
+#include "TestSignals.h"
+
+namespace
+{
+    // A short release, so processParallel's segments are ParallelSegments::defaultSegmentSize
+    void setUp(Compressor& compressor, bool midSide)
+    {
+        auto settings = GoldenRenders::compressorSettings;
+        settings.release = 10.0f;
+        TestSignals::configure(compressor, settings);
+        compressor.setMidSide(midSide);
+    }
+}
+
+class DetectorCheckpointsTests : public juce::UnitTest
+{
+public:
+    DetectorCheckpointsTests() : juce::UnitTest("DetectorCheckpoints", "DSP") {}
+
+    void runTest() override
+    {
+        beginTest("Checkpoints are due at every multiple of the interval, the nearest is the last stored");
+        {
+            DetectorCheckpoints checkpoints(1000);
+            checkpoints.prepare(4500);
+            expect(checkpoints.isDue(0) && checkpoints.isDue(4000));
+            expect(! checkpoints.isDue(999) && ! checkpoints.isDue(5000));
+            expectEquals(checkpoints.getSamplesToNext(2300), 700);
+            expectEquals(checkpoints.findNearest(4499), -1);
+
+            checkpoints.store(0, { 0.0, 0.0 }, { 0.0, 0.0 });
+            checkpoints.store(2000, { -3.0, -1.0 }, { -2.0, 0.0 });
+            expectEquals(checkpoints.findNearest(2999), 2000);
+            expectEquals(checkpoints.findNearest(1999), 0);
+            expectEquals(checkpoints.findNearest(9999), 2000);
+            expectEquals(checkpoints.get(2000).side.state01, -2.0);
+            expectEquals(checkpoints.getNumStored(), 2);
+
+            checkpoints.prepare(4500);
+            expectEquals(checkpoints.getNumStored(), 0);
+        }
+
+        // Three of processParallel's segments and a bit
+        const int numSamples = 3 * ParallelSegments::defaultSegmentSize + 1234;
+        const auto source = TestSignals::makeBursts(numSamples);
+
+        for (const bool midSide : { false, true })
+        {
+            Compressor compressor;
+            setUp(compressor, midSide);
+            expectLessOrEqual(8 * compressor.getParallelPreRoll(0.0f), ParallelSegments::defaultSegmentSize);
+            DetectorCheckpoints checkpoints(4800);
+            juce::AudioBuffer<float> rendered(source);
+            juce::ThreadPool pool(4);
+            compressor.processParallel(rendered, pool, &checkpoints);
+            expectEquals(checkpoints.getNumStored(), (numSamples - 1) / 4800 + 1);
+
+            const auto renderRegion = [&](int start, int num, const DetectorCheckpoints& from)
+            {
+                Compressor regionCompressor;
+                setUp(regionCompressor, midSide);
+                juce::AudioBuffer<float> buffer(source);
+                regionCompressor.processRegion(buffer, start, num, from);
+                return buffer;
+            };
+
+            beginTest(juce::String(midSide ? "Mid/side: " : "Linked: ") + "a region within a segment renders exactly as the whole file did");
+            {
+                const int start = ParallelSegments::defaultSegmentSize + 12345, num = 10000;
+                const auto region = renderRegion(start, num, checkpoints);
+
+                int numDifferent = 0;
+                for (int ch = 0; ch < 2; ++ch)
+                    for (int i = 0; i < numSamples; ++i)
+                    {
+                        const bool inRegion = i >= start && i < start + num;
+                        numDifferent += region.getSample(ch, i) != (inRegion ? rendered : source).getSample(ch, i) ? 1 : 0;
+                    }
+                expectEquals(numDifferent, 0);
+            }
+
+            beginTest(juce::String(midSide ? "Mid/side: " : "Linked: ") + "across a segment boundary a region stays within the parallel tolerance");
+            {
+                const int start = 2 * ParallelSegments::defaultSegmentSize - 5000, num = 10000;
+                const auto region = renderRegion(start, num, checkpoints);
+                const float relativeError = juce::Decibels::decibelsToGain(Compressor::parallelTolerance) - 1.0f;
+
+                for (int ch = 0; ch < 2; ++ch)
+                    for (int i = start; i < start + num; ++i)
+                        expectWithinAbsoluteError(region.getSample(ch, i), rendered.getSample(ch, i),
+                                                  2.0f * relativeError * std::abs(rendered.getSample(ch, i)) + 1.0e-7f);
+            }
+
+            beginTest(juce::String(midSide ? "Mid/side: " : "Linked: ") + "without checkpoints a region renders from the top");
+            {
+                const int start = 20000, num = 3000;
+                const auto region = renderRegion(start, num, DetectorCheckpoints());
+
+                int numDifferent = 0;
+                for (int ch = 0; ch < 2; ++ch)
+                    for (int i = start; i < start + num; ++i)
+                        numDifferent += region.getSample(ch, i) != rendered.getSample(ch, i) ? 1 : 0;
+                expectEquals(numDifferent, 0);
+            }
+        }
+    }
+};
+
+static DetectorCheckpointsTests detectorCheckpointsTests;
+
+//==============================================================================
+class DetectorCheckpointsPerformanceTests : public juce::UnitTest
+{
+public:
+    DetectorCheckpointsPerformanceTests() : juce::UnitTest("DetectorCheckpoints performance", "Performance") {}
+
+    void runTest() override
+    {
+        beginTest("Re-rendering a second at the end of ten minutes against the whole file");
+
+        constexpr int numSamples = 10 * 60 * 48000;
+        const auto source = TestSignals::makeBursts(numSamples);
+
+        Compressor compressor;
+        setUp(compressor, false);
+        DetectorCheckpoints checkpoints;
+        juce::AudioBuffer<float> buffer(source);
+        juce::ThreadPool pool;
+
+        auto start = juce::Time::getHighResolutionTicks();
+        compressor.processParallel(buffer, pool, &checkpoints);
+        const double renderSeconds = juce::Time::highResolutionTicksToSeconds(juce::Time::getHighResolutionTicks() - start);
+
+        // Half an interval past a checkpoint, an average seek
+        const int regionStart = numSamples - 2 * DetectorCheckpoints::defaultInterval + DetectorCheckpoints::defaultInterval / 2;
+        juce::AudioBuffer<float> region(source);
+        start = juce::Time::getHighResolutionTicks();
+        compressor.processRegion(region, regionStart, 48000, checkpoints);
+        const double regionSeconds = juce::Time::highResolutionTicksToSeconds(juce::Time::getHighResolutionTicks() - start);
+
+        logMessage("Region re-render: " + juce::String(regionSeconds * 1.0e3, 2) + " ms against " + juce::String(renderSeconds * 1.0e3, 1)
+                   + " ms for the whole file on " + juce::String(pool.getNumThreads()) + " threads, "
+                   + juce::String(checkpoints.getNumStored()) + " checkpoints");
+
+       #if ! JUCE_DEBUG
+        expectGreaterThan(renderSeconds / regionSeconds, 10.0);
+       #endif
+    }
+};
+
+static DetectorCheckpointsPerformanceTests detectorCheckpointsPerformanceTests;
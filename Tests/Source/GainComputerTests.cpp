@@ -0,0 +1,216 @@
+/*
+  ==============================================================================
+
+    GainComputerTests.cpp
+    Created: 19 Oct 2026 2:52:30pm
+    Author:  Linus
+
+  ==============================================================================
+*/
+
+#include <JuceHeader.h>
+#include <cmath>
+#include <limits>
+#include "../../Source/FastDecibels.h"
+#include "../../Source/GainComputer.h"
+#include "../../Source/TransferCurve.h"
+
+class GainComputerTests : public juce::UnitTest
+{
+public:
+    GainComputerTests() : juce::UnitTest("GainComputer", "DSP") {}
+
+    void runTest() override
+    {
+        beginTest("Static curve matches the analytic soft-knee curve");
+        for (float ratio : { 1.0f, 2.0f, 4.0f, 10.0f })
+            for (float knee : { 0.0f, 1.0f, 6.0f, 24.0f })
+                expectMatchesAnalyticCurve(-20.0f, ratio, knee);
+
+        beginTest("Ratios above 23.9 become a limiter");
+        {
+            GainComputer gainComputer;
+            gainComputer.setThreshold(-10.0f);
+            gainComputer.setRatio(24.0f);
+            gainComputer.setKnee(0.0f);
+            expectWithinAbsoluteError(gainComputer.applyCompression(0.0f), -10.0f, tolerance);
+            expectWithinAbsoluteError(gainComputer.applyCompression(20.0f), -10.0f, tolerance);
+            expectWithinAbsoluteError(gainComputer.applyCompression(-30.0f), -30.0f, tolerance);
+        }
+
+        beginTest("Buffer processing yields attenuation in dB");
+        {
+            GainComputer gainComputer;
+            gainComputer.setThreshold(-20.0f);
+            gainComputer.setRatio(4.0f);
+            gainComputer.setKnee(0.0f);
+
+            float levels[] = { 0.01f, 1.0f, -1.0f };
+            gainComputer.applyCompressionToBuffer(levels, 3);
+            expectWithinAbsoluteError(levels[0], 0.0f, tolerance);     // -40 dB, below threshold
+            expectWithinAbsoluteError(levels[1], -15.0f, tolerance);   // 0 dB, 20 dB over at 4:1
+            expectWithinAbsoluteError(levels[2], -15.0f, tolerance);
+        }
+
+        beginTest("Shared transfer curve matches the evaluated curve");
+        {
+            TransferCurveCache cache;
+            auto curve = cache.getCurve(-20.0f, 4.0f, 6.0f);
+            expect(curve == cache.getCurve(-20.0f, 4.0f, 6.0f), "Identical settings share one curve");
+            expect(curve != cache.getCurve(-20.0f, 4.0f, 12.0f), "Different settings get their own curve");
+
+            GainComputer gainComputer;
+            gainComputer.setThreshold(-20.0f);
+            gainComputer.setRatio(4.0f);
+            gainComputer.setKnee(6.0f);
+            expect(curve->matches(gainComputer.getThreshold(), gainComputer.getRatio(), gainComputer.getKnee()));
+
+            for (float level = -110.0f; level < 60.0f; level += 0.37f)
+                expectWithinAbsoluteError(curve->lookup(level), gainComputer.applyCompression(level), 0.01f);
+        }
+
+        beginTest("Gate drops levels below its threshold by the range");
+        {
+            GainComputer gainComputer;
+            configureHardKnee(gainComputer);
+            gainComputer.setGate(-50.0f, 80.0f);
+            expectWithinAbsoluteError(gainComputer.applyCompression(-49.0f), -49.0f, tolerance);
+            expectWithinAbsoluteError(gainComputer.applyCompression(-51.0f), -131.0f, tolerance);
+
+            gainComputer.setGate(-100.0f, 80.0f);
+            expectWithinAbsoluteError(gainComputer.applyCompression(-100.0f), -100.0f, tolerance);
+        }
+
+        beginTest("Expander and upward compressor act below their thresholds");
+        {
+            GainComputer gainComputer;
+            configureHardKnee(gainComputer);
+            gainComputer.setExpander(-50.0f, 2.0f);
+            gainComputer.setUpward(-30.0f, 2.0f, 12.0f);
+
+            // 10 dB under the expander gains 10 dB of expansion and the full 12 dB of boost
+            expectWithinAbsoluteError(gainComputer.applyCompression(-60.0f), -58.0f, tolerance);
+
+            // Between the two only the upward compressor, 10 dB under at 2:1
+            expectWithinAbsoluteError(gainComputer.applyCompression(-40.0f), -35.0f, tolerance);
+
+            // Above both thresholds the downward compressor alone
+            expectWithinAbsoluteError(gainComputer.applyCompression(0.0f), -15.0f, tolerance);
+        }
+
+        beginTest("Limiter caps the output of the compressor");
+        {
+            GainComputer gainComputer;
+            configureHardKnee(gainComputer);
+            gainComputer.setLimiter(-12.0f);
+            expectWithinAbsoluteError(gainComputer.applyCompression(-16.0f), -19.0f, tolerance);
+            expectWithinAbsoluteError(gainComputer.applyCompression(40.0f), -12.0f, tolerance);
+            expectWithinAbsoluteError(gainComputer.applyCompression(20.0f), -12.0f, tolerance);
+        }
+
+        beginTest("Sections are applied on top of a shared transfer curve");
+        {
+            TransferCurveCache cache;
+            GainComputer gainComputer;
+            gainComputer.setThreshold(-20.0f);
+            gainComputer.setRatio(4.0f);
+            gainComputer.setKnee(6.0f);
+            gainComputer.setGate(-70.0f, 80.0f);
+            gainComputer.setExpander(-50.0f, 3.0f);
+            gainComputer.setUpward(-35.0f, 1.5f, 6.0f);
+            gainComputer.setLimiter(-18.0f);
+            gainComputer.setTransferCurve(cache.getCurve(-20.0f, 4.0f, 6.0f));
+
+            std::vector<float> levels;
+            for (float level = -90.0f; level < 10.0f; level += 0.5f)
+                levels.push_back(juce::Decibels::decibelsToGain(level));
+
+            const auto inputs = levels;
+            gainComputer.applyCompressionToBuffer(levels.data(), static_cast<int>(levels.size()));
+
+            for (size_t i = 0; i < levels.size(); ++i)
+            {
+                const float input = juce::Decibels::gainToDecibels(inputs[i]);
+                expectWithinAbsoluteError(levels[i], gainComputer.applyCompression(input) - input, 0.01f);
+            }
+        }
+
+        beginTest("FastDecibels stays within 0.01 dB of juce::Decibels");
+        {
+            for (float level = -130.0f; level < 60.0f; level += 0.013f)
+            {
+                const float gain = juce::Decibels::decibelsToGain(level, -200.0f);
+                expectWithinAbsoluteError(FastDecibels::gainToDecibels(gain), juce::Decibels::gainToDecibels(gain), 0.01f);
+
+                const float fastGain = FastDecibels::decibelsToGain(level);
+                if (level <= -100.0f)
+                    expectEquals(fastGain, 0.0f);
+                else
+                    expectWithinAbsoluteError(juce::Decibels::gainToDecibels(fastGain, -200.0f), level, 0.01f);
+            }
+
+            expectEquals(FastDecibels::gainToDecibels(0.0f), -100.0f);
+        }
+
+        beginTest("Approximate attenuation stays within 0.01 dB");
+        {
+            GainComputer gainComputer;
+            gainComputer.setThreshold(-20.0f);
+            gainComputer.setRatio(4.0f);
+            gainComputer.setKnee(6.0f);
+
+            std::vector<float> exact, approximate;
+            for (float level = -90.0f; level < 10.0f; level += 0.1f)
+                exact.push_back(juce::Decibels::decibelsToGain(level));
+            approximate = exact;
+
+            gainComputer.applyCompressionToBuffer(exact.data(), static_cast<int>(exact.size()));
+            gainComputer.applyCompressionToBuffer(approximate.data(), static_cast<int>(approximate.size()), true);
+            for (size_t i = 0; i < exact.size(); ++i)
+                expectWithinAbsoluteError(approximate[i], exact[i], 0.01f);
+        }
+    }
+
+private:
+    static constexpr float tolerance = 1.0e-4f;
+
+    // 4:1 from -20 dB, so every further section can be checked by hand
+    static void configureHardKnee(GainComputer& gainComputer)
+    {
+        gainComputer.setThreshold(-20.0f);
+        gainComputer.setRatio(4.0f);
+        gainComputer.setKnee(0.0f);
+    }
+
+    // Giannoulis, Massberg & Reiss, "Digital Dynamic Range Compressor Design", eq. 4
+    static double analyticCurve(double input, double threshold, double ratio, double knee)
+    {
+        const double overshoot = input - threshold;
+
+        if (2.0 * overshoot < -knee)
+            return input;
+
+        if (knee > 0.0 && 2.0 * std::abs(overshoot) <= knee)
+            return input + (1.0 / ratio - 1.0) * juce::square(overshoot + knee / 2.0) / (2.0 * knee);
+
+        return threshold + overshoot / ratio;
+    }
+
+    void expectMatchesAnalyticCurve(float threshold, float ratio, float knee)
+    {
+        GainComputer gainComputer;
+        gainComputer.setThreshold(threshold);
+        gainComputer.setRatio(ratio);
+        gainComputer.setKnee(knee);
+
+        for (float input = -100.0f; input <= 20.0f; input += 0.25f)
+        {
+            const auto expected = static_cast<float>(analyticCurve(input, threshold, ratio, knee));
+            expectWithinAbsoluteError(gainComputer.applyCompression(input), expected, tolerance,
+                                      "ratio " + juce::String(ratio, 1) + ", knee " + juce::String(knee, 1)
+                                      + ", input " + juce::String(input, 2));
+        }
+    }
+};
+
+static GainComputerTests gainComputerTests;
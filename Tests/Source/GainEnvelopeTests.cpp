@@ -0,0 +1,175 @@
+/*
+  ==============================================================================
+
+    GainEnvelopeTests.cpp
+    Created: 24 Oct 2026 10:41:09am
+    Author:  Linus
+
+  ==============================================================================
+*/
+
+#include <JuceHeader.h>
+#include <cmath>
+#include "../../Source/Compressor.h"
+#include "../../Source/GainEnvelope.h"
+#include "GoldenRenders.h"
+#include "TestSignals.h"
+
+class GainEnvelopeTests : public juce::UnitTest
+{
+public:
+    GainEnvelopeTests() : juce::UnitTest("GainEnvelope", "DSP") {}
+
+    void runTest() override
+    {
+        beginTest("Applying a recorded envelope reproduces process");
+        for (const bool midSide : { false, true })
+        {
+            GainEnvelope envelope(TestSignals::sampleRate, midSide, TestSignals::renderLength);
+            const auto source = TestSignals::makeBursts(TestSignals::renderLength);
+            auto processed = analyse(source, envelope, midSide);
+            expectEquals(envelope.getNumSamples(), TestSignals::renderLength);
+
+            juce::AudioBuffer<float> applied(source);
+            envelope.apply(applied);
+
+            for (int ch = 0; ch < 2; ++ch)
+                for (int i = 0; i < applied.getNumSamples(); ++i)
+                    expectEquals(applied.getSample(ch, i), processed.getSample(ch, i));
+        }
+
+        beginTest("Stems with the envelope of their mix add up to the compressed mix");
+        for (const bool midSide : { false, true })
+        {
+            // Drums and a pad, the mix is their sum
+            const auto drums = TestSignals::makeBursts(TestSignals::renderLength);
+            juce::AudioBuffer<float> pad(2, TestSignals::renderLength);
+            for (int i = 0; i < pad.getNumSamples(); ++i)
+            {
+                pad.setSample(0, i, 0.2f * static_cast<float>(std::sin(0.011 * i)));
+                pad.setSample(1, i, 0.2f * static_cast<float>(std::cos(0.013 * i)));
+            }
+
+            juce::AudioBuffer<float> mix(drums);
+            for (int ch = 0; ch < 2; ++ch)
+                mix.addFrom(ch, 0, pad, ch, 0, pad.getNumSamples());
+
+            GainEnvelope envelope(TestSignals::sampleRate, midSide, TestSignals::renderLength);
+            const auto processed = analyse(mix, envelope, midSide);
+
+            juce::AudioBuffer<float> stems[] = { drums, pad };
+            for (auto& stem : stems)
+                envelope.apply(stem);
+
+            for (int ch = 0; ch < 2; ++ch)
+                for (int i = 0; i < mix.getNumSamples(); ++i)
+                    expectWithinAbsoluteError(stems[0].getSample(ch, i) + stems[1].getSample(ch, i), processed.getSample(ch, i), 1.0e-6f);
+        }
+
+        beginTest("Applying from an offset continues the envelope");
+        {
+            GainEnvelope envelope(TestSignals::sampleRate, false, TestSignals::renderLength);
+            const auto source = TestSignals::makeBursts(TestSignals::renderLength);
+            const auto processed = analyse(source, envelope, false);
+
+            // Block by block, as a plugin playing a stem would
+            juce::AudioBuffer<float> applied(source);
+            for (int start = 0; start < applied.getNumSamples(); start += TestSignals::blockSize)
+            {
+                juce::AudioBuffer<float> block(applied.getArrayOfWritePointers(), 2, start, TestSignals::blockSize);
+                envelope.apply(block, start);
+            }
+
+            for (int i = 0; i < applied.getNumSamples(); ++i)
+                expectEquals(applied.getSample(0, i), processed.getSample(0, i));
+        }
+
+        beginTest("Recording stops at the capacity, samples past the end pass unchanged");
+        {
+            GainEnvelope envelope(TestSignals::sampleRate, false, TestSignals::blockSize + 100);
+            const auto source = TestSignals::makeBursts(TestSignals::renderLength);
+            analyse(source, envelope, false);
+            expectEquals(envelope.getNumSamples(), TestSignals::blockSize + 100);
+
+            juce::AudioBuffer<float> applied(source);
+            envelope.apply(applied);
+            for (int i = envelope.getNumSamples(); i < applied.getNumSamples(); ++i)
+                expectEquals(applied.getSample(0, i), source.getSample(0, i));
+        }
+
+        beginTest("A stored envelope reads back within 0.002 dB");
+        for (const bool midSide : { false, true })
+        {
+            GainEnvelope envelope(TestSignals::sampleRate, midSide, TestSignals::renderLength);
+            analyse(TestSignals::makeBursts(TestSignals::renderLength), envelope, midSide);
+
+            juce::MemoryBlock data;
+            {
+                juce::MemoryOutputStream stream(data, false);
+                envelope.writeTo(stream);
+            }
+
+            // Two bytes a sample and curve
+            expect(data.getSize() < static_cast<size_t>(TestSignals::renderLength * (midSide ? 2 : 1) * 2 + 64));
+
+            juce::MemoryInputStream stream(data, false);
+            const auto stored = GainEnvelope::readFrom(stream);
+            expect(stored != nullptr);
+            if (stored == nullptr)
+                continue;
+
+            expectEquals(stored->getSampleRate(), TestSignals::sampleRate);
+            expect(stored->isMidSide() == midSide);
+            expectEquals(stored->getNumSamples(), envelope.getNumSamples());
+
+            const float tolerance = 0.5f / GainEnvelope::stepsPerDecibel + 1.0e-4f;
+            for (int curve = 0; curve < (midSide ? 2 : 1); ++curve)
+                for (int i = 0; i < envelope.getNumSamples(); ++i)
+                    expectWithinAbsoluteError(juce::Decibels::gainToDecibels(stored->getGains(curve)[i]),
+                                              juce::Decibels::gainToDecibels(envelope.getGains(curve)[i]), tolerance);
+        }
+
+        beginTest("Anything but a complete envelope is rejected");
+        {
+            GainEnvelope envelope(TestSignals::sampleRate, false, 100);
+            const float gains[100] = {};
+            envelope.append(gains, nullptr, 100);
+
+            juce::MemoryBlock data;
+            {
+                juce::MemoryOutputStream stream(data, false);
+                envelope.writeTo(stream);
+            }
+
+            juce::MemoryInputStream truncated(data.getData(), data.getSize() - 1, false);
+            expect(GainEnvelope::readFrom(truncated) == nullptr);
+
+            const char garbage[] = "not a gain envelope at all";
+            juce::MemoryInputStream wrong(garbage, sizeof(garbage), false);
+            expect(GainEnvelope::readFrom(wrong) == nullptr);
+
+            // Silence survives the trip as silence
+            juce::MemoryInputStream complete(data, false);
+            const auto stored = GainEnvelope::readFrom(complete);
+            expect(stored != nullptr && stored->getGains(0)[50] == 0.0f);
+        }
+    }
+
+private:
+    // Compresses the buffer in blocks while recording its gain, returns the compressed copy
+    static juce::AudioBuffer<float> analyse(const juce::AudioBuffer<float>& source, GainEnvelope& envelope, bool midSide)
+    {
+        auto settings = GoldenRenders::compressorSettings;
+        settings.mix = 0.8f;
+        Compressor compressor;
+        TestSignals::configure(compressor, settings);
+        compressor.setMidSide(midSide);
+        compressor.setGainEnvelope(&envelope);
+
+        juce::AudioBuffer<float> buffer(source);
+        TestSignals::render(compressor, buffer);
+        return buffer;
+    }
+};
+
+static GainEnvelopeTests gainEnvelopeTests;
@@ -0,0 +1,90 @@
+/*
+  ==============================================================================
+
+    GoldenRenders.h
+    Created: 19 Oct 2026 3:38:22pm
+    Author:  Linus
+
+    Reference output of Compressor::process for TestSignals::makeBursts,
+    stored every `stride` samples. Regenerate only for intentional changes to
+    the sound of the compressor, never to make an optimisation pass.
+
+  ==============================================================================
+*/
+
+#pragma once
+
+namespace GoldenRenders
+{
+    struct Settings
+    {
+        float input, threshold, ratio, knee, attack, release, makeup, mix;
+    };
+
+    constexpr int stride = 64;
+    constexpr int numPoints = 64;
+
+    // Soft knee compression with makeup
+    constexpr Settings compressorSettings{ 0.0f, -20.0f, 4.0f, 6.0f, 5.0f, 50.0f, 3.0f, 1.0f };
+    constexpr float compressor[2][numPoints] =
+    {
+        {
+            0.0f, -0.0365866311f, 0.0625897944f, -0.0704875141f, 0.0579952039f, -0.0287265405f,
+            -0.00885189511f, 0.0438697301f, -0.0661972985f, 0.0693758801f, -0.0524859987f, 0.0204134136f,
+            0.0175641906f, -0.0504609756f, 0.0687608421f, -0.0671701506f, 0.734586358f, -0.141797692f,
+            -0.256000668f, 0.47320348f, -0.507331073f, 0.413569689f, -0.231688052f, 0.0166028365f,
+            0.182539672f, -0.312395722f, 0.344460726f, -0.279087484f, 0.143587351f, 0.0265319292f,
+            -0.183107555f, 0.282307267f, -0.0185126718f, 0.0149317896f, -0.00659372285f, -0.00430903398f,
+            0.0146526406f, -0.0212742854f, 0.0219350588f, -0.016061157f, 0.00502164755f, 0.00817051996f,
+            -0.0196765903f, 0.0259484332f, -0.0248188414f, 0.016231386f, -0.00236853189f, -0.0128920497f,
+            0.399894863f, -0.428213984f, 0.343634635f, -0.180650994f, -0.0151177244f, 0.19350557f,
+            -0.304693401f, 0.323341578f, -0.251005232f, 0.11419981f, 0.0510748364f, -0.19733654f,
+            0.283256769f, -0.284191221f, 0.206446111f, -0.0713040233f
+        },
+        {
+            0.0f, -0.0241737142f, -0.0352437571f, -0.0272094738f, -0.00442594755f, 0.0207567178f,
+            0.03468794f, 0.0298161246f, 0.00878209528f, -0.0170123801f, -0.0335850753f, -0.0319525562f,
+            -0.0129997442f, 0.0129997442f, 0.0319525562f, 0.0335850753f, 0.270797759f, -0.105726205f,
+            -0.293580711f, -0.29177919f, -0.149922147f, 0.0286430568f, 0.161295131f, 0.197848558f,
+            0.129689723f, -3.53496432e-15f, -0.117925659f, -0.164945841f, -0.124412067f, -0.0198698509f,
+            0.0915537775f, 0.15040563f, 0.00790013373f, 0.00240968284f, -0.00482954131f, -0.00985546969f,
+            -0.00968385115f, -0.00406555785f, 0.00419183308f, 0.0106147323f, 0.0114853345f, 0.00598445954f,
+            -0.00317539577f, -0.0110732848f, -0.0132228034f, -0.008115693f, 0.00177380128f, 0.0111703882f,
+            0.236345232f, 0.146598473f, -7.7769068e-15f, -0.128347874f, -0.180151135f, -0.134713486f,
+            -0.0211024918f, 0.0955511481f, 0.154770836f, 0.130963951f, 0.0380820632f, -0.0727461055f,
+            -0.141628385f, -0.132061154f, -0.053184595f, 0.0527740791f
+        },
+    };
+
+    // Hard knee limiter with input gain and parallel mix
+    constexpr Settings limiterSettings{ 6.0f, -30.0f, 24.0f, 0.0f, 1.0f, 200.0f, 0.0f, 0.5f };
+    constexpr float limiter[2][numPoints] =
+    {
+        {
+            0.0f, -0.0267848149f, 0.0475280061f, -0.0550940596f, 0.0472140312f, -0.0246335436f,
+            -0.00797801744f, 0.0414675958f, -0.0652602911f, 0.0668911859f, -0.0501567796f, 0.0194157995f,
+            0.0166502316f, -0.0477116369f, 0.0648722127f, -0.0631685928f, 0.685496926f, -0.140725508f,
+            -0.304462969f, 0.654144466f, -0.813564479f, 0.738768697f, -0.451513797f, 0.0341515839f,
+            0.392775983f, -0.705892742f, 0.814676821f, -0.687871039f, 0.3622199f, 0.0681648105f,
+            -0.478790134f, 0.750901818f, -0.0503569841f, 0.0392382629f, -0.0167547371f, -0.0105972411f,
+            0.0349072814f, -0.0491364487f, 0.0491588488f, -0.0349544361f, 0.0106215477f, 0.0168089997f,
+            -0.0394013114f, 0.0506125689f, -0.0471864156f, 0.0301015321f, -0.00428750087f, -0.0227942504f,
+            0.692839503f, -0.817504406f, 0.706985414f, -0.393029034f, -0.0341493897f, 0.451161623f,
+            -0.737493098f, 0.810346425f, -0.648920655f, 0.299887776f, 0.135850713f, -0.532250524f,
+            0.774675429f, -0.792910576f, 0.58188349f, -0.202534929f
+        },
+        {
+            0.0f, -0.0176974051f, -0.0267625973f, -0.0212673191f, -0.00360317412f, 0.0177992731f,
+            0.0312634781f, 0.0281835105f, 0.008657787f, -0.0164030809f, -0.0320946351f, -0.0303910151f,
+            -0.0123232966f, 0.0122914603f, 0.0301455446f, 0.0315842964f, 0.252701461f, -0.104926772f,
+            -0.349157095f, -0.403348178f, -0.240417615f, 0.0511657298f, 0.314332038f, 0.4069691f,
+            0.279057205f, -7.98764351e-15f, -0.278903514f, -0.406544447f, -0.313847452f, -0.0510488525f,
+            0.239395067f, 0.400060058f, 0.0214894377f, 0.00633224566f, -0.0122719286f, -0.0242376328f,
+            -0.0230700336f, -0.00939007197f, 0.00939435326f, 0.0231011976f, 0.0242932271f, 0.0123116737f,
+            -0.00635855878f, -0.0215985067f, -0.0251396392f, -0.0150507661f, 0.00321092363f, 0.0197502058f,
+            0.40948087f, 0.279871523f, -1.60000136e-14f, -0.279236972f, -0.406942964f, -0.314086884f,
+            -0.0510773808f, 0.239466637f, 0.400127143f, 0.343910307f, 0.101292059f, -0.19620873f,
+            -0.387337714f, -0.368458539f, -0.149904683f, 0.149901703f
+        },
+    };
+}
@@ -0,0 +1,89 @@
+/*
+  ==============================================================================
+
+    LevelDetectorTests.cpp
+    Created: 19 Oct 2026 3:10:14pm
+    Author:  Linus
+
+  ==============================================================================
+*/
+
+#include <JuceHeader.h>
+#include <cmath>
+#include <vector>
+#include "../../Source/LevelDetector.h"
+
+class LevelDetectorTests : public juce::UnitTest
+{
+public:
+    LevelDetectorTests() : juce::UnitTest("LevelDetector", "DSP") {}
+
+    void runTest() override
+    {
+        constexpr double sampleRate = 48000.0;
+
+        beginTest("Coefficients follow exp(-1 / (t * fs))");
+        {
+            LevelDetector detector;
+            detector.setAttack(0.005);
+            detector.setRelease(0.2);
+            detector.prepare(sampleRate);
+            expectWithinAbsoluteError(detector.getAttackCoefficient(), std::exp(-1.0 / (0.005 * sampleRate)), 1.0e-12);
+            expectWithinAbsoluteError(detector.getReleaseCoefficient(), std::exp(-1.0 / (0.2 * sampleRate)), 1.0e-12);
+
+            detector.setAttack(0.02);
+            expectWithinAbsoluteError(detector.getAttackCoefficient(), std::exp(-1.0 / (0.02 * sampleRate)), 1.0e-12);
+        }
+
+        beginTest("Step responses follow the one-pole coefficients");
+        {
+            constexpr int numSamples = 4800;
+            constexpr float step = -12.0f;
+
+            LevelDetector detector;
+            detector.setAttack(0.005);
+            detector.setRelease(0.05);
+            detector.prepare(sampleRate);
+            const double a = detector.getAttackCoefficient();
+            const double r = detector.getReleaseCoefficient();
+
+            // Falling attenuation is the attack phase
+            std::vector<float> buffer(numSamples, step);
+            detector.applyBallistics(buffer.data(), numSamples);
+            for (int n = 0; n < numSamples; n += 97)
+                expectWithinAbsoluteError(buffer[n], static_cast<float>(step * (1.0 - std::pow(a, n + 1))), 1.0e-4f);
+
+            // Rising back to zero is the release phase
+            const double settled = buffer.back();
+            std::fill(buffer.begin(), buffer.end(), 0.0f);
+            detector.applyBallistics(buffer.data(), numSamples);
+            for (int n = 0; n < numSamples; n += 97)
+                expectWithinAbsoluteError(buffer[n], static_cast<float>(settled * std::pow(r, n + 1)), 1.0e-4f);
+        }
+
+        beginTest("A detector set to another's state continues exactly like it");
+        {
+            LevelDetector original, restored;
+            for (auto* detector : { &original, &restored })
+            {
+                detector->setAttack(0.002);
+                detector->setRelease(0.08);
+                detector->prepare(sampleRate);
+            }
+
+            std::vector<float> first(1000), second(1000);
+            for (size_t n = 0; n < first.size(); ++n)
+                first[n] = second[n] = -20.0f * static_cast<float>((n / 100) % 2);
+
+            original.applyBallistics(first.data(), 500);
+            restored.setState(original.getState());
+            original.applyBallistics(first.data() + 500, 500);
+            restored.applyBallistics(second.data() + 500, 500);
+
+            for (size_t n = 500; n < first.size(); ++n)
+                expectEquals(second[n], first[n]);
+        }
+    }
+};
+
+static LevelDetectorTests levelDetectorTests;
@@ -0,0 +1,85 @@
+/*
+  ==============================================================================
+
+    LevelEnvelopeFollowerTests.cpp
+    Created: 29 Oct 2026 10:12:44am
+    Author:  Linus
+
+  ==============================================================================
+*/
+
+#include <JuceHeader.h>
+#include <cmath>
+#include "../../Source/LevelEnvelopeFollower.h"
+
+class LevelEnvelopeFollowerTests : public juce::UnitTest
+{
+public:
+    LevelEnvelopeFollowerTests() : juce::UnitTest("LevelEnvelopeFollower", "DSP") {}
+
+    void runTest() override
+    {
+        beginTest("A peak falls by 1/e over the decay time at any sample rate and block size");
+        {
+            for (const double sampleRate : { 44100.0, 48000.0, 96000.0 })
+            for (const int blockSize : { 1, 64, 480, 512 })
+            {
+                LevelEnvelopeFollower follower;
+                follower.prepare(sampleRate);
+                follower.setPeakDecay(0.3f);
+                follower.updatePeak(1.0f, 1);
+
+                const int decayInSamples = static_cast<int>(0.3 * sampleRate);
+                for (int done = 0; done < decayInSamples; done += blockSize)
+                    follower.updatePeak(0.0f, juce::jmin(blockSize, decayInSamples - done));
+
+                expectWithinAbsoluteError(follower.getPeak(), std::exp(-1.0f), 1.0e-3f);
+            }
+        }
+
+        beginTest("A louder block takes over at once, a quiet one under the decayed peak doesn't");
+        {
+            LevelEnvelopeFollower follower;
+            follower.prepare(48000.0);
+            follower.setPeakDecay(0.3f);
+
+            follower.updatePeak(0.5f, 512);
+            expectEquals(follower.getPeak(), 0.5f);
+            follower.updatePeak(0.25f, 512);
+            expectWithinAbsoluteError(follower.getPeak(), 0.5f * std::pow(1.0f - 1.0f / 14400.0f, 512.0f), 1.0e-6f);
+            follower.updatePeak(0.75f, 512);
+            expectEquals(follower.getPeak(), 0.75f);
+        }
+
+        beginTest("From channel data the block's peak is the max |x| over every channel");
+        {
+            juce::AudioBuffer<float> buffer(3, 256);
+            buffer.clear();
+            buffer.setSample(0, 10, 0.5f);
+            buffer.setSample(2, 200, -0.7f);
+
+            LevelEnvelopeFollower follower;
+            follower.prepare(48000.0);
+            follower.updatePeak(buffer.getArrayOfReadPointers(), 3, 256);
+            expectEquals(follower.getPeak(), 0.7f);
+        }
+
+        beginTest("Under the floor the peak drops to zero, without a decay time it doesn't hold");
+        {
+            LevelEnvelopeFollower follower;
+            follower.prepare(48000.0);
+            follower.setPeakDecay(0.3f);
+            follower.updatePeak(1.0f, 1);
+            for (int i = 0; i < 100; ++i)
+                follower.updatePeak(0.0f, 4800);
+            expectEquals(follower.getPeak(), 0.0f);
+
+            follower.setPeakDecay(0.0f);
+            follower.updatePeak(1.0f, 1);
+            follower.updatePeak(0.0f, 1);
+            expectEquals(follower.getPeak(), 0.0f);
+        }
+    }
+};
+
+static LevelEnvelopeFollowerTests levelEnvelopeFollowerTests;
@@ -0,0 +1,189 @@
+/*
+  ==============================================================================
+
+    LibraryTests.cpp
+    Created: 23 Oct 2026 11:48:02am
+    Author:  Linus
+
+  ==============================================================================
+*/
+
+#include <JuceHeader.h>
+#include <cmath>
+#include <vector>
+#include "../../Library/Source/libcompressor.h"
+#include "../../Source/Compressor.h"
+#include "GoldenRenders.h"
+#include "TestSignals.h"
+
+namespace
+{
+    compressor_handle* createHandle(int numChannels)
+    {
+        return compressor_create(TestSignals::sampleRate, numChannels, TestSignals::blockSize);
+    }
+
+    void setSettings(compressor_handle* handle, const GoldenRenders::Settings& settings)
+    {
+        compressor_set_parameter(handle, COMPRESSOR_INPUT_GAIN, settings.input);
+        compressor_set_parameter(handle, COMPRESSOR_THRESHOLD, settings.threshold);
+        compressor_set_parameter(handle, COMPRESSOR_RATIO, settings.ratio);
+        compressor_set_parameter(handle, COMPRESSOR_KNEE, settings.knee);
+        compressor_set_parameter(handle, COMPRESSOR_ATTACK, settings.attack);
+        compressor_set_parameter(handle, COMPRESSOR_RELEASE, settings.release);
+        compressor_set_parameter(handle, COMPRESSOR_MAKEUP, settings.makeup);
+        compressor_set_parameter(handle, COMPRESSOR_MIX, settings.mix);
+    }
+}
+
+class LibraryTests : public juce::UnitTest
+{
+public:
+    LibraryTests() : juce::UnitTest("libcompressor", "DSP") {}
+
+    void runTest() override
+    {
+        beginTest("Interleaved float matches Compressor::process, with the same side-chain");
+        {
+            // The bursts' channels are uncorrelated, the right is often the louder and negative
+            for (const int numChannels : { 2, 3 })
+            for (const bool midSide : { false, true })
+            {
+                if (midSide && numChannels != 2)
+                    continue;
+
+                const auto source = TestSignals::makeBursts(numChannels, TestSignals::renderLength);
+
+                Compressor compressor;
+                const auto& settings = GoldenRenders::limiterSettings;
+                TestSignals::configure(compressor, settings, TestSignals::makeSpec(numChannels));
+                compressor.setMidSide(midSide);
+
+                juce::AudioBuffer<float> expected(source);
+                TestSignals::render(compressor, expected);
+
+                auto* handle = createHandle(numChannels);
+                setSettings(handle, settings);
+                expectEquals(static_cast<int>(compressor_set_parameter(handle, COMPRESSOR_MID_SIDE, midSide ? 1.0f : 0.0f)),
+                             static_cast<int>(COMPRESSOR_OK));
+
+                std::vector<float> interleaved(static_cast<size_t>(numChannels * source.getNumSamples()));
+                for (int i = 0; i < source.getNumSamples(); ++i)
+                    for (int ch = 0; ch < numChannels; ++ch)
+                        interleaved[static_cast<size_t>(numChannels * i + ch)] = source.getSample(ch, i);
+
+                for (int start = 0; start < source.getNumSamples(); start += TestSignals::blockSize)
+                    compressor_process_interleaved_f32(handle, interleaved.data() + numChannels * start, TestSignals::blockSize);
+
+                // The fused pass multiplies input gain and gain once instead of one after the other
+                for (int i = 0; i < source.getNumSamples(); ++i)
+                    for (int ch = 0; ch < numChannels; ++ch)
+                    {
+                        const float reference = expected.getSample(ch, i);
+                        expectWithinAbsoluteError(interleaved[static_cast<size_t>(numChannels * i + ch)], reference,
+                                                  1.0e-5f * std::abs(reference) + 1.0e-7f);
+                    }
+
+                expectWithinAbsoluteError(compressor_get_gain_reduction(handle), compressor.getMaxGainReduction(), 1.0e-4f);
+                compressor_destroy(handle);
+            }
+        }
+
+        beginTest("int16 passes unity gain unchanged and saturates");
+        {
+            auto* handle = createHandle(1);
+            compressor_set_parameter(handle, COMPRESSOR_RATIO, 1.0f);
+
+            std::vector<int16_t> samples(static_cast<size_t>(TestSignals::blockSize));
+            for (size_t i = 0; i < samples.size(); ++i)
+                samples[i] = static_cast<int16_t>((static_cast<int>(i) * 517) % 65536 - 32768);
+            const auto original = samples;
+
+            compressor_process_interleaved_s16(handle, samples.data(), TestSignals::blockSize);
+            expect(samples == original);
+
+            // 20 dB of makeup takes everything above about -20 dBFS to full scale
+            compressor_set_parameter(handle, COMPRESSOR_MAKEUP, 20.0f);
+            compressor_process_interleaved_s16(handle, samples.data(), TestSignals::blockSize);
+            for (size_t i = 0; i < samples.size(); ++i)
+                if (std::abs(original[i]) > 4000)
+                    expectEquals(static_cast<int>(samples[i]), original[i] > 0 ? 32767 : -32768);
+
+            compressor_destroy(handle);
+        }
+
+        beginTest("Planar float processes the caller's channels in place");
+        {
+            const auto source = TestSignals::makeBursts(TestSignals::renderLength);
+            juce::AudioBuffer<float> interleavedResult(source), planarResult(source);
+
+            auto* interleavedHandle = createHandle(2);
+            auto* planarHandle = createHandle(2);
+            setSettings(interleavedHandle, GoldenRenders::compressorSettings);
+            setSettings(planarHandle, GoldenRenders::compressorSettings);
+
+            std::vector<float> frames(static_cast<size_t>(2 * TestSignals::blockSize));
+            for (int start = 0; start < source.getNumSamples(); start += TestSignals::blockSize)
+            {
+                float* channels[2] = { planarResult.getWritePointer(0, start), planarResult.getWritePointer(1, start) };
+                compressor_process_planar_f32(planarHandle, channels, TestSignals::blockSize);
+
+                for (int i = 0; i < TestSignals::blockSize; ++i)
+                    for (int ch = 0; ch < 2; ++ch)
+                        frames[static_cast<size_t>(2 * i + ch)] = interleavedResult.getSample(ch, start + i);
+                compressor_process_interleaved_f32(interleavedHandle, frames.data(), TestSignals::blockSize);
+                for (int i = 0; i < TestSignals::blockSize; ++i)
+                    for (int ch = 0; ch < 2; ++ch)
+                        interleavedResult.setSample(ch, start + i, frames[static_cast<size_t>(2 * i + ch)]);
+            }
+
+            for (int ch = 0; ch < 2; ++ch)
+                for (int i = 0; i < source.getNumSamples(); ++i)
+                    expectWithinAbsoluteError(planarResult.getSample(ch, i), interleavedResult.getSample(ch, i),
+                                              1.0e-5f * std::abs(planarResult.getSample(ch, i)) + 1.0e-7f);
+
+            compressor_destroy(interleavedHandle);
+            compressor_destroy(planarHandle);
+        }
+
+        beginTest("Invalid arguments are rejected");
+        {
+            expect(compressor_create(TestSignals::sampleRate, 0, TestSignals::blockSize) == nullptr);
+            expect(compressor_create(TestSignals::sampleRate, 9, TestSignals::blockSize) == nullptr);
+            expect(compressor_create(0.0, 2, TestSignals::blockSize) == nullptr);
+            expect(compressor_create(TestSignals::sampleRate, 2, 0) == nullptr);
+
+            auto* handle = createHandle(1);
+            float samples[2 * TestSignals::blockSize] = {};
+
+            expectEquals(static_cast<int>(compressor_process_interleaved_f32(handle, samples, 2 * TestSignals::blockSize)),
+                         static_cast<int>(COMPRESSOR_BLOCK_TOO_LARGE));
+            expectEquals(static_cast<int>(compressor_process_interleaved_f32(handle, nullptr, 1)),
+                         static_cast<int>(COMPRESSOR_INVALID_ARGUMENT));
+            expectEquals(static_cast<int>(compressor_set_parameter(handle, COMPRESSOR_MID_SIDE, 1.0f)),
+                         static_cast<int>(COMPRESSOR_INVALID_ARGUMENT));
+            expectEquals(static_cast<int>(compressor_set_parameter(handle, static_cast<compressor_parameter>(99), 1.0f)),
+                         static_cast<int>(COMPRESSOR_INVALID_ARGUMENT));
+            expectEquals(static_cast<int>(compressor_set_parameter(nullptr, COMPRESSOR_RATIO, 1.0f)),
+                         static_cast<int>(COMPRESSOR_INVALID_ARGUMENT));
+
+            const std::pair<compressor_parameter, float> outOfRange[] = {
+                { COMPRESSOR_ATTACK, -1.0f }, { COMPRESSOR_RELEASE, 0.0f }, { COMPRESSOR_RATIO, 0.0f },
+                { COMPRESSOR_RATIO, -2.0f }, { COMPRESSOR_KNEE, -1.0f }, { COMPRESSOR_MIX, 1.5f },
+                { COMPRESSOR_THRESHOLD, 10.0f }, { COMPRESSOR_CEILING, std::nanf("") }
+            };
+
+            for (const auto& [parameter, value] : outOfRange)
+                expectEquals(static_cast<int>(compressor_set_parameter(handle, parameter, value)),
+                             static_cast<int>(COMPRESSOR_INVALID_ARGUMENT));
+
+            expectEquals(static_cast<int>(compressor_set_parameter(handle, COMPRESSOR_ATTACK, 0.0f)),
+                         static_cast<int>(COMPRESSOR_OK));
+            expectEquals(compressor_get_api_version(), LIBCOMPRESSOR_API_VERSION);
+
+            compressor_destroy(handle);
+        }
+    }
+};
+
+static LibraryTests libraryTests;
@@ -0,0 +1,34 @@
+/*
+  ==============================================================================
+
+    Main.cpp
+    Created: 19 Oct 2026 2:41:09pm
+    Author:  Linus
+
+    Runs every registered juce::UnitTest and returns non-zero on failure.
+
+  ==============================================================================
+*/
+
+#include <JuceHeader.h>
+
+int main(int argc, char* argv[])
+{
+    // The plugin processor's parameters and async updates need a message manager
+    juce::ScopedJuceInitialiser_GUI juceInitialiser;
+
+    juce::UnitTestRunner runner;
+    runner.setAssertOnFailure(false);
+
+    // Optionally restrict the run to one category, e.g. "Performance"
+    if (argc > 1)
+        runner.runTestsInCategory(argv[1]);
+    else
+        runner.runAllTests();
+
+    int failures = 0;
+    for (int i = 0; i < runner.getNumResults(); ++i)
+        failures += runner.getResult(i)->failures;
+
+    return failures > 0 ? 1 : 0;
+}
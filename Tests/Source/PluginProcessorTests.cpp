@@ -0,0 +1,181 @@
+/*
+  ==============================================================================
+
+    PluginProcessorTests.cpp
+    Created: 19 Oct 2026 2:12:40pm
+    Author:  Linus
+
+  ==============================================================================
+*/
+
+#include <JuceHeader.h>
+#include <limits>
+#include <memory>
+#include <vector>
+#include "../../Source/PluginProcessor.h"
+#include "TestSignals.h"
+
+namespace
+{
+    void setParameter(CompressorAudioProcessor& processor, const juce::String& parameterID, float value)
+    {
+        auto* parameter = processor.getValueTreeState().getParameter(parameterID);
+        parameter->setValueNotifyingHost(parameter->convertTo0to1(value));
+    }
+
+    // One layout on both the input and the output bus
+    juce::AudioProcessor::BusesLayout makeLayout(const juce::AudioChannelSet& channels)
+    {
+        juce::AudioProcessor::BusesLayout layout;
+        layout.inputBuses.add(channels);
+        layout.outputBuses.add(channels);
+        return layout;
+    }
+}
+
+class PluginProcessorTests : public juce::UnitTest
+{
+public:
+    PluginProcessorTests() : juce::UnitTest("Plugin processor", "DSP") {}
+
+    void runTest() override
+    {
+        // The auto tuner's cache and the profile are the user's files; these tests leave them alone
+        { CompressorAudioProcessor first; }
+        AutoTuner::setCacheFile(juce::File());
+       #if COMPRESSOR_PROFILING
+        CompressorAudioProcessor::setProfileFile(juce::File());
+       #endif
+
+        beginTest("Parameter changes reach the compressor");
+        {
+            CompressorAudioProcessor dry, wet;
+            setParameter(dry, "mix", 0.0f);
+            setParameter(dry, "threshold", -40.0f);
+            setParameter(wet, "threshold", -40.0f);
+
+            const auto source = TestSignals::makeBursts(TestSignals::blockSize);
+            const auto dryBlock = render(dry, source);
+            const auto wetBlock = render(wet, source);
+
+            // At no mix the block comes back as it went in, fully wet it is compressed
+            for (int ch = 0; ch < 2; ++ch)
+                for (int i = 0; i < TestSignals::blockSize; ++i)
+                    expectWithinAbsoluteError(dryBlock.getSample(ch, i), source.getSample(ch, i), 1.0e-6f);
+            expectLessThan(wetBlock.getMagnitude(0, 0, TestSignals::blockSize), source.getMagnitude(0, 0, TestSignals::blockSize));
+        }
+
+        beginTest("A mono layout ignores Mid/Side");
+        {
+            CompressorAudioProcessor linked, midSide;
+            for (auto* processor : { &linked, &midSide })
+            {
+                expect(processor->setBusesLayout(makeLayout(juce::AudioChannelSet::mono())));
+                setParameter(*processor, "threshold", -40.0f);
+            }
+            setParameter(midSide, "midside", 1.0f);
+
+            const auto source = TestSignals::makeBursts(1, TestSignals::blockSize);
+            const auto expected = render(linked, source);
+            const auto block = render(midSide, source);
+
+            for (int i = 0; i < TestSignals::blockSize; ++i)
+                expectEquals(block.getSample(0, i), expected.getSample(0, i));
+        }
+
+        beginTest("A pinned tuning holds until the parameter goes back to auto");
+        {
+            CompressorAudioProcessor processor;
+            const auto source = TestSignals::makeBursts(TestSignals::blockSize);
+            render(processor, source);
+            const auto autoTuning = processor.getCompressorTuning();
+
+            const auto& pinned = CompressorAudioProcessor::getPinnedTunings();
+            for (size_t i = 0; i < pinned.size(); ++i)
+            {
+                setParameter(processor, "tuning", static_cast<float>(i + 1));
+                render(processor, source);
+                expect(processor.getCompressorTuning() == pinned[i]);
+
+                // Without a new prepare as well
+                setParameter(processor, "tuning", 0.0f);
+                juce::AudioBuffer<float> block(source);
+                juce::MidiBuffer midi;
+                processor.processBlock(block, midi);
+                expect(processor.getCompressorTuning() == autoTuning);
+            }
+        }
+    }
+
+private:
+    static juce::AudioBuffer<float> render(CompressorAudioProcessor& processor, const juce::AudioBuffer<float>& source)
+    {
+        processor.prepareToPlay(TestSignals::sampleRate, source.getNumSamples());
+
+        juce::AudioBuffer<float> block(source);
+        juce::MidiBuffer midi;
+        processor.processBlock(block, midi);
+        return block;
+    }
+};
+
+static PluginProcessorTests pluginProcessorTests;
+
+// Load cost of the plugin as a host sees it, run on its own with the "Performance" argument
+class PluginProcessorPerformanceTests : public juce::UnitTest
+{
+public:
+    PluginProcessorPerformanceTests() : juce::UnitTest("Plugin processor performance", "Performance") {}
+
+    void runTest() override
+    {
+        beginTest("Session load: create, prepare and run a first block through many plugin instances");
+        {
+            // The first instance builds what every later one shares, and sets the auto
+            // tuner's cache file, which the measurement then leaves alone
+            { CompressorAudioProcessor first; }
+            AutoTuner::setCacheFile(juce::File());
+           #if COMPRESSOR_PROFILING
+            CompressorAudioProcessor::setProfileFile(juce::File());
+           #endif
+
+            constexpr int numInstances = 200;
+            const auto source = TestSignals::makeBursts(TestSignals::blockSize);
+            juce::AudioBuffer<float> block(2, TestSignals::blockSize);
+            juce::MidiBuffer midi;
+
+            double bestSeconds = std::numeric_limits<double>::max();
+            for (int run = 0; run < 3; ++run)
+            {
+                std::vector<std::unique_ptr<CompressorAudioProcessor>> session;
+                session.reserve(numInstances);
+
+                const auto start = juce::Time::getHighResolutionTicks();
+                for (int i = 0; i < numInstances; ++i)
+                {
+                    auto& processor = *session.emplace_back(std::make_unique<CompressorAudioProcessor>());
+                    processor.prepareToPlay(TestSignals::sampleRate, TestSignals::blockSize);
+
+                    for (int ch = 0; ch < 2; ++ch)
+                        block.copyFrom(ch, 0, source, ch, 0, TestSignals::blockSize);
+                    processor.processBlock(block, midi);
+                }
+                bestSeconds = juce::jmin(bestSeconds, juce::Time::highResolutionTicksToSeconds(juce::Time::getHighResolutionTicks() - start));
+            }
+
+            const double microsecondsPerInstance = bestSeconds * 1.0e6 / numInstances;
+            logMessage("Plugin session load: " + juce::String(microsecondsPerInstance, 1) + " us per instance, "
+                       + juce::String(bestSeconds * 1.0e3, 1) + " ms for " + juce::String(numInstances));
+
+           #if ! JUCE_DEBUG
+            expectLessThan(microsecondsPerInstance, maximumMicrosecondsPerInstance);
+           #endif
+        }
+    }
+
+private:
+    // Budget for one instance in a large session: processor, parameters and DSP objects, no editor
+    static constexpr double maximumMicrosecondsPerInstance = 500.0;
+};
+
+static PluginProcessorPerformanceTests pluginProcessorPerformanceTests;
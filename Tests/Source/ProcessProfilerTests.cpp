@@ -0,0 +1,153 @@
+/*
+  ==============================================================================
+
+    ProcessProfilerTests.cpp
+    Created: 19 Oct 2026 4:37:18pm
+    Author:  Linus
+
+  ==============================================================================
+*/
+
+#include <JuceHeader.h>
+#include "../../Source/Compressor.h"
+#include "../../Source/DetectorCheckpoints.h"
+#include "../../Source/ProcessProfiler.h"
+#include "GoldenRenders.h"
+#include "TestSignals.h"
+
+#if COMPRESSOR_PROFILING
+
+class ProcessProfilerTests : public juce::UnitTest
+{
+public:
+    ProcessProfilerTests() : juce::UnitTest("ProcessProfiler", "DSP") {}
+
+    void runTest() override
+    {
+        beginTest("Tiles and chain stages count once per block");
+        {
+            for (const int numStages : { 1, 2 })
+            {
+                Compressor compressor;
+                TestSignals::configure(compressor, GoldenRenders::compressorSettings);
+                compressor.setTuning({ 64, Compressor::Kernel::multiPass });
+                compressor.setNumStages(numStages);
+
+                auto buffer = TestSignals::makeBursts(numBlocks * TestSignals::blockSize);
+                TestSignals::render(compressor, buffer);
+
+                const auto& profiler = compressor.getProfiler();
+                expectEquals(static_cast<int>(profiler.getStats(ProcessProfiler::block).numBlocks), numBlocks);
+                expectEquals(static_cast<int>(profiler.getStats(ProcessProfiler::sidechain).numBlocks), numBlocks);
+                expectEquals(static_cast<int>(profiler.getStats(ProcessProfiler::gainComputer).numBlocks), numBlocks);
+                expectEquals(static_cast<int>(profiler.getStats(ProcessProfiler::truePeak).numBlocks), 0);
+            }
+        }
+
+        beginTest("A block's stages add up to no more than the block");
+        {
+            Compressor compressor;
+            TestSignals::configure(compressor, GoldenRenders::compressorSettings);
+            compressor.setTuning({ 64, Compressor::Kernel::multiPass });
+            compressor.setTruePeak(true);
+
+            auto buffer = TestSignals::makeBursts(numBlocks * TestSignals::blockSize);
+            TestSignals::render(compressor, buffer);
+
+            const auto& profiler = compressor.getProfiler();
+            double stagesNanoseconds = 0.0;
+            for (int stage = 0; stage < ProcessProfiler::block; ++stage)
+            {
+                const auto stats = profiler.getStats(static_cast<ProcessProfiler::Stage>(stage));
+                stagesNanoseconds += stats.averageNanoseconds * static_cast<double>(stats.numBlocks);
+            }
+
+            const auto block = profiler.getStats(ProcessProfiler::block);
+            expectLessOrEqual(stagesNanoseconds, block.averageNanoseconds * static_cast<double>(block.numBlocks));
+        }
+
+        beginTest("Interleaved blocks count once, through the planar path as well");
+        {
+            for (const bool truePeak : { false, true })
+            {
+                Compressor compressor;
+                TestSignals::configure(compressor, GoldenRenders::compressorSettings);
+                compressor.setTruePeak(truePeak);
+
+                std::vector<float> interleaved(static_cast<size_t>(2 * TestSignals::blockSize), 0.25f);
+                for (int i = 0; i < numBlocks; ++i)
+                    compressor.processInterleaved(interleaved.data(), 2, TestSignals::blockSize);
+
+                expectEquals(static_cast<int>(compressor.getProfiler().getStats(ProcessProfiler::block).numBlocks), numBlocks);
+            }
+        }
+
+        beginTest("An offline render counts as one block with its passes as stages");
+        {
+            Compressor compressor;
+            TestSignals::configure(compressor, GoldenRenders::compressorSettings);
+
+            auto buffer = TestSignals::makeBursts(numBlocks * TestSignals::blockSize);
+            juce::ThreadPool pool(2);
+            expect(compressor.processOffline(buffer, pool));
+
+            const auto& profiler = compressor.getProfiler();
+            for (const auto stage : { ProcessProfiler::block, ProcessProfiler::gainComputer, ProcessProfiler::ballistics, ProcessProfiler::mix })
+                expectEquals(static_cast<int>(profiler.getStats(stage).numBlocks), 1);
+            expectEquals(static_cast<int>(profiler.getStats(ProcessProfiler::segments).numBlocks), 0);
+        }
+
+        beginTest("Parallel renders and their regions count pre-roll and segments once each");
+        {
+            Compressor compressor;
+            TestSignals::configure(compressor, GoldenRenders::compressorSettings);
+
+            const auto source = TestSignals::makeBursts(numBlocks * TestSignals::blockSize);
+            juce::AudioBuffer<float> buffer(source);
+            juce::ThreadPool pool(2);
+            DetectorCheckpoints checkpoints(TestSignals::blockSize);
+            expect(compressor.processParallel(buffer, pool, &checkpoints));
+
+            const auto& profiler = compressor.getProfiler();
+            for (const auto stage : { ProcessProfiler::block, ProcessProfiler::preRoll, ProcessProfiler::segments })
+                expectEquals(static_cast<int>(profiler.getStats(stage).numBlocks), 1);
+
+            buffer.makeCopyOf(source);
+            expect(compressor.processRegion(buffer, TestSignals::blockSize + 7, TestSignals::blockSize, checkpoints));
+            for (const auto stage : { ProcessProfiler::block, ProcessProfiler::preRoll, ProcessProfiler::segments })
+                expectEquals(static_cast<int>(profiler.getStats(stage).numBlocks), 2);
+        }
+
+        beginTest("Merged profiles add up and export one CSV line per stage");
+        {
+            Compressor first, second;
+            for (auto* compressor : { &first, &second })
+            {
+                TestSignals::configure(*compressor, GoldenRenders::compressorSettings);
+                auto buffer = TestSignals::makeBursts(numBlocks * TestSignals::blockSize);
+                TestSignals::render(*compressor, buffer);
+            }
+
+            ProcessProfiler total;
+            total.merge(first.getProfiler());
+            total.merge(second.getProfiler());
+            expectEquals(static_cast<int>(total.getStats(ProcessProfiler::block).numBlocks), 2 * numBlocks);
+            expectGreaterOrEqual(total.getStats(ProcessProfiler::block).worstNanoseconds,
+                                 first.getProfiler().getStats(ProcessProfiler::block).worstNanoseconds);
+
+            juce::TemporaryFile csv(".csv");
+            expect(total.writeCsv(csv.getFile()));
+            juce::StringArray lines;
+            lines.addLines(csv.getFile().loadFileAsString().trim());
+            expectEquals(lines.size(), 1 + static_cast<int>(ProcessProfiler::numStages));
+            expect(lines[lines.size() - 1].startsWith("block,"));
+        }
+    }
+
+private:
+    static constexpr int numBlocks = 6;
+};
+
+static ProcessProfilerTests processProfilerTests;
+
+#endif
@@ -0,0 +1,123 @@
+/*
+  ==============================================================================
+
+    QualityGovernorTests.cpp
+    Created: 23 Oct 2026 4:27:15pm
+    Author:  Linus
+
+  ==============================================================================
+*/
+
+#include <JuceHeader.h>
+#include "../../Source/QualityGovernor.h"
+#include "TestSignals.h"
+
+class QualityGovernorTests : public juce::UnitTest
+{
+public:
+    QualityGovernorTests() : juce::UnitTest("QualityGovernor", "DSP") {}
+
+    void runTest() override
+    {
+        using Quality = Compressor::Quality;
+
+        beginTest("A light load stays at full quality");
+        {
+            QualityGovernor governor;
+            governor.prepare(TestSignals::sampleRate);
+            expect(feed(governor, 0.1, 10.0) == Quality::full);
+            expectEquals(governor.getNumStepDowns(), 0);
+            expectWithinAbsoluteError(governor.getLoad(), 0.1f, 0.01f);
+        }
+
+        beginTest("An overload steps down one level per settle time");
+        {
+            QualityGovernor governor;
+            governor.prepare(TestSignals::sampleRate);
+            expect(feed(governor, 0.9, 0.2) == Quality::approximate);
+            expect(feed(governor, 0.9, 0.1) == Quality::approximate);
+            expect(feed(governor, 0.9, 0.2) == Quality::decimated);
+
+            // Nothing cheaper left
+            expect(feed(governor, 0.9, 2.0) == Quality::decimated);
+            expectEquals(governor.getNumStepDowns(), 2);
+        }
+
+        beginTest("A missed deadline steps down at once");
+        {
+            QualityGovernor governor;
+            governor.prepare(TestSignals::sampleRate);
+            feed(governor, 0.1, 1.0);
+            expect(governor.update(1.5 * blockDuration, TestSignals::blockSize) == Quality::approximate);
+        }
+
+        beginTest("Steps back up only after holding under half the limit");
+        {
+            QualityGovernor governor;
+            governor.prepare(TestSignals::sampleRate);
+            feed(governor, 0.9, 0.2);
+
+            // Between half the limit and the limit is the hysteresis band
+            expect(feed(governor, 0.5, 10.0) == Quality::approximate);
+
+            expect(feed(governor, 0.2, 0.5 * QualityGovernor::initialHoldTime) == Quality::approximate);
+            expect(feed(governor, 0.2, 0.6 * QualityGovernor::initialHoldTime) == Quality::full);
+        }
+
+        beginTest("A step down soon after a step up doubles the hold time");
+        {
+            QualityGovernor governor;
+            governor.prepare(TestSignals::sampleRate);
+            feed(governor, 0.9, 0.2);
+            expect(feed(governor, 0.2, 1.2 * QualityGovernor::initialHoldTime) == Quality::full);
+            expect(feed(governor, 0.9, 0.3) == Quality::approximate);
+
+            expect(feed(governor, 0.2, 1.2 * QualityGovernor::initialHoldTime) == Quality::approximate);
+            expect(feed(governor, 0.2, 1.0 * QualityGovernor::initialHoldTime) == Quality::full);
+        }
+
+        beginTest("The limit is configurable and disabling answers full quality");
+        {
+            QualityGovernor governor;
+            governor.prepare(TestSignals::sampleRate);
+            governor.setLoadLimit(0.3f);
+            expect(feed(governor, 0.4, 0.5) != Quality::full);
+
+            governor.setEnabled(false);
+            expect(feed(governor, 0.95, 1.0) == Quality::full);
+        }
+
+        beginTest("Stats count the blocks at every quality");
+        {
+            QualityGovernor governor;
+            governor.prepare(TestSignals::sampleRate);
+            feed(governor, 0.9, 0.2);
+
+            const auto total = governor.getNumBlocks(Quality::full) + governor.getNumBlocks(Quality::approximate)
+                             + governor.getNumBlocks(Quality::decimated);
+            expectEquals(static_cast<int>(total), blocksIn(0.2));
+            expect(governor.getNumBlocks(Quality::approximate) > 0);
+            expect(governor.toCsv().startsWith("quality,blocks,stepped_down_to\nfull,"));
+            expectWithinAbsoluteError(governor.getPeakLoad(), 0.9f, 1.0e-4f);
+        }
+    }
+
+private:
+    static constexpr double blockDuration = TestSignals::blockSize / TestSignals::sampleRate;
+
+    static int blocksIn(double seconds)
+    {
+        return static_cast<int>(std::ceil(seconds / blockDuration));
+    }
+
+    // Feeds blocks that each take load times their duration for the given seconds of audio
+    static Compressor::Quality feed(QualityGovernor& governor, double load, double seconds)
+    {
+        auto quality = governor.getQuality();
+        for (int block = 0; block < blocksIn(seconds); ++block)
+            quality = governor.update(load * blockDuration, TestSignals::blockSize);
+        return quality;
+    }
+};
+
+static QualityGovernorTests qualityGovernorTests;
@@ -0,0 +1,213 @@
+/*
+  ==============================================================================
+
+    RealtimeSafetyTests.cpp
+    Created: 21 Oct 2026 3:02:44pm
+    Author:  Linus
+
+  ==============================================================================
+*/
+
+#include <JuceHeader.h>
+#include <cstdlib>
+#include <mutex>
+#include <vector>
+#include "../../Library/Source/libcompressor.h"
+#include "../../Source/AsyncBlockProcessor.h"
+#include "../../Source/CompressorBank.h"
+#include "../../Source/RealtimeSafety.h"
+#include "../../Source/TransferCurve.h"
+#include "TestSignals.h"
+
+#if COMPRESSOR_REALTIME_CHECKS
+
+namespace
+{
+    // Locks during static initialisation, which may run before RealtimeSafety.cpp's own
+    struct LocksAtStartup
+    {
+        LocksAtStartup()
+        {
+            const std::lock_guard<std::mutex> lock(mutex);
+            locked = true;
+        }
+
+        std::mutex mutex;
+        bool locked{ false };
+    };
+
+    LocksAtStartup locksAtStartup;
+}
+
+class RealtimeSafetyTests : public juce::UnitTest
+{
+public:
+    RealtimeSafetyTests() : juce::UnitTest("RealtimeSafety", "DSP") {}
+
+    void runTest() override
+    {
+        RealtimeSafety::setFailureMode(RealtimeSafety::FailureMode::count);
+
+        beginTest("Allocations in an audio scope are reported");
+        {
+            RealtimeSafety::resetViolations();
+            {
+                const RealtimeSafety::ScopedAudioThread audioThread;
+                void* volatile block = std::malloc(64);
+                std::free(block);
+            }
+            expectEquals(RealtimeSafety::getNumViolations(), 2);
+        }
+
+        beginTest("Nothing outside an audio scope is reported");
+        {
+            RealtimeSafety::resetViolations();
+            void* volatile block = std::malloc(64);
+            std::free(block);
+
+            {
+                const RealtimeSafety::ScopedAudioThread audioThread;
+                const RealtimeSafety::ScopedSuspend suspend;
+                juce::AudioBuffer<float> buffer(2, 64);
+            }
+            expectEquals(RealtimeSafety::getNumViolations(), 0);
+        }
+
+        beginTest("A mutex locked by a static constructor goes through to the real lock");
+        expect(locksAtStartup.locked);
+
+       #if defined (__GLIBC__)
+        beginTest("Mutex locks in an audio scope are reported");
+        {
+            std::mutex mutex;
+            RealtimeSafety::resetViolations();
+            {
+                const RealtimeSafety::ScopedAudioThread audioThread;
+                const std::lock_guard<std::mutex> lock(mutex);
+            }
+            expectEquals(RealtimeSafety::getNumViolations(), 1);
+        }
+       #endif
+
+        beginTest("Compressor::process neither allocates nor locks");
+        {
+            juce::SharedResourcePointer<TransferCurveCache> curveCache;
+
+            // Everything a session can switch on, set up outside the callback
+            Compressor compressor;
+            compressor.prepare(TestSignals::makeSpec());
+            compressor.setTruePeak(true);
+            compressor.setMidSide(true);
+            compressor.setTransferCurve(curveCache->getCurve(-20.0f, 4.0f, 6.0f));
+
+            const auto source = TestSignals::makeBursts(TestSignals::renderLength);
+            juce::AudioBuffer<float> buffer(2, TestSignals::blockSize);
+
+            // A program change is picked up and crossfaded inside the first block
+            const CompressorPreset::Ptr preset = new CompressorPreset({ 0.0f, -30.0f, 8.0f, 0.0f, 1.0f, 50.0f, 6.0f, 1.0f },
+                                                                      TestSignals::sampleRate, curveCache->getCurve(-30.0f, 8.0f, 0.0f));
+            compressor.setPreset(preset, true);
+
+            // Recording the gain only copies into the envelope's own memory
+            GainEnvelope envelope(TestSignals::sampleRate, true, TestSignals::renderLength);
+            compressor.setGainEnvelope(&envelope);
+
+            RealtimeSafety::resetViolations();
+            {
+                const RealtimeSafety::ScopedAudioThread audioThread;
+
+                // Parameter changes from automation arrive between blocks on the audio thread
+                compressor.setThreshold(-20.0f);
+                compressor.setRatio(4.0f);
+                compressor.setKnee(6.0f);
+                compressor.setAttack(5.0f);
+                compressor.setCeiling(-1.0f);
+
+                // Joining a detector group only claims a slot of the shared bus
+                compressor.setLinkGroup(DetectorBus::numGroups);
+
+                for (int start = 0; start < source.getNumSamples(); start += TestSignals::blockSize)
+                {
+                    // Through every quality the plugin may step to under load
+                    compressor.setQuality(static_cast<Compressor::Quality>((start / TestSignals::blockSize) % Compressor::numQualities));
+
+                    for (int ch = 0; ch < 2; ++ch)
+                        buffer.copyFrom(ch, 0, source, ch, start, TestSignals::blockSize);
+                    compressor.process(buffer);
+                }
+            }
+            expectEquals(RealtimeSafety::getNumViolations(), 0);
+        }
+
+        beginTest("CompressorBank::process neither allocates nor locks");
+        {
+            CompressorBank bank;
+            bank.prepare({ TestSignals::sampleRate, static_cast<juce::uint32>(TestSignals::blockSize), 12 });
+            juce::AudioBuffer<float> buffer(12, TestSignals::blockSize);
+            buffer.clear();
+
+            RealtimeSafety::resetViolations();
+            {
+                const RealtimeSafety::ScopedAudioThread audioThread;
+                bank.setThreshold(5, -30.0f);
+                bank.process(buffer);
+            }
+            expectEquals(RealtimeSafety::getNumViolations(), 0);
+        }
+
+        beginTest("AsyncBlockProcessor hands blocks over without allocating or locking");
+        {
+            // The worker runs its blocks in an audio scope of its own
+            Compressor compressor;
+            compressor.prepare(TestSignals::makeSpec());
+            AsyncBlockProcessor async([&](juce::AudioBuffer<float>& block) { compressor.process(block); });
+            async.prepare(2, TestSignals::blockSize);
+            async.setEnabled(true);
+
+            const auto source = TestSignals::makeBursts(TestSignals::renderLength);
+            juce::AudioBuffer<float> buffer(source);
+
+            RealtimeSafety::resetViolations();
+            {
+                const RealtimeSafety::ScopedAudioThread audioThread;
+                TestSignals::render(async, buffer);
+            }
+
+            // Stops the worker, as the message thread does
+            async.setEnabled(false);
+            {
+                // Leaving the worker drops its block, then processes in place
+                const RealtimeSafety::ScopedAudioThread audioThread;
+                TestSignals::render(async, buffer);
+            }
+            expectEquals(RealtimeSafety::getNumViolations(), 0);
+        }
+
+        beginTest("libcompressor process calls neither allocate nor lock");
+        {
+            auto* handle = compressor_create(TestSignals::sampleRate, 2, TestSignals::blockSize);
+            std::vector<int16_t> pcm(static_cast<size_t>(2 * TestSignals::blockSize), 12000);
+            std::vector<float> frames(static_cast<size_t>(2 * TestSignals::blockSize), 0.5f);
+
+            RealtimeSafety::resetViolations();
+            {
+                const RealtimeSafety::ScopedAudioThread audioThread;
+                compressor_process_interleaved_s16(handle, pcm.data(), TestSignals::blockSize);
+
+                // Mid/side deinterleaves through the scratch arena
+                compressor_set_parameter(handle, COMPRESSOR_MID_SIDE, 1.0f);
+                compressor_process_interleaved_f32(handle, frames.data(), TestSignals::blockSize);
+            }
+            expectEquals(RealtimeSafety::getNumViolations(), 0);
+
+            compressor_destroy(handle);
+        }
+
+        RealtimeSafety::resetViolations();
+        RealtimeSafety::setFailureMode(RealtimeSafety::FailureMode::abortWithBacktrace);
+    }
+};
+
+static RealtimeSafetyTests realtimeSafetyTests;
+
+#endif
@@ -0,0 +1,362 @@
+/*
+  ==============================================================================
+
+    RealtimeStressTests.cpp
+    Created: 28 Oct 2026 9:12:40am
+    Author:  Linus
+
+  ==============================================================================
+*/
+
+#include <JuceHeader.h>
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <limits>
+#include <vector>
+#include "../../Source/Compressor.h"
+#include "../../Source/GlobalParameters.h"
+#include "../../Source/LevelEnvelopeFollower.h"
+#include "../../Source/QualityGovernor.h"
+#include "../../Source/TransferCurve.h"
+#include "TestSignals.h"
+
+namespace
+{
+    // Parameter changes as parameterChanged passes them on, plus the ratio jumping into
+    // and out of limiter mode, which GainComputer::setRatio treats separately
+    enum class Event
+    {
+        inputGain = 0,
+        threshold,
+        ratio,
+        limiterRatio,
+        knee,
+        attack,
+        release,
+        makeup,
+        mix,
+        midSide,
+        truePeak,
+        ceiling,
+        curveSections,
+        link
+    };
+
+    constexpr int numEvents = 14;
+
+    const char* getEventName(Event event)
+    {
+        static const char* const names[numEvents] = { "inputgain", "threshold", "ratio", "ratio to/from limiter", "knee", "attack",
+                                                      "release", "makeup", "mix", "midside", "truepeak", "ceiling",
+                                                      "curve sections", "link" };
+        return names[static_cast<int>(event)];
+    }
+
+    // What the host feeds in, a few hundred blocks at a time
+    enum class Input
+    {
+        bursts = 0,
+        silence,
+        denormals,
+        silenceAfterLoud,
+        fullScaleNoise,
+        impulses
+    };
+
+    constexpr int numInputs = 6;
+
+    const char* getInputName(Input input)
+    {
+        static const char* const names[numInputs] = { "bursts", "silence", "denormals", "silence after loud", "full scale noise", "impulses" };
+        return names[static_cast<int>(input)];
+    }
+
+    // Odd sizes as hosts send them around loop points and automation splits
+    constexpr int blockSizes[] = { 1, 3, 17, 64, 100, 127, 256, 441, 480, 512, 1000, 1024 };
+    constexpr int maxBlockSize = 1024;
+
+    // processChain of the plugin with its parameterChanged, without the parameter tree,
+    // editor and worker, which need the plugin client
+    struct PluginChain
+    {
+        Compressor compressor;
+        QualityGovernor qualityGovernor;
+        LevelEnvelopeFollower inLevelFollower, outLevelFollower;
+        juce::SharedResourcePointer<TransferCurveCache> curveCache;
+        float threshold{ -20.0f }, ratio{ 4.0f }, knee{ 6.0f };
+        bool midSide{ false }, truePeak{ false };
+
+        void prepare(const juce::dsp::ProcessSpec& spec)
+        {
+            compressor.prepare(spec);
+            qualityGovernor.prepare(spec.sampleRate);
+            inLevelFollower.prepare(spec.sampleRate);
+            outLevelFollower.prepare(spec.sampleRate);
+            compressor.setThreshold(threshold);
+            compressor.setRatio(ratio);
+            compressor.setKnee(knee);
+            updateCurve();
+        }
+
+        // The audio thread's part of a parameter change
+        void apply(Event event, juce::Random& random)
+        {
+            using namespace GlobalParameters::Parameter;
+            const auto between = [&random](float start, float end) { return start + (end - start) * random.nextFloat(); };
+
+            switch (event)
+            {
+                case Event::inputGain:      compressor.setInput(between(inputStart, inputEnd)); break;
+                case Event::threshold:      compressor.setThreshold(threshold = between(thresholdStart, thresholdEnd)); break;
+                case Event::ratio:          compressor.setRatio(ratio = between(ratioStart, 23.0f)); break;
+                case Event::limiterRatio:   compressor.setRatio(ratio = ratio > 23.9f ? between(ratioStart, 4.0f) : ratioEnd); break;
+                case Event::knee:           compressor.setKnee(knee = between(kneeStart, kneeEnd)); break;
+                case Event::attack:         compressor.setAttack(between(attackStart, attackEnd)); break;
+                case Event::release:        compressor.setRelease(between(releaseStart, releaseEnd)); break;
+                case Event::makeup:         compressor.setMakeup(between(makeupStart, makeupEnd)); break;
+                case Event::mix:            compressor.setMix(between(mixStart, mixEnd)); break;
+                case Event::midSide:        compressor.setMidSide(midSide = ! midSide); break;
+                case Event::truePeak:       compressor.setTruePeak(truePeak = ! truePeak); break;
+                case Event::ceiling:        compressor.setCeiling(between(ceilingStart, ceilingEnd)); break;
+                case Event::curveSections:
+                    compressor.setGate(random.nextBool() ? gateStart : between(-80.0f, -40.0f), gateRange);
+                    compressor.setExpander(between(-60.0f, -30.0f), between(expanderRatioStart, expanderRatioEnd));
+                    compressor.setUpward(between(-50.0f, -20.0f), between(upwardRatioStart, upwardRatioEnd), upwardMaxBoost);
+                    compressor.setLimiter(random.nextBool() ? std::numeric_limits<float>::infinity() : between(limitStart, 0.0f));
+                    break;
+                case Event::link:           compressor.setLinkGroup(random.nextInt(DetectorBus::numGroups + 1)); break;
+            }
+        }
+
+        // The message thread's part: the curve handleAsyncUpdate hands over
+        void updateCurve()
+        {
+            compressor.setTransferCurve(curveCache->getCurve(threshold, ratio, knee));
+        }
+
+        void process(juce::AudioBuffer<float>& buffer, double seconds)
+        {
+            juce::ScopedNoDenormals noDenormals;
+            const int numSamples = buffer.getNumSamples();
+
+            compressor.process(buffer);
+            inLevelFollower.updatePeak(compressor.getInputPeak(), numSamples);
+            outLevelFollower.updatePeak(compressor.getOutputPeak(), numSamples);
+
+            // The plugin times the block it is in, here the one before is all there is
+            compressor.setQuality(qualityGovernor.update(seconds, numSamples));
+        }
+    };
+
+    void fill(juce::AudioBuffer<float>& buffer, Input input, int position, juce::Random& random)
+    {
+        for (int ch = 0; ch < buffer.getNumChannels(); ++ch)
+        {
+            float* samples = buffer.getWritePointer(ch);
+            for (int i = 0; i < buffer.getNumSamples(); ++i)
+            {
+                const int n = position + i;
+                switch (input)
+                {
+                    case Input::bursts:
+                        samples[i] = ((n / 1024) % 2 == 0 ? 0.05f : 0.8f)
+                                   * static_cast<float>(std::sin(juce::MathConstants<double>::twoPi * 440.0 * n / TestSignals::sampleRate));
+                        break;
+                    case Input::silence:            samples[i] = 0.0f; break;
+                    case Input::denormals:          samples[i] = (n % 2 == 0 ? 1.0f : -1.0f) * 1.0e-40f * static_cast<float>(1 + n % 7); break;
+                    case Input::silenceAfterLoud:   samples[i] = n < 2048 ? (n % 2 == 0 ? 0.99f : -0.99f) : 0.0f; break;
+                    case Input::fullScaleNoise:     samples[i] = 2.0f * random.nextFloat() - 1.0f; break;
+                    case Input::impulses:           samples[i] = n % 4801 == 0 ? 1.0f : 0.0f; break;
+                }
+            }
+        }
+    }
+
+    double percentile(std::vector<double> values, double fraction)
+    {
+        if (values.empty())
+            return 0.0;
+
+        std::sort(values.begin(), values.end());
+        const auto index = static_cast<size_t>(std::ceil(fraction * static_cast<double>(values.size()))) - 1;
+        return values[std::min(index, values.size() - 1)];
+    }
+}
+
+// Throughput averages hide the blocks that drop out. This drives the plugin's audio
+// thread with aggressive random automation, silence, denormals and odd block sizes, and
+// reports the per-block time at p50/p99/p99.9/max with the parameter events and inputs
+// behind the worst blocks. Run on its own with the "Stress" argument.
+class RealtimeStressTests : public juce::UnitTest
+{
+public:
+    RealtimeStressTests() : juce::UnitTest("Real-time stress", "Stress") {}
+
+    void runTest() override
+    {
+        beginTest("Per-block times under random automation, silence, denormals and odd block sizes");
+
+        const juce::dsp::ProcessSpec spec{ TestSignals::sampleRate, static_cast<juce::uint32>(maxBlockSize), 2 };
+        PluginChain chain;
+        chain.prepare(spec);
+
+        juce::Random random(0x53545245);
+        juce::AudioBuffer<float> storage(2, maxBlockSize);
+
+        struct Block
+        {
+            int numSamples;
+            Input input;
+            std::array<bool, numEvents> events;
+            int numChanges;
+            double seconds;
+
+            // Share of the block's own duration, comparable across block sizes
+            double getLoad() const { return seconds * TestSignals::sampleRate / numSamples; }
+        };
+
+        std::vector<Block> blocks;
+        blocks.reserve(numBlocks);
+
+        auto input = Input::bursts;
+        int position = 0, numNonFinite = 0;
+        double lastSeconds = 0.0;
+
+        for (int b = 0; b < numBlocks; ++b)
+        {
+            if (b % blocksPerInput == 0)
+            {
+                input = static_cast<Input>(random.nextInt(numInputs));
+                position = 0;
+            }
+
+            Block block{ blockSizes[random.nextInt(static_cast<int>(std::size(blockSizes)))], input, {}, 0, 0.0 };
+            juce::AudioBuffer<float> buffer(storage.getArrayOfWritePointers(), 2, 0, block.numSamples);
+            fill(buffer, input, position, random);
+            position += block.numSamples;
+
+            // A third of the blocks come with one to three automation events, applied on the
+            // audio thread right before the block as host automation is
+            std::array<Event, 3> events{};
+            if (random.nextFloat() < eventProbability)
+            {
+                block.numChanges = 1 + random.nextInt(3);
+                for (int e = 0; e < block.numChanges; ++e)
+                {
+                    events[static_cast<size_t>(e)] = static_cast<Event>(random.nextInt(numEvents));
+                    block.events[static_cast<size_t>(events[static_cast<size_t>(e)])] = true;
+                }
+            }
+
+            const auto start = juce::Time::getHighResolutionTicks();
+            for (int e = 0; e < block.numChanges; ++e)
+                chain.apply(events[static_cast<size_t>(e)], random);
+            chain.process(buffer, lastSeconds);
+            block.seconds = juce::Time::highResolutionTicksToSeconds(juce::Time::getHighResolutionTicks() - start);
+            lastSeconds = block.seconds;
+
+            if (block.events[static_cast<size_t>(Event::threshold)] || block.events[static_cast<size_t>(Event::ratio)]
+                || block.events[static_cast<size_t>(Event::limiterRatio)] || block.events[static_cast<size_t>(Event::knee)])
+                chain.updateCurve();
+
+            for (int ch = 0; ch < 2; ++ch)
+                for (int i = 0; i < block.numSamples; ++i)
+                    numNonFinite += std::isfinite(buffer.getSample(ch, i)) ? 0 : 1;
+
+            blocks.push_back(block);
+        }
+
+        expectEquals(numNonFinite, 0, "non-finite output samples");
+
+        std::vector<double> microseconds, loads;
+        for (const auto& block : blocks)
+        {
+            microseconds.push_back(block.seconds * 1.0e6);
+            loads.push_back(block.getLoad());
+        }
+
+        logMessage(juce::String(numBlocks) + " blocks of 1 to " + juce::String(maxBlockSize) + " samples");
+        logMessage("  per block: p50 " + juce::String(percentile(microseconds, 0.5), 2) + " us, p99 " + juce::String(percentile(microseconds, 0.99), 2)
+                   + " us, p99.9 " + juce::String(percentile(microseconds, 0.999), 2) + " us, max " + juce::String(percentile(microseconds, 1.0), 2) + " us");
+        logMessage("  share of the block's duration: p50 " + formatLoad(percentile(loads, 0.5)) + ", p99 " + formatLoad(percentile(loads, 0.99))
+                   + ", p99.9 " + formatLoad(percentile(loads, 0.999)) + ", max " + formatLoad(percentile(loads, 1.0)));
+
+        // Blocks an event or input came with against the blocks without any event, by load
+        std::vector<double> quietLoads;
+        for (const auto& block : blocks)
+            if (block.numChanges == 0)
+                quietLoads.push_back(block.getLoad());
+        const double quietP99 = percentile(quietLoads, 0.99);
+
+        struct Offender
+        {
+            juce::String name;
+            double p99, max;
+        };
+
+        std::vector<Offender> offenders;
+        for (int e = 0; e < numEvents; ++e)
+        {
+            std::vector<double> withEvent;
+            for (const auto& block : blocks)
+                if (block.events[static_cast<size_t>(e)])
+                    withEvent.push_back(block.getLoad());
+            offenders.push_back({ getEventName(static_cast<Event>(e)), percentile(withEvent, 0.99), percentile(withEvent, 1.0) });
+        }
+
+        for (int in = 0; in < numInputs; ++in)
+        {
+            std::vector<double> withInput;
+            for (const auto& block : blocks)
+                if (block.input == static_cast<Input>(in) && block.numChanges == 0)
+                    withInput.push_back(block.getLoad());
+            offenders.push_back({ juce::String("input: ") + getInputName(static_cast<Input>(in)), percentile(withInput, 0.99), percentile(withInput, 1.0) });
+        }
+
+        std::sort(offenders.begin(), offenders.end(), [](const Offender& a, const Offender& b) { return a.p99 > b.p99; });
+        logMessage("  worst offenders by p99 load, against p99 " + formatLoad(quietP99) + " without events:");
+        for (size_t i = 0; i < std::min(offenders.size(), static_cast<size_t>(numReported)); ++i)
+            logMessage("    " + offenders[i].name + ": p99 " + formatLoad(offenders[i].p99) + " ("
+                       + juce::String(offenders[i].p99 / juce::jmax(quietP99, 1.0e-9), 1) + "x), max " + formatLoad(offenders[i].max));
+
+        // The slowest single blocks with everything that came with them
+        std::vector<const Block*> slowest;
+        for (const auto& block : blocks)
+            slowest.push_back(&block);
+        std::partial_sort(slowest.begin(), slowest.begin() + std::min(static_cast<int>(slowest.size()), numReported), slowest.end(),
+                          [](const Block* a, const Block* b) { return a->getLoad() > b->getLoad(); });
+
+        logMessage("  slowest blocks:");
+        for (int i = 0; i < std::min(static_cast<int>(slowest.size()), numReported); ++i)
+        {
+            const auto& block = *slowest[static_cast<size_t>(i)];
+            juce::String events;
+            for (int e = 0; e < numEvents; ++e)
+                if (block.events[static_cast<size_t>(e)])
+                    events << (events.isEmpty() ? "" : ", ") << getEventName(static_cast<Event>(e));
+
+            logMessage("    " + juce::String(block.seconds * 1.0e6, 2) + " us for " + juce::String(block.numSamples) + " samples ("
+                       + formatLoad(block.getLoad()) + "), " + getInputName(block.input) + (events.isEmpty() ? juce::String() : ", " + events));
+        }
+
+        // A block may take all of its duration at worst; a share of it leaves the rest to the host
+       #if ! JUCE_DEBUG
+        expectLessThan(percentile(loads, 0.999), maximumLoad);
+       #endif
+    }
+
+private:
+    static juce::String formatLoad(double load)
+    {
+        return juce::String(100.0 * load, 2) + "%";
+    }
+
+    static constexpr int numBlocks = 20000;
+    static constexpr int blocksPerInput = 200;
+    static constexpr float eventProbability = 0.33f;
+    static constexpr int numReported = 8;
+    static constexpr double maximumLoad = 0.25;
+};
+
+static RealtimeStressTests realtimeStressTests;
@@ -0,0 +1,163 @@
+/*
+  ==============================================================================
+
+    ScratchArenaTests.cpp
+    Created: 20 Oct 2026 11:47:02am
+    Author:  Linus
+
+  ==============================================================================
+*/
+
+#include <JuceHeader.h>
+#include <algorithm>
+#include <cstdint>
+#include <thread>
+#include "../../Source/ScratchArena.h"
+
+class ScratchArenaTests : public juce::UnitTest
+{
+public:
+    ScratchArenaTests() : juce::UnitTest("ScratchArena", "DSP") {}
+
+    void runTest() override
+    {
+        ScratchArena arena;
+        arena.reserve(3 * ScratchArena::getAlignedSize(100));
+
+        beginTest("Allocations are aligned and do not overlap");
+        {
+            ScratchArena::Scope scope(arena);
+            float* a = scope.allocate(100);
+            float* b = scope.allocate(100);
+            expect(isAligned(a) && isAligned(b));
+            expect(b >= a + 100);
+        }
+
+        beginTest("Past the reserved size a scope gets nothing and keeps what it has");
+        {
+            ScratchArena::Scope scope(arena);
+            float* first = scope.allocate(200);
+            expect(scope.allocate(2 * ScratchArena::getAlignedSize(100)) == nullptr);
+            expect(scope.allocate(100) == first + ScratchArena::getAlignedSize(200));
+        }
+
+        beginTest("Nested scopes share the slab and give memory back");
+        {
+            ScratchArena::Scope outer(arena);
+            float* first = outer.allocate(100);
+            float* nestedMemory = nullptr;
+            {
+                ScratchArena::Scope inner(arena);
+                nestedMemory = inner.allocate(100);
+                expect(nestedMemory > first);
+            }
+            expect(outer.allocate(100) == nestedMemory);
+        }
+
+        beginTest("Consecutive blocks on one thread reuse the same memory");
+        {
+            float* first = nullptr;
+            {
+                ScratchArena::Scope scope(arena);
+                first = scope.allocate(100);
+            }
+            ScratchArena::Scope scope(arena);
+            expect(scope.allocate(100) == first);
+        }
+
+        beginTest("Nested scopes on two arenas keep to their own slabs");
+        {
+            ScratchArena other;
+            other.reserve(2 * ScratchArena::getAlignedSize(100));
+
+            ScratchArena::Scope outer(arena);
+            float* first = outer.allocate(100);
+            float* otherMemory = nullptr;
+            {
+                ScratchArena::Scope inner(other);
+                otherMemory = inner.allocate(100);
+                {
+                    ScratchArena::Scope innermost(arena);
+                    expect(innermost.allocate(100) == first + ScratchArena::getAlignedSize(100));
+                }
+                expect(inner.allocate(100) == otherMemory + ScratchArena::getAlignedSize(100));
+            }
+            expect(otherMemory < first || otherMemory >= first + 3 * ScratchArena::getAlignedSize(100));
+            expect(outer.allocate(100) == first + ScratchArena::getAlignedSize(100));
+        }
+
+        beginTest("With every slot taken a scope gets no memory instead of waiting or allocating");
+        {
+            ScratchArena single(1);
+            single.reserve(ScratchArena::getAlignedSize(100));
+
+            juce::WaitableEvent held, release;
+            float* heldMemory = nullptr;
+            std::thread holder([&]
+            {
+                ScratchArena::Scope scope(single);
+                heldMemory = scope.allocate(100);
+                held.signal();
+                release.wait();
+            });
+
+            held.wait();
+            {
+                ScratchArena::Scope scope(single);
+                expect(scope.allocate(100) == nullptr);
+                {
+                    ScratchArena::Scope nested(single);
+                    expect(nested.allocate(1) == nullptr);
+                }
+            }
+            release.signal();
+            holder.join();
+
+            ScratchArena::Scope scope(single);
+            expect(scope.allocate(100) == heldMemory);
+        }
+
+        beginTest("Growing replaces the slabs and frees the old ones once their blocks end");
+        {
+            ScratchArena growing(2);
+            growing.reserve(ScratchArena::getAlignedSize(100));
+            growing.reserve(2 * ScratchArena::getAlignedSize(100));
+            expectEquals(growing.getNumRetiredSlabs(), 0);
+
+            juce::WaitableEvent held, grown;
+            float* heldMemory = nullptr;
+            std::thread holder([&]
+            {
+                ScratchArena::Scope scope(growing);
+                heldMemory = scope.allocate(100);
+                held.signal();
+                grown.wait();
+
+                // The slab it borrowed is still there to the end of the block
+                std::fill(heldMemory, heldMemory + 100, 1.0f);
+            });
+
+            held.wait();
+            growing.reserve(4 * ScratchArena::getAlignedSize(100));
+            expectEquals(growing.getNumRetiredSlabs(), 1);
+            {
+                ScratchArena::Scope scope(growing);
+                float* memory = scope.allocate(4 * ScratchArena::getAlignedSize(100) - 1);
+                expect(memory != nullptr && memory != heldMemory);
+            }
+            grown.signal();
+            holder.join();
+
+            growing.reserve(ScratchArena::getAlignedSize(100));
+            expectEquals(growing.getNumRetiredSlabs(), 0);
+        }
+    }
+
+private:
+    static bool isAligned(const float* p)
+    {
+        return reinterpret_cast<std::uintptr_t>(p) % ScratchArena::alignment == 0;
+    }
+};
+
+static ScratchArenaTests scratchArenaTests;
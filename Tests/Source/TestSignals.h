@@ -0,0 +1,89 @@
+/*
+  ==============================================================================
+
+    TestSignals.h
+    Created: 19 Oct 2026 2:43:51pm
+    Author:  Linus
+
+    Deterministic signals and helpers shared by the test suites.
+
+  ==============================================================================
+*/
+
+#pragma once
+#include <JuceHeader.h>
+#include <cmath>
+#include "../../Source/Compressor.h"
+#include "GoldenRenders.h"
+
+namespace TestSignals
+{
+    constexpr double sampleRate = 48000.0;
+    constexpr int blockSize = 512;
+    constexpr int renderLength = 8 * blockSize;
+
+    // Stereo tone bursts that alternate between quiet and loud every 1024 samples,
+    // so both the attack and the release of the detector are exercised
+    inline juce::AudioBuffer<float> makeBursts(int numSamples)
+    {
+        juce::AudioBuffer<float> buffer(2, numSamples);
+        for (int i = 0; i < numSamples; ++i)
+        {
+            const double envelope = (i / 1024) % 2 == 0 ? 0.05 : 0.8;
+            const double t = static_cast<double>(i) / sampleRate;
+            buffer.setSample(0, i, static_cast<float>(envelope * std::sin(juce::MathConstants<double>::twoPi * 440.0 * t)));
+            buffer.setSample(1, i, static_cast<float>(0.5 * envelope * std::sin(juce::MathConstants<double>::twoPi * 660.0 * t)));
+        }
+        return buffer;
+    }
+
+    // The bursts on any number of channels, the odd ones from the right of the stereo pair
+    inline juce::AudioBuffer<float> makeBursts(int numChannels, int numSamples)
+    {
+        const auto stereo = makeBursts(numSamples);
+        juce::AudioBuffer<float> buffer(numChannels, numSamples);
+        for (int ch = 0; ch < numChannels; ++ch)
+            buffer.copyFrom(ch, 0, stereo, ch % 2, 0, numSamples);
+        return buffer;
+    }
+
+    // Sets every sample of every channel to the value
+    inline void fill(juce::AudioBuffer<float>& buffer, float value)
+    {
+        for (int ch = 0; ch < buffer.getNumChannels(); ++ch)
+            juce::FloatVectorOperations::fill(buffer.getWritePointer(ch), value, buffer.getNumSamples());
+    }
+
+    inline juce::dsp::ProcessSpec makeSpec(int numChannels = 2)
+    {
+        return { sampleRate, static_cast<juce::uint32>(blockSize), static_cast<juce::uint32>(numChannels) };
+    }
+
+    // Prepares the compressor for the spec and applies the settings, the rest stays at its defaults
+    inline void configure(Compressor& compressor, const GoldenRenders::Settings& settings,
+                          const juce::dsp::ProcessSpec& spec = makeSpec())
+    {
+        compressor.prepare(spec);
+        compressor.setInput(settings.input);
+        compressor.setThreshold(settings.threshold);
+        compressor.setRatio(settings.ratio);
+        compressor.setKnee(settings.knee);
+        compressor.setAttack(settings.attack);
+        compressor.setRelease(settings.release);
+        compressor.setMakeup(settings.makeup);
+        compressor.setMix(settings.mix);
+    }
+
+    // Runs the buffer through the compressor, or anything else with process, in blocks
+    // of numBlockSamples, a short one last
+    template <typename Processor>
+    void render(Processor& processor, juce::AudioBuffer<float>& buffer, int numBlockSamples = blockSize)
+    {
+        for (int start = 0; start < buffer.getNumSamples(); start += numBlockSamples)
+        {
+            const int numSamples = juce::jmin(numBlockSamples, buffer.getNumSamples() - start);
+            juce::AudioBuffer<float> block(buffer.getArrayOfWritePointers(), buffer.getNumChannels(), start, numSamples);
+            processor.process(block);
+        }
+    }
+}